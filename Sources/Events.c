@@ -40,6 +40,369 @@ extern "C" {
 
   /* User includes (#include below this line is not maintained by Processor Expert) */
 
+#ifdef FCS_TASK_SCHDLR_TICKLESS_ENABLE
+  /* In tickless mode FTM0 counts the 10.48576 MHz bus clock divided by 128, which is
+     81.92 counts per 1 ms scheduler tick. The counter runs freely over 16 bits and is
+     never stopped or reset. Channel 0, a software output compare, interrupts at the
+     next deadline, and ticks are credited from the counts between two reads of the
+     counter, so no count is lost however often the span is reprogrammed. Counts are
+     accounted in 1/100 count units so the fraction carries over between reads and the
+     tick rate does not drift. TU1 lists channel 0 with its OnChannel0 event, so its
+     interrupt clears the channel flag and calls TU1_OnChannel0. */
+#define TU1_TICKLESS_TICK_UNITS     8192U   /* 1/100 count units per tick */
+#define TU1_TICKLESS_CNT_UNITS      100U    /* 1/100 count units per count */
+#define TU1_TICKLESS_CNT_MASK       0xFFFFU /* Counter range */
+#define TU1_TICKLESS_MAX_TICKS      799U    /* Longest span within one counter wrap */
+#define TU1_TICKLESS_CHANNEL        FTM_PDD_CHANNEL_0
+#define TU1_TICKLESS_COMPARE        0x10U   /* Channel mode MSB:MSA = 0:1, output compare */
+#define TU1_TICKLESS_LEAD_COUNTS    2U      /* CnV takes effect with the next count */
+
+  static uint32_t TU1_TicklessCarry = 0U;   /* Units counted past the last credited tick */
+  static uint32_t TU1_TicklessCnt = 0U;     /* Counter value at the last credit */
+  static uint32_t TU1_TicklessSpan = 1U;    /* Ticks the compare is armed for */
+
+  /*
+   ** ===================================================================
+   **     Method      :  TU1_CreditCounts (module Events)
+   */
+  /*!
+   **     @brief
+   **         Reads the counter and credits the scheduler with the whole
+   **         ticks counted since the last read. The remainder is kept for
+   **         the next read. Reads must be less than a counter wrap apart,
+   **         which the compare and the overflow interrupt ensure.
+   **     @return
+   **                         - Number of ticks credited.
+   */
+  /* ===================================================================*/
+  static uint32_t TU1_CreditCounts(void)
+  {
+    uint32_t Cnt = FTM_PDD_ReadCounterReg(FTM0_BASE_PTR);
+    uint32_t Units = TU1_TicklessCarry
+        + (((Cnt - TU1_TicklessCnt) & TU1_TICKLESS_CNT_MASK) * TU1_TICKLESS_CNT_UNITS);
+    uint32_t Ticks = Units / TU1_TICKLESS_TICK_UNITS;
+
+    TU1_TicklessCnt = Cnt;
+    TU1_TicklessCarry = Units % TU1_TICKLESS_TICK_UNITS;
+    if (Ticks > 0U) {
+      FCS_TASK_SCHDLR_clockTicks(Ticks);
+    }
+    return Ticks;
+  }
+
+  /*
+   ** ===================================================================
+   **     Method      :  TU1_ArmCompare (module Events)
+   */
+  /*!
+   **     @brief
+   **         Sets the compare to the end of TU1_TicklessSpan ticks from
+   **         the last credited tick, rounded up to a whole count. A
+   **         deadline closer than the compare can take effect is moved to
+   **         the first count it can match. Call with interrupts masked.
+   */
+  /* ===================================================================*/
+  static void TU1_ArmCompare(void)
+  {
+    uint32_t Counts = ((TU1_TicklessSpan * TU1_TICKLESS_TICK_UNITS) - TU1_TicklessCarry
+        + TU1_TICKLESS_CNT_UNITS - 1U) / TU1_TICKLESS_CNT_UNITS;
+    uint32_t Lead = ((FTM_PDD_ReadCounterReg(FTM0_BASE_PTR) - TU1_TicklessCnt)
+        & TU1_TICKLESS_CNT_MASK) + TU1_TICKLESS_LEAD_COUNTS;
+
+    if (Counts < Lead) {
+      Counts = Lead;
+    }
+    FTM_PDD_WriteChannelValueReg(FTM0_BASE_PTR, TU1_TICKLESS_CHANNEL,
+        (TU1_TicklessCnt + Counts) & TU1_TICKLESS_CNT_MASK);
+    /* A match of the previous value has been credited already. */
+    FTM_PDD_ClearChannelInterruptFlag(FTM0_BASE_PTR, TU1_TICKLESS_CHANNEL);
+  }
+
+  /*
+   ** ===================================================================
+   **     Method      :  TU1_SetTickSpan (module Events)
+   */
+  /*!
+   **     @brief
+   **         Tickless callback of the task scheduler. Credits the ticks
+   **         counted so far and arms the compare for the requested tick.
+   **         The counter keeps running throughout.
+   **     @param
+   **         Ticks           - Ticks until the next deadline, counted from
+   **                           the last tick credited to the scheduler.
+   */
+  /* ===================================================================*/
+  void TU1_SetTickSpan(uint32_t Ticks)
+  {
+    uint32_t Credited;
+
+    EnterCritical();
+    Credited = TU1_CreditCounts();
+
+    /* Span left from the new reference tick, at least one tick. */
+    Ticks = (Ticks > Credited) ? (Ticks - Credited) : 1U;
+    if (Ticks > TU1_TICKLESS_MAX_TICKS) {
+      Ticks = TU1_TICKLESS_MAX_TICKS;
+    }
+    TU1_TicklessSpan = Ticks;
+    TU1_ArmCompare();
+    ExitCritical();
+  }
+
+  /*
+   ** ===================================================================
+   **     Method      :  TU1_TicklessInit (module Events)
+   */
+  /*!
+   **     @brief
+   **         Switches FTM0 from the fixed 1 ms period set up by TU1 to the
+   **         free-running tickless time base and registers TU1_SetTickSpan
+   **         with the task scheduler. Call after Scheduler_Init.
+   */
+  /* ===================================================================*/
+  void TU1_TicklessInit(void)
+  {
+    EnterCritical();
+    /* The counter is stopped this once, so MOD is written at once. */
+    FTM_PDD_SelectPrescalerSource(FTM0_BASE_PTR, FTM_PDD_DISABLED);
+    FTM_PDD_SetPrescaler(FTM0_BASE_PTR, FTM_PDD_DIVIDE_128);
+    FTM_PDD_WriteModuloReg(FTM0_BASE_PTR, TU1_TICKLESS_CNT_MASK);
+    FTM_PDD_InitializeCounter(FTM0_BASE_PTR);
+    FTM_PDD_ClearOverflowInterruptFlag(FTM0_BASE_PTR);
+    FTM_PDD_SelectChannelMode(FTM0_BASE_PTR, TU1_TICKLESS_CHANNEL, TU1_TICKLESS_COMPARE);
+    FTM_PDD_EnableChannelInterrupt(FTM0_BASE_PTR, TU1_TICKLESS_CHANNEL);
+    TU1_TicklessCarry = 0U;
+    TU1_TicklessCnt = 0U;
+    FTM_PDD_SelectPrescalerSource(FTM0_BASE_PTR, FTM_PDD_SYSTEM);
+    ExitCritical();
+
+    /* Tick once per millisecond until the dispatcher requests a longer span. */
+    TU1_SetTickSpan(1U);
+    FCS_TASK_SCHDLR_registerTicklessCb(TU1_SetTickSpan);
+  }
+#endif
+
+#ifdef FCS_TASK_SCHDLR_WATCHDOG_ENABLE
+  /* The WDOG counts the 1 kHz LPO clock, so its values are in milliseconds. The
+     supervisor checks the task heartbeats every WDOG_PERIOD_TICKS ticks and refreshes
+     only if all are alive. A refresh is only accepted once the counter has passed the
+     window, so a runaway loop refreshing too often resets the processor as well. The
+     timeout allows one missed check before the reset. */
+#define WDOG_PERIOD_TICKS           100U    /* Ticks between heartbeat checks */
+#define WDOG_WINDOW_MS              50U     /* Refreshes before this are rejected */
+#define WDOG_TIMEOUT_MS             250U    /* Reset this long after the last refresh */
+
+  /*
+   ** ===================================================================
+   **     Method      :  WDOG_Refresh (module Events)
+   */
+  /*!
+   **     @brief
+   **         Refresh callback of the task scheduler's heartbeat supervisor.
+   **         The two writes of the refresh sequence have to follow each
+   **         other within 20 bus clocks, so interrupts are held off.
+   */
+  /* ===================================================================*/
+  void WDOG_Refresh(void)
+  {
+    EnterCritical();
+    WDOG_PDD_WriteRefreshReg(WDOG_BASE_PTR, 0xA602U);
+    WDOG_PDD_WriteRefreshReg(WDOG_BASE_PTR, 0xB480U);
+    ExitCritical();
+  }
+
+  /*
+   ** ===================================================================
+   **     Method      :  WDOG_Interrupt (module Events)
+   */
+  /*!
+   **     @brief
+   **         WDOG interrupt, raised 256 bus clocks before the watchdog
+   **         resets the processor. Records the task that was running in
+   **         the reset cause. Route the CPU component's ivINT_WDOG_EWM
+   **         vector to this function.
+   */
+  /* ===================================================================*/
+  void WDOG_Interrupt(void)
+  {
+    FCS_TASK_SCHDLR_watchdogIsr();
+  }
+
+  /*
+   ** ===================================================================
+   **     Method      :  WDOG_SupervisorInit (module Events)
+   */
+  /*!
+   **     @brief
+   **         Enables the WDOG, disabled by the CPU component, in windowed
+   **         mode with its interrupt, and registers WDOG_Refresh with the
+   **         task scheduler. The configuration is locked until the next
+   **         reset. Call after the supervised tasks are given their
+   **         heartbeat windows, just before the dispatcher.
+   */
+  /* ===================================================================*/
+  void WDOG_SupervisorInit(void)
+  {
+    EnterCritical();
+    /* The unlock sequence opens a 256 bus clock window for the configuration. */
+    WDOG_PDD_WriteUnlockReg(WDOG_BASE_PTR, 0xC520U);
+    WDOG_PDD_WriteUnlockReg(WDOG_BASE_PTR, 0xD928U);
+    WDOG_PDD_WritePrescalerReg(WDOG_BASE_PTR, 0U);
+    WDOG_PDD_WriteTimeOutHighReg(WDOG_BASE_PTR, 0U);
+    WDOG_PDD_WriteTimeOutLowReg(WDOG_BASE_PTR, WDOG_TIMEOUT_MS);
+    WDOG_PDD_WriteWindowHighReg(WDOG_BASE_PTR, 0U);
+    WDOG_PDD_WriteWindowLowReg(WDOG_BASE_PTR, WDOG_WINDOW_MS);
+    /* LPO clock, kept running in wait and stop modes. ALLOWUPDATE stays clear. */
+    WDOG_PDD_WriteControlHighReg(WDOG_BASE_PTR, WDOG_STCTRLH_WDOGEN_MASK | WDOG_STCTRLH_WINEN_MASK
+        | WDOG_STCTRLH_IRQRSTEN_MASK | WDOG_STCTRLH_WAITEN_MASK | WDOG_STCTRLH_STOPEN_MASK);
+    ExitCritical();
+
+    FCS_TASK_SCHDLR_registerWatchdogCb(WDOG_Refresh, WDOG_PERIOD_TICKS);
+  }
+#endif
+
+#ifdef FCS_TASK_SCHDLR_SLEEP_ENABLE
+  /* Sleep modes offered to the task scheduler, shallowest first. Wait keeps FTM0
+     running and wakes with the next tick. VLPS and LLS stop the bus clock and with it
+     FTM0, so LPTMR0 counting the 1 kHz LPO clock, one count per tick, wakes the
+     processor and counts the ticks slept. LLS is left through the LLWU, on which LPTMR0
+     is internal module 0. The core clock is in FEI mode, so nothing needs restoring on
+     wake-up; a PLL setup would relock it here and the measured latency would show it. */
+#define SMC_SLEEP_WAIT              0U      /* WFI, FTM0 keeps ticking */
+#define SMC_SLEEP_VLPS              1U      /* Very-low-power stop */
+#define SMC_SLEEP_LLS               2U      /* Low-leakage stop */
+#define SMC_SLEEP_MODES             3U
+#define SMC_LPTMR_MAX_TICKS         65535U  /* Longest span fitting the 16-bit compare */
+#define SMC_LLWU_NVIC_BIT           (1UL << (INT_LLWU - 16U))       /* In NVICISER0/ICPR0 */
+#define SMC_LPTMR_NVIC_BIT          (1UL << (INT_LPTMR0 - 48U))     /* In NVICISER1/ICPR1 */
+
+  /* Recovery of each mode to RUN from the data sheet, rounded up. The software part
+     of the wake-up is measured with the DWT cycle counter and added. */
+  static const uint32_t SMC_ExitUs[SMC_SLEEP_MODES] = { 1U, 5U, 5U };
+
+  /* Latencies the scheduler starts from, with room for the software part */
+  static const uint32_t SMC_LatencyUs[SMC_SLEEP_MODES] = { 5U, 50U, 100U };
+
+  /*
+   ** ===================================================================
+   **     Method      :  SMC_Sleep (module Events)
+   */
+  /*!
+   **     @brief
+   **         Sleep callback of the task scheduler, called with interrupts
+   **         masked. A pending interrupt still ends the sleep and is taken
+   **         once the scheduler unmasks interrupts.
+   **     @param
+   **         Mode            - SMC_SLEEP_WAIT, SMC_SLEEP_VLPS or
+   **                           SMC_SLEEP_LLS.
+   **     @param
+   **         Ticks           - Ticks to sleep in VLPS and LLS.
+   **     @return
+   **                         - Microseconds from the wake-up time until
+   **                           now, or FCS_TASK_SCHDLR_SLEEP_EARLY if
+   **                           another interrupt ended the sleep.
+   */
+  /* ===================================================================*/
+  uint32_t SMC_Sleep(uint8_t Mode, uint32_t Ticks)
+  {
+    uint32_t WakeCyc;
+    uint32_t Counts;
+    bool Expired;
+
+    if (Mode == SMC_SLEEP_WAIT) {
+      SCB_PDD_EnableDeepSleep(SystemControl_BASE_PTR, PDD_DISABLE);
+      __asm volatile ("wfi");
+
+#ifdef FCS_TASK_SCHDLR_TICKLESS_ENABLE
+      /* Woken by the tick if the compare matched. The counter has run on since. */
+      if (FTM_PDD_GetChannelInterruptFlag(FTM0_BASE_PTR, TU1_TICKLESS_CHANNEL) == 0U) {
+        return FCS_TASK_SCHDLR_SLEEP_EARLY;
+      }
+      Counts = (FTM_PDD_ReadCounterReg(FTM0_BASE_PTR)
+          - FTM_PDD_ReadChannelValueReg(FTM0_BASE_PTR, TU1_TICKLESS_CHANNEL)) & TU1_TICKLESS_CNT_MASK;
+      return (Counts * TU1_TICKLESS_CNT_UNITS * FCS_TASK_SCHDLR_TICK_US) / TU1_TICKLESS_TICK_UNITS;
+#else
+      /* Woken by the tick if FTM0 restarted. Its counter then holds the time since. */
+      if (FTM_PDD_GetOverflowInterruptFlag(FTM0_BASE_PTR) == 0U) {
+        return FCS_TASK_SCHDLR_SLEEP_EARLY;
+      }
+      Counts = FTM_PDD_ReadCounterReg(FTM0_BASE_PTR);
+      return (Counts * FCS_TASK_SCHDLR_TICK_US) / (FTM_PDD_ReadModuloReg(FTM0_BASE_PTR) + 1U);
+#endif
+    }
+
+    if (Ticks > SMC_LPTMR_MAX_TICKS) {
+      Ticks = SMC_LPTMR_MAX_TICKS;
+    }
+
+    /* Enabling LPTMR0 starts its count from 0. */
+    LPTMR_PDD_WriteCompareReg(LPTMR0_BASE_PTR, Ticks - 1U);
+    LPTMR_PDD_EnableDevice(LPTMR0_BASE_PTR, PDD_ENABLE);
+    SMC_PDD_SelectStopModeControl(SMC_BASE_PTR, (Mode == SMC_SLEEP_LLS) ? SMC_PDD_SM_LLS : SMC_PDD_SM_VLPS);
+    /* The stop mode has to be set before WFI executes. */
+    (void) SMC_PDD_ReadPowerModeControlReg(SMC_BASE_PTR);
+    SCB_PDD_EnableDeepSleep(SystemControl_BASE_PTR, PDD_ENABLE);
+    __asm volatile ("wfi");
+    WakeCyc = DWT_CYCCNT;
+    SCB_PDD_EnableDeepSleep(SystemControl_BASE_PTR, PDD_DISABLE);
+
+    /* Credit the ticks slept. Disabling LPTMR0 clears its flag and with it the LLWU's. */
+    Expired = (LPTMR_PDD_GetInterruptFlag(LPTMR0_BASE_PTR) != 0U);
+    Counts = Expired ? Ticks : LPTMR_PDD_ReadCounterReg(LPTMR0_BASE_PTR);
+    LPTMR_PDD_EnableDevice(LPTMR0_BASE_PTR, PDD_DISABLE);
+    NVICICPR0 = SMC_LLWU_NVIC_BIT;
+    NVICICPR1 = SMC_LPTMR_NVIC_BIT;
+    if (Counts > 0U) {
+      FCS_TASK_SCHDLR_clockTicks(Counts);
+    }
+
+    if (!Expired) {
+      /* Another interrupt, or one pending at entry, which aborts the stop. */
+      return FCS_TASK_SCHDLR_SLEEP_EARLY;
+    }
+    return SMC_ExitUs[Mode] + ((DWT_CYCCNT - WakeCyc) / (CPU_CORE_CLK_HZ / 1000000U));
+  }
+
+  /*
+   ** ===================================================================
+   **     Method      :  SMC_SleepInit (module Events)
+   */
+  /*!
+   **     @brief
+   **         Allows VLPS and LLS, sets LPTMR0 up as their wake-up timer and
+   **         registers SMC_Sleep with the task scheduler. PMPROT can only be
+   **         written once after reset, so if the CPU component writes it,
+   **         allow VLP and LLS in its power mode settings instead.
+   */
+  /* ===================================================================*/
+  void SMC_SleepInit(void)
+  {
+    EnterCritical();
+    SMC_PDD_WritePowerModeProtectionReg(SMC_BASE_PTR, SMC_PMPROT_AVLP_MASK | SMC_PMPROT_ALLS_MASK);
+
+    SIM_SCGC5 |= SIM_SCGC5_LPTMR_MASK;
+    LPTMR_PDD_EnableDevice(LPTMR0_BASE_PTR, PDD_DISABLE);
+    LPTMR_PDD_SelectPrescalerSource(LPTMR0_BASE_PTR, LPTMR_PDD_SOURCE_LPO1KHZ);
+    LPTMR_PDD_EnablePrescalerBypass(LPTMR0_BASE_PTR, LPTMR_PDD_BYPASS_ENABLED);
+    LPTMR_PDD_EnableInterrupt(LPTMR0_BASE_PTR);
+    LLWU_PDD_EnableInternalModuleWakeup(LLWU_BASE_PTR, LLWU_PDD_INTERNAL_MODULE_0);
+
+    /* Both interrupts have to be enabled to end a sleep. SMC_Sleep clears them before
+       they are taken. */
+    NVICICPR0 = SMC_LLWU_NVIC_BIT;
+    NVICICPR1 = SMC_LPTMR_NVIC_BIT;
+    NVICISER0 = SMC_LLWU_NVIC_BIT;
+    NVICISER1 = SMC_LPTMR_NVIC_BIT;
+
+    /* Start the DWT cycle counter for the latency measurement. */
+    DEMCR |= (1UL << 24);
+    DWT_CTRL |= 1UL;
+    ExitCritical();
+
+    (void) FCS_TASK_SCHDLR_registerSleepCb(SMC_Sleep, SMC_LatencyUs, SMC_SLEEP_MODES);
+  }
+#endif
+
   /*
    ** ===================================================================
    **     Event       :  Cpu_OnNMI (module Events)
@@ -79,7 +442,43 @@ extern "C" {
   /* ===================================================================*/
   void TU1_OnCounterRestart(LDD_TUserData *UserDataPtr)
   {
+#ifdef FCS_TASK_SCHDLR_TICKLESS_ENABLE
+    /* The free-running counter wrapped. Reading it here keeps the reads less than a
+       wrap apart even if the compare is held off. */
+    (void) TU1_CreditCounts();
+#else
     FCS_TASK_SCHDLR_clockTick();
+#endif
+  }
+
+  /*
+   ** ===================================================================
+   **     Event       :  TU1_OnChannel0 (module Events)
+   **
+   **     Component   :  TU1 [TimerUnit_LDD]
+   */
+  /*!
+   **     @brief
+   **         Called if compare register match occurs. OnChannel0 event and
+   **         Timer unit must be enabled. See [SetEventMask] and
+   **         [GetEventMask] methods. This event is available only if a
+   **         [Interrupt] is enabled.
+   **     @param
+   **         UserDataPtr     - Pointer to the user or
+   **                           RTOS specific data. The pointer passed as
+   **                           the parameter of Init method.
+   */
+  /* ===================================================================*/
+  void TU1_OnChannel0(LDD_TUserData *UserDataPtr)
+  {
+#ifdef FCS_TASK_SCHDLR_TICKLESS_ENABLE
+    /* The deadline has been reached. The compare is armed again with the same span
+       until the dispatcher reprograms it. */
+    (void) TU1_CreditCounts();
+    TU1_ArmCompare();
+#else
+    (void) UserDataPtr;
+#endif
   }
 
   /* END Events */
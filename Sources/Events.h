@@ -83,6 +83,45 @@ void Cpu_OnNMI(void);
 /* ===================================================================*/
 void TU1_OnCounterRestart(LDD_TUserData *UserDataPtr);
 
+/*
+** ===================================================================
+**     Event       :  TU1_OnChannel0 (module Events)
+**
+**     Component   :  TU1 [TimerUnit_LDD]
+*/
+/*!
+**     @brief
+**         Called if compare register match occurs. OnChannel0 event and
+**         Timer unit must be enabled. See [SetEventMask] and
+**         [GetEventMask] methods. This event is available only if a
+**         [Interrupt] is enabled.
+**     @param
+**         UserDataPtr     - Pointer to the user or
+**                           RTOS specific data. The pointer passed as
+**                           the parameter of Init method.
+*/
+/* ===================================================================*/
+void TU1_OnChannel0(LDD_TUserData *UserDataPtr);
+
+#ifdef FCS_TASK_SCHDLR_TICKLESS_ENABLE
+/* Tickless FTM0 time base for the task scheduler, see Events.c */
+void TU1_TicklessInit(void);
+void TU1_SetTickSpan(uint32_t Ticks);
+#endif
+
+#ifdef FCS_TASK_SCHDLR_WATCHDOG_ENABLE
+/* Windowed WDOG refreshed by the task scheduler's heartbeat supervisor, see Events.c */
+void WDOG_SupervisorInit(void);
+void WDOG_Refresh(void);
+void WDOG_Interrupt(void);
+#endif
+
+#ifdef FCS_TASK_SCHDLR_SLEEP_ENABLE
+/* Low-power idle of the task scheduler in Wait, VLPS or LLS, see Events.c */
+void SMC_SleepInit(void);
+uint32_t SMC_Sleep(uint8_t Mode, uint32_t Ticks);
+#endif
+
 /* END Events */
 
 #ifdef __cplusplus
@@ -0,0 +1,268 @@
+//***********************************************************************************
+// Module Name:         mem_pool.c
+// Application:
+// Platform:            Kinetis K22 (Cortex-M4F), GNU C Compiler
+// Author(s):           Derrick Simeon
+// Notes:
+// Description:
+// The pools share one statically allocated array, split in class order. A free block
+// holds the index of the next free block of its pool in its first word. Each pool's
+// free list head packs a 16-bit tag above the 16-bit index of its first free block
+// and is only changed by compare-and-swap (LDREX/STREX on the Cortex-M4).
+// Copyright (c) 2016, Franklin Control Systems, all rights reserved
+//***********************************************************************************
+
+//**************
+// Includes
+//**************
+
+// Standard C libraries
+#include <stddef.h>
+
+// Project-specific modules
+#include "mem_pool.h"
+
+//**************
+// Defines
+//**************
+
+#define BLOCK_NULL_IDX      0xFFFF                                  // End of a free list
+#define HEAD_TAG_ONE        0x10000UL                               // Tag increment of a free list head
+#define HEAD_IDX(head)      ((head) & 0xFFFF)                       // Block index of a free list head
+
+#define POOL_ENTRY(nBlockSize, nBlocks)     { NULL, (nBlockSize), (nBlocks), BLOCK_NULL_IDX, 0, 0, 0 },
+#define POOL_BYTES(nBlockSize, nBlocks)     + ((uint32_t) (nBlockSize) * (nBlocks))
+#define POOL_INVALID(nBlockSize, nBlocks)   + ((((nBlockSize) % 8) != 0) || ((nBlocks) == 0) || ((nBlocks) >= BLOCK_NULL_IDX))
+
+// Block sizes must keep every block 8-byte aligned and block indices must fit below
+// the end marker.
+typedef char POOL_CLASSES_INVALID[((0 FCS_MEM_POOL_CLASSES(POOL_INVALID)) == 0) ? 1 : -1];
+
+//**************
+// Local Typedefs
+//**************
+
+// Memory pool
+typedef struct _FCS_MemPool_t {
+    uint8_t             *pBase;         // First block
+    uint32_t            nBlockSize;     // Bytes per block
+    uint32_t            nBlocks;        // Blocks in the pool
+    volatile uint32_t   nFreeHead;      // Tag and index of the first free block
+    volatile uint32_t   nInUse;         // Blocks allocated now
+    volatile uint32_t   nHighWater;     // Most blocks allocated at once
+    volatile uint32_t   nFailures;      // Allocations that found the pool empty
+} FCS_MemPool_t;
+
+//**************
+// Local Variables
+//**************
+
+// Block storage, placed in the region ProcessorExpert.ld reserves for it
+static uint64_t m_aPoolMem[(0 FCS_MEM_POOL_CLASSES(POOL_BYTES)) / sizeof(uint64_t)]
+        __attribute__((section(".mem_pool")));
+
+static FCS_MemPool_t m_aPools[FCS_MEM_POOL_POOLS] = {
+    FCS_MEM_POOL_CLASSES(POOL_ENTRY)
+};
+
+//**************
+// Local Functions
+//**************
+
+static void *_FCS_MEM_POOL_pop(FCS_MemPool_t *pPool);
+
+//***************************************************************************
+// Function Name:   _FCS_MEM_POOL_pop
+// Returns:         Pointer to the block or NULL if the pool is empty.
+// Param1:          *pPool - Pool.
+// Description:     Takes the first block off a pool's free list and updates the
+// pool's statistics.
+//***************************************************************************
+static void *_FCS_MEM_POOL_pop(FCS_MemPool_t *pPool)
+{
+    uint32_t nHead;
+    uint32_t nNext;
+    uint32_t nInUse;
+    uint32_t nHigh;
+    uint8_t *pBlock;
+
+    do
+    {
+        nHead = pPool->nFreeHead;
+
+        if(HEAD_IDX(nHead) == BLOCK_NULL_IDX)
+        {
+            (void) __sync_add_and_fetch(&pPool->nFailures, 1);
+            return NULL;
+        }
+
+        // An interrupt may take the block and overwrite its link before the swap, but
+        // then the head's tag has changed and the swap fails.
+        pBlock = &pPool->pBase[HEAD_IDX(nHead) * pPool->nBlockSize];
+        nNext = *(volatile uint32_t *) pBlock;
+    } while(!__sync_bool_compare_and_swap(&pPool->nFreeHead, nHead,
+            ((nHead + HEAD_TAG_ONE) & ~0xFFFFUL) | nNext));
+
+    nInUse = __sync_add_and_fetch(&pPool->nInUse, 1);
+
+    do
+    {
+        nHigh = pPool->nHighWater;
+
+        if(nInUse <= nHigh)
+        {
+            break;
+        }
+    } while(!__sync_bool_compare_and_swap(&pPool->nHighWater, nHigh, nInUse));
+
+    return pBlock;
+}
+
+//***************************************************************************
+// Function Name:   FCS_MEM_POOL_init
+// Returns:         void
+// Param1:          void
+// Description:     Splits the block storage into the pools and chains every block
+// of each pool on its free list in address order.
+//***************************************************************************
+void FCS_MEM_POOL_init(void)
+{
+    uint8_t *pMem = (uint8_t *) m_aPoolMem;
+    FCS_MemPool_t *pPool;
+    uint32_t pool;
+    uint32_t idx;
+
+    for(pool = 0; pool < FCS_MEM_POOL_POOLS; pool++)
+    {
+        pPool = &m_aPools[pool];
+        pPool->pBase = pMem;
+
+        for(idx = 0; idx < pPool->nBlocks; idx++)
+        {
+            *(uint32_t *) &pMem[idx * pPool->nBlockSize] =
+                    ((idx + 1) < pPool->nBlocks) ? (idx + 1) : BLOCK_NULL_IDX;
+        }
+
+        pPool->nFreeHead = 0;
+        pPool->nInUse = 0;
+        pPool->nHighWater = 0;
+        pPool->nFailures = 0;
+
+        pMem += pPool->nBlocks * pPool->nBlockSize;
+    }
+}
+
+//***************************************************************************
+// Function Name:   FCS_MEM_POOL_alloc
+// Returns:         Pointer to a block of at least nBytes or NULL.
+// Param1:          nBytes - Bytes needed.
+// Description:     Allocates from the smallest class that fits and has a free block.
+//***************************************************************************
+void *FCS_MEM_POOL_alloc(uint32_t nBytes)
+{
+    uint32_t pool;
+    void *pBlock;
+
+    for(pool = 0; pool < FCS_MEM_POOL_POOLS; pool++)
+    {
+        if(m_aPools[pool].nBlockSize >= nBytes)
+        {
+            pBlock = _FCS_MEM_POOL_pop(&m_aPools[pool]);
+
+            if(pBlock != NULL)
+            {
+                return pBlock;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+//***************************************************************************
+// Function Name:   FCS_MEM_POOL_free
+// Returns:         void
+// Param1:          *pBlock - Block from FCS_MEM_POOL_alloc, or NULL.
+// Description:     Pushes a block back on the free list of the pool it lies in.
+//***************************************************************************
+void FCS_MEM_POOL_free(void *pBlock)
+{
+    uint8_t *pByte = (uint8_t *) pBlock;
+    FCS_MemPool_t *pPool;
+    uint32_t nHead;
+    uint32_t pool;
+    uint32_t idx;
+
+    if(pByte == NULL)
+    {
+        return;
+    }
+
+    for(pool = 0; pool < FCS_MEM_POOL_POOLS; pool++)
+    {
+        pPool = &m_aPools[pool];
+
+        if((pByte >= pPool->pBase) && (pByte < &pPool->pBase[pPool->nBlocks * pPool->nBlockSize]))
+        {
+            idx = (uint32_t) (pByte - pPool->pBase) / pPool->nBlockSize;
+            pByte = &pPool->pBase[idx * pPool->nBlockSize];
+
+            // Counted free before another allocation can take it, so the count never
+            // exceeds the blocks actually allocated.
+            (void) __sync_sub_and_fetch(&pPool->nInUse, 1);
+
+            do
+            {
+                nHead = pPool->nFreeHead;
+                *(volatile uint32_t *) pByte = HEAD_IDX(nHead);
+            } while(!__sync_bool_compare_and_swap(&pPool->nFreeHead, nHead,
+                    ((nHead + HEAD_TAG_ONE) & ~0xFFFFUL) | idx));
+
+            return;
+        }
+    }
+
+    // Not a pool block.
+}
+
+//***************************************************************************
+// Function Name:   FCS_MEM_POOL_getStats
+// Returns:         Success status, false for an invalid pool number.
+// Param1:          nPool - Pool number.
+// Param2:          *pStats - Receives the pool's statistics.
+// Description:     Copies a pool's size and usage counters.
+//***************************************************************************
+bool FCS_MEM_POOL_getStats(uint8_t nPool, FCS_MemPoolStats_t *pStats)
+{
+    if(nPool >= FCS_MEM_POOL_POOLS)
+    {
+        return false;
+    }
+
+    pStats->nBlockSize = m_aPools[nPool].nBlockSize;
+    pStats->nBlocks = m_aPools[nPool].nBlocks;
+    pStats->nInUse = m_aPools[nPool].nInUse;
+    pStats->nHighWater = m_aPools[nPool].nHighWater;
+    pStats->nFailures = m_aPools[nPool].nFailures;
+
+    return true;
+}
+
+//***************************************************************************
+// Function Name:   FCS_MEM_POOL_clearStats
+// Returns:         Success status, false for an invalid pool number.
+// Param1:          nPool - Pool number.
+// Description:     Restarts a pool's high-water mark and failure count.
+//***************************************************************************
+bool FCS_MEM_POOL_clearStats(uint8_t nPool)
+{
+    if(nPool >= FCS_MEM_POOL_POOLS)
+    {
+        return false;
+    }
+
+    m_aPools[nPool].nHighWater = m_aPools[nPool].nInUse;
+    m_aPools[nPool].nFailures = 0;
+
+    return true;
+}
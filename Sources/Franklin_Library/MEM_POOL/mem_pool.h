@@ -0,0 +1,113 @@
+//***********************************************************************************
+// Module Name:         mem_pool.h
+// Application:
+// Platform:            Kinetis K22 (Cortex-M4F), GNU C Compiler
+// Author(s):           Derrick Simeon
+// Notes:
+// Description:
+// Fixed-block memory pools in several size classes, as a deterministic replacement
+// for malloc. Allocating and freeing take constant time whatever the number of
+// blocks, blocks never fragment, and both are lock-free so interrupts may allocate
+// and free too.
+//
+// Each pool keeps its free blocks on a singly linked list of block indices. The list
+// head holds a tag that changes on every update, so a pop interrupted by another pop
+// and push of the same block is retried rather than corrupting the list.
+//
+// Usage instructions:
+// List the size classes in the application's mem_pool_classes.h and call
+// FCS_MEM_POOL_init once before the first allocation. The pools are statically
+// allocated in the .mem_pool section of ProcessorExpert.ld, so the linker reports
+// when they do not fit.
+// Copyright (c) 2016, Franklin Control Systems, all rights reserved
+//***********************************************************************************
+
+#ifndef MEM_POOL_H_
+#define MEM_POOL_H_
+
+//**************
+// Includes
+//**************
+
+// Standard C libraries
+#include <stdint.h>
+#include <stdbool.h>
+
+// Project-specific modules
+#include "mem_pool_classes.h"
+
+//**************
+// Defines
+//**************
+
+#define FCS_MEM_POOL_COUNT(nBlockSize, nBlocks)     + 1
+
+// Number of pools
+#define FCS_MEM_POOL_POOLS          (0 FCS_MEM_POOL_CLASSES(FCS_MEM_POOL_COUNT))
+
+//**************
+// Global Typedefs
+//**************
+
+// Pool usage statistics
+typedef struct _FCS_MemPoolStats_t {
+    uint32_t    nBlockSize;     // Bytes per block
+    uint32_t    nBlocks;        // Blocks in the pool
+    uint32_t    nInUse;         // Blocks allocated now
+    uint32_t    nHighWater;     // Most blocks allocated at once
+    uint32_t    nFailures;      // Allocations that found the pool empty
+} FCS_MemPoolStats_t;
+
+//**************
+// Global Functions
+//**************
+
+//***************************************************************************
+// Function Name:   FCS_MEM_POOL_init
+// Returns:         void
+// Param1:          void
+// Description:     Puts every block of every pool on its free list and clears the
+// statistics. Outstanding blocks are lost, so call it before the first allocation.
+//***************************************************************************
+extern void FCS_MEM_POOL_init(void);
+
+//***************************************************************************
+// Function Name:   FCS_MEM_POOL_alloc
+// Returns:         Pointer to a block of at least nBytes, 8-byte aligned, or NULL if
+//                  no pool can supply one.
+// Param1:          nBytes - Bytes needed.
+// Description:     Allocates a block from the pool of the smallest class that fits.
+// When that pool is empty its failure count is raised and the next larger class is
+// tried. Safe to call from interrupts.
+//***************************************************************************
+extern void *FCS_MEM_POOL_alloc(uint32_t nBytes);
+
+//***************************************************************************
+// Function Name:   FCS_MEM_POOL_free
+// Returns:         void
+// Param1:          *pBlock - Block from FCS_MEM_POOL_alloc, or NULL.
+// Description:     Returns a block to its pool, found from its address. Safe to call
+// from interrupts.
+//***************************************************************************
+extern void FCS_MEM_POOL_free(void *pBlock);
+
+//***************************************************************************
+// Function Name:   FCS_MEM_POOL_getStats
+// Returns:         Success status, false for an invalid pool number.
+// Param1:          nPool - Pool number, in order of mem_pool_classes.h from 0.
+// Param2:          *pStats - Receives the pool's statistics.
+// Description:     Reads a pool's usage, e.g. to size the classes from the
+// high-water marks of a long run.
+//***************************************************************************
+extern bool FCS_MEM_POOL_getStats(uint8_t nPool, FCS_MemPoolStats_t *pStats);
+
+//***************************************************************************
+// Function Name:   FCS_MEM_POOL_clearStats
+// Returns:         Success status, false for an invalid pool number.
+// Param1:          nPool - Pool number.
+// Description:     Restarts a pool's high-water mark from its current use and
+// clears its failure count.
+//***************************************************************************
+extern bool FCS_MEM_POOL_clearStats(uint8_t nPool);
+
+#endif /* MEM_POOL_H_ */
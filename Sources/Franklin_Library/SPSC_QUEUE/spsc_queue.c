@@ -0,0 +1,298 @@
+//***********************************************************************************
+// Module Name:         spsc_queue.c
+// Application:
+// Platform:            Kinetis K22 (Cortex-M4F), GNU C Compiler
+// Author(s):           Derrick Simeon
+// Notes:
+// Description:
+// Each index has a single writer: the producer advances the head after filling slots
+// and the consumer advances the tail after emptying them. A barrier orders the slot
+// accesses before the index update that hands them to the other side, so neither side
+// needs a critical section.
+// Copyright (c) 2016, Franklin Control Systems, all rights reserved
+//***********************************************************************************
+
+//**************
+// Includes
+//**************
+
+// Standard C libraries
+#include <stddef.h>
+#include <string.h>
+
+// Project-specific modules
+#include "spsc_queue.h"
+
+//**************
+// Defines
+//**************
+
+// Orders memory accesses across it. A DMB on the Cortex-M4, which also keeps the
+// compiler from moving slot accesses past an index update.
+#define QUEUE_BARRIER()     __sync_synchronize()
+
+//***************************************************************************
+// Function Name:   FCS_SPSC_QUEUE_init
+// Returns:         Success status of initialization.
+// Param1:          *pQueue - Queue.
+// Param2:          *pBuf - Storage for nCapacity elements.
+// Param3:          nElemSize - Bytes per element.
+// Param4:          nCapacity - Elements the queue holds, a power of two.
+// Description:     Initializes an empty queue without a consumer task.
+//***************************************************************************
+bool FCS_SPSC_QUEUE_init(FCS_SpscQueue_t *pQueue, void *pBuf, uint32_t nElemSize,
+        uint32_t nCapacity)
+{
+    if((nCapacity == 0) || ((nCapacity & (nCapacity - 1)) != 0) || (nElemSize == 0))
+    {
+        return false;
+    }
+
+    pQueue->nHead = 0;
+    pQueue->nTail = 0;
+    pQueue->nDropped = 0;
+    pQueue->nMask = nCapacity - 1;
+    pQueue->nElemSize = nElemSize;
+    pQueue->pBuf = (uint8_t *) pBuf;
+    pQueue->hConsumer = FCS_TASK_SCHDLR_INVALID_HANDLE;
+
+    return true;
+}
+
+//***************************************************************************
+// Function Name:   FCS_SPSC_QUEUE_setConsumer
+// Returns:         void
+// Param1:          *pQueue - Queue.
+// Param2:          hTask - Task to signal when elements are pushed.
+// Description:     Sets the consumer task.
+//***************************************************************************
+void FCS_SPSC_QUEUE_setConsumer(FCS_SpscQueue_t *pQueue, FCS_TaskHandle_t hTask)
+{
+    pQueue->hConsumer = hTask;
+}
+
+//***************************************************************************
+// Function Name:   FCS_SPSC_QUEUE_push
+// Returns:         False if the queue was full.
+// Param1:          *pQueue - Queue.
+// Param2:          *pElem - Element to copy in.
+// Description:     Appends one element.
+//***************************************************************************
+bool FCS_SPSC_QUEUE_push(FCS_SpscQueue_t *pQueue, const void *pElem)
+{
+    return FCS_SPSC_QUEUE_pushBatch(pQueue, pElem, 1) == 1;
+}
+
+//***************************************************************************
+// Function Name:   FCS_SPSC_QUEUE_pushBatch
+// Returns:         Number of elements appended.
+// Param1:          *pQueue - Queue.
+// Param2:          *pElems - Elements to copy in.
+// Param3:          nElems - Number of elements.
+// Description:     Appends as many elements as fit, copying them in at most two
+// pieces around the end of the buffer.
+//***************************************************************************
+uint32_t FCS_SPSC_QUEUE_pushBatch(FCS_SpscQueue_t *pQueue, const void *pElems,
+        uint32_t nElems)
+{
+    uint32_t nHead = pQueue->nHead;
+    uint32_t nFree = (pQueue->nMask + 1) - (nHead - pQueue->nTail);
+    uint32_t nSlot = nHead & pQueue->nMask;
+    uint32_t nFirst;
+
+    // Slots freed by the consumer are only reused after the tail is read.
+    QUEUE_BARRIER();
+
+    if(nElems > nFree)
+    {
+        pQueue->nDropped += nElems - nFree;
+        nElems = nFree;
+    }
+
+    // The free space can wrap past the end of the buffer.
+    nFirst = (pQueue->nMask + 1) - nSlot;
+
+    if(nFirst > nElems)
+    {
+        nFirst = nElems;
+    }
+
+    memcpy(&pQueue->pBuf[nSlot * pQueue->nElemSize], pElems, nFirst * pQueue->nElemSize);
+    memcpy(pQueue->pBuf, (const uint8_t *) pElems + (nFirst * pQueue->nElemSize),
+            (nElems - nFirst) * pQueue->nElemSize);
+
+    FCS_SPSC_QUEUE_commit(pQueue, nElems);
+
+    return nElems;
+}
+
+//***************************************************************************
+// Function Name:   FCS_SPSC_QUEUE_reserve
+// Returns:         Pointer to the first free slot or NULL if the queue is full.
+// Param1:          *pQueue - Queue.
+// Param2:          *pnSlots - Returns the free slots following it without wrapping.
+// Description:     Lends free slots to fill in place.
+//***************************************************************************
+void *FCS_SPSC_QUEUE_reserve(FCS_SpscQueue_t *pQueue, uint32_t *pnSlots)
+{
+    uint32_t nHead = pQueue->nHead;
+    uint32_t nFree = (pQueue->nMask + 1) - (nHead - pQueue->nTail);
+    uint32_t nSlot = nHead & pQueue->nMask;
+
+    // Slots freed by the consumer are only reused after the tail is read.
+    QUEUE_BARRIER();
+
+    if(nFree > ((pQueue->nMask + 1) - nSlot))
+    {
+        nFree = (pQueue->nMask + 1) - nSlot;
+    }
+
+    *pnSlots = nFree;
+
+    return (nFree == 0) ? NULL : &pQueue->pBuf[nSlot * pQueue->nElemSize];
+}
+
+//***************************************************************************
+// Function Name:   FCS_SPSC_QUEUE_commit
+// Returns:         void
+// Param1:          *pQueue - Queue.
+// Param2:          nSlots - Slots filled, at most the number reserved.
+// Description:     Publishes reserved slots and signals the consumer task.
+//***************************************************************************
+void FCS_SPSC_QUEUE_commit(FCS_SpscQueue_t *pQueue, uint32_t nSlots)
+{
+    if(nSlots == 0)
+    {
+        return;
+    }
+
+    // The slots are filled before the consumer can see them.
+    QUEUE_BARRIER();
+    pQueue->nHead += nSlots;
+
+    if(pQueue->hConsumer != FCS_TASK_SCHDLR_INVALID_HANDLE)
+    {
+        (void) FCS_TASK_SCHDLR_signalHndl(pQueue->hConsumer);
+    }
+}
+
+//***************************************************************************
+// Function Name:   FCS_SPSC_QUEUE_pop
+// Returns:         False if the queue was empty.
+// Param1:          *pQueue - Queue.
+// Param2:          *pElem - Receives the oldest element.
+// Description:     Removes one element.
+//***************************************************************************
+bool FCS_SPSC_QUEUE_pop(FCS_SpscQueue_t *pQueue, void *pElem)
+{
+    return FCS_SPSC_QUEUE_popBatch(pQueue, pElem, 1) == 1;
+}
+
+//***************************************************************************
+// Function Name:   FCS_SPSC_QUEUE_popBatch
+// Returns:         Number of elements removed.
+// Param1:          *pQueue - Queue.
+// Param2:          *pElems - Receives up to nMax elements, oldest first.
+// Param3:          nMax - Most elements to remove.
+// Description:     Removes the queued elements up to nMax, copying them out in at
+// most two pieces around the end of the buffer.
+//***************************************************************************
+uint32_t FCS_SPSC_QUEUE_popBatch(FCS_SpscQueue_t *pQueue, void *pElems, uint32_t nMax)
+{
+    uint32_t nTail = pQueue->nTail;
+    uint32_t nUsed = pQueue->nHead - nTail;
+    uint32_t nSlot = nTail & pQueue->nMask;
+    uint32_t nFirst;
+
+    // Slots published by the producer are only read after the head is read.
+    QUEUE_BARRIER();
+
+    if(nUsed > nMax)
+    {
+        nUsed = nMax;
+    }
+
+    // The queued elements can wrap past the end of the buffer.
+    nFirst = (pQueue->nMask + 1) - nSlot;
+
+    if(nFirst > nUsed)
+    {
+        nFirst = nUsed;
+    }
+
+    memcpy(pElems, &pQueue->pBuf[nSlot * pQueue->nElemSize], nFirst * pQueue->nElemSize);
+    memcpy((uint8_t *) pElems + (nFirst * pQueue->nElemSize), pQueue->pBuf,
+            (nUsed - nFirst) * pQueue->nElemSize);
+
+    FCS_SPSC_QUEUE_release(pQueue, nUsed);
+
+    return nUsed;
+}
+
+//***************************************************************************
+// Function Name:   FCS_SPSC_QUEUE_peek
+// Returns:         Pointer to the oldest element or NULL if the queue is empty.
+// Param1:          *pQueue - Queue.
+// Param2:          *pnSlots - Returns the queued elements following it without
+//                  wrapping.
+// Description:     Lends queued elements to read in place.
+//***************************************************************************
+const void *FCS_SPSC_QUEUE_peek(FCS_SpscQueue_t *pQueue, uint32_t *pnSlots)
+{
+    uint32_t nTail = pQueue->nTail;
+    uint32_t nUsed = pQueue->nHead - nTail;
+    uint32_t nSlot = nTail & pQueue->nMask;
+
+    // Slots published by the producer are only read after the head is read.
+    QUEUE_BARRIER();
+
+    if(nUsed > ((pQueue->nMask + 1) - nSlot))
+    {
+        nUsed = (pQueue->nMask + 1) - nSlot;
+    }
+
+    *pnSlots = nUsed;
+
+    return (nUsed == 0) ? NULL : &pQueue->pBuf[nSlot * pQueue->nElemSize];
+}
+
+//***************************************************************************
+// Function Name:   FCS_SPSC_QUEUE_release
+// Returns:         void
+// Param1:          *pQueue - Queue.
+// Param2:          nSlots - Elements consumed, at most the number peeked.
+// Description:     Frees peeked slots for the producer.
+//***************************************************************************
+void FCS_SPSC_QUEUE_release(FCS_SpscQueue_t *pQueue, uint32_t nSlots)
+{
+    if(nSlots == 0)
+    {
+        return;
+    }
+
+    // The slots are read before the producer can refill them.
+    QUEUE_BARRIER();
+    pQueue->nTail += nSlots;
+}
+
+//***************************************************************************
+// Function Name:   FCS_SPSC_QUEUE_count
+// Returns:         Number of queued elements.
+// Param1:          *pQueue - Queue.
+// Description:     Returns head - tail, which stays correct when the indices wrap.
+//***************************************************************************
+uint32_t FCS_SPSC_QUEUE_count(const FCS_SpscQueue_t *pQueue)
+{
+    return pQueue->nHead - pQueue->nTail;
+}
+
+//***************************************************************************
+// Function Name:   FCS_SPSC_QUEUE_getDropped
+// Returns:         Number of elements rejected because the queue was full.
+// Param1:          *pQueue - Queue.
+// Description:     Returns the drop count.
+//***************************************************************************
+uint32_t FCS_SPSC_QUEUE_getDropped(const FCS_SpscQueue_t *pQueue)
+{
+    return pQueue->nDropped;
+}
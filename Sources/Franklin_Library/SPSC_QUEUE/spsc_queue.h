@@ -0,0 +1,215 @@
+//***********************************************************************************
+// Module Name:         spsc_queue.h
+// Application:
+// Platform:            Kinetis K22 (Cortex-M4F), GNU C Compiler
+// Author(s):           Derrick Simeon
+// Notes:
+// Description:
+// Lock-free single-producer/single-consumer queues of fixed-size elements, for passing
+// data from an interrupt to a task (or between two tasks) in order and without
+// critical sections. The capacity is a power of two so slot indices are masked rather
+// than divided. A full queue rejects new elements and counts them as dropped instead
+// of overwriting unread ones.
+//
+// Each push signals the consumer task, so it runs on the dispatcher's next loop
+// iteration rather than at its next interval. Pushes before it runs coalesce into one
+// run.
+//
+// Usage instructions:
+// Define a typed queue at file scope, then set its consumer task once it is added:
+//
+//  FCS_SPSC_QUEUE_DEFINE(m_adcQ, uint16_t, 64)
+//
+//  (void) m_adcQ_push(&sample);                                // In the ISR
+//  while(m_adcQ_pop(&sample)) { ... }                          // In the consumer task
+//
+// Exactly one context may push to a queue and exactly one may pop from it. The
+// producer uses push, pushBatch or reserve/commit; the consumer uses pop, popBatch or
+// peek/release.
+// Copyright (c) 2016, Franklin Control Systems, all rights reserved
+//***********************************************************************************
+
+#ifndef SPSC_QUEUE_H_
+#define SPSC_QUEUE_H_
+
+//**************
+// Includes
+//**************
+
+// Standard C libraries
+#include <stdint.h>
+#include <stdbool.h>
+
+// Project-specific modules
+#include "task_schdlr.h"
+
+//**************
+// Defines
+//**************
+
+// Static initializer of a queue over a buffer of nCapacity elements of nElemSize
+// bytes, without a consumer task.
+#define FCS_SPSC_QUEUE_INITIALIZER(pBuf, nElemSize, nCapacity)                  \
+    { 0, 0, 0, (nCapacity) - 1U, (nElemSize), (uint8_t *) (pBuf), FCS_TASK_SCHDLR_INVALID_HANDLE }
+
+// Defines a queue of nCapacity elements of the given type, with its buffer and typed
+// name_push and name_pop functions. The capacity must be a power of two.
+#define FCS_SPSC_QUEUE_DEFINE(name, type, nCapacity)                            \
+    typedef char name##_CapacityNotPowerOfTwo[                                  \
+            (((nCapacity) & ((nCapacity) - 1U)) == 0U) ? 1 : -1];               \
+    static type name##_aBuf[(nCapacity)];                                       \
+    static FCS_SpscQueue_t name =                                               \
+            FCS_SPSC_QUEUE_INITIALIZER(name##_aBuf, sizeof(type), (nCapacity)); \
+    static inline bool name##_push(const type *pElem)                           \
+    {                                                                           \
+        return FCS_SPSC_QUEUE_push(&name, pElem);                               \
+    }                                                                           \
+    static inline bool name##_pop(type *pElem)                                  \
+    {                                                                           \
+        return FCS_SPSC_QUEUE_pop(&name, pElem);                                \
+    }
+
+//**************
+// Global Typedefs
+//**************
+
+// Queue. The indices run freely and are masked to slots, so head - tail is the number
+// of queued elements even after they wrap.
+typedef struct _FCS_SpscQueue_t {
+    volatile uint32_t   nHead;          // Elements pushed, written only by the producer
+    volatile uint32_t   nTail;          // Elements popped, written only by the consumer
+    volatile uint32_t   nDropped;       // Elements rejected by a full queue
+    uint32_t            nMask;          // Capacity - 1
+    uint32_t            nElemSize;      // Bytes per element
+    uint8_t             *pBuf;          // Element storage
+    FCS_TaskHandle_t    hConsumer;      // Task signaled when elements are pushed
+} FCS_SpscQueue_t;
+
+//**************
+// Global Functions
+//**************
+
+//***************************************************************************
+// Function Name:   FCS_SPSC_QUEUE_init
+// Returns:         Success status of initialization, false if the capacity is not a
+//                  power of two.
+// Param1:          *pQueue - Queue.
+// Param2:          *pBuf - Storage for nCapacity elements.
+// Param3:          nElemSize - Bytes per element.
+// Param4:          nCapacity - Elements the queue holds, a power of two.
+// Description:     Initializes an empty queue without a consumer task. Neither side
+// may be using the queue.
+//***************************************************************************
+extern bool FCS_SPSC_QUEUE_init(FCS_SpscQueue_t *pQueue, void *pBuf, uint32_t nElemSize,
+        uint32_t nCapacity);
+
+//***************************************************************************
+// Function Name:   FCS_SPSC_QUEUE_setConsumer
+// Returns:         void
+// Param1:          *pQueue - Queue.
+// Param2:          hTask - Task to signal when elements are pushed, or
+//                  FCS_TASK_SCHDLR_INVALID_HANDLE for none.
+// Description:     Sets the consumer task. The task should pop until the queue is
+// empty each time it runs. Elements pushed while it runs signal it again, so none is
+// left waiting for its next interval.
+//***************************************************************************
+extern void FCS_SPSC_QUEUE_setConsumer(FCS_SpscQueue_t *pQueue, FCS_TaskHandle_t hTask);
+
+//***************************************************************************
+// Function Name:   FCS_SPSC_QUEUE_push
+// Returns:         False if the queue was full.
+// Param1:          *pQueue - Queue.
+// Param2:          *pElem - Element to copy in.
+// Description:     Producer side. Appends one element.
+//***************************************************************************
+extern bool FCS_SPSC_QUEUE_push(FCS_SpscQueue_t *pQueue, const void *pElem);
+
+//***************************************************************************
+// Function Name:   FCS_SPSC_QUEUE_pushBatch
+// Returns:         Number of elements appended.
+// Param1:          *pQueue - Queue.
+// Param2:          *pElems - Elements to copy in.
+// Param3:          nElems - Number of elements.
+// Description:     Producer side. Appends as many elements as fit, publishing them
+// together.
+//***************************************************************************
+extern uint32_t FCS_SPSC_QUEUE_pushBatch(FCS_SpscQueue_t *pQueue, const void *pElems,
+        uint32_t nElems);
+
+//***************************************************************************
+// Function Name:   FCS_SPSC_QUEUE_reserve
+// Returns:         Pointer to the first free slot or NULL if the queue is full.
+// Param1:          *pQueue - Queue.
+// Param2:          *pnSlots - Returns the free slots following it without wrapping.
+// Description:     Producer side. Lends free slots to fill in place, e.g. as a DMA
+// target. Nothing is visible to the consumer until FCS_SPSC_QUEUE_commit.
+//***************************************************************************
+extern void *FCS_SPSC_QUEUE_reserve(FCS_SpscQueue_t *pQueue, uint32_t *pnSlots);
+
+//***************************************************************************
+// Function Name:   FCS_SPSC_QUEUE_commit
+// Returns:         void
+// Param1:          *pQueue - Queue.
+// Param2:          nSlots - Slots filled, at most the number reserved.
+// Description:     Producer side. Publishes reserved slots to the consumer.
+//***************************************************************************
+extern void FCS_SPSC_QUEUE_commit(FCS_SpscQueue_t *pQueue, uint32_t nSlots);
+
+//***************************************************************************
+// Function Name:   FCS_SPSC_QUEUE_pop
+// Returns:         False if the queue was empty.
+// Param1:          *pQueue - Queue.
+// Param2:          *pElem - Receives the oldest element.
+// Description:     Consumer side. Removes one element.
+//***************************************************************************
+extern bool FCS_SPSC_QUEUE_pop(FCS_SpscQueue_t *pQueue, void *pElem);
+
+//***************************************************************************
+// Function Name:   FCS_SPSC_QUEUE_popBatch
+// Returns:         Number of elements removed.
+// Param1:          *pQueue - Queue.
+// Param2:          *pElems - Receives up to nMax elements, oldest first.
+// Param3:          nMax - Most elements to remove.
+// Description:     Consumer side. Removes the queued elements up to nMax, freeing
+// their slots together.
+//***************************************************************************
+extern uint32_t FCS_SPSC_QUEUE_popBatch(FCS_SpscQueue_t *pQueue, void *pElems, uint32_t nMax);
+
+//***************************************************************************
+// Function Name:   FCS_SPSC_QUEUE_peek
+// Returns:         Pointer to the oldest element or NULL if the queue is empty.
+// Param1:          *pQueue - Queue.
+// Param2:          *pnSlots - Returns the queued elements following it without
+//                  wrapping.
+// Description:     Consumer side. Lends queued elements to read in place. Their
+// slots stay in use until FCS_SPSC_QUEUE_release.
+//***************************************************************************
+extern const void *FCS_SPSC_QUEUE_peek(FCS_SpscQueue_t *pQueue, uint32_t *pnSlots);
+
+//***************************************************************************
+// Function Name:   FCS_SPSC_QUEUE_release
+// Returns:         void
+// Param1:          *pQueue - Queue.
+// Param2:          nSlots - Elements consumed, at most the number peeked.
+// Description:     Consumer side. Frees peeked slots for the producer.
+//***************************************************************************
+extern void FCS_SPSC_QUEUE_release(FCS_SpscQueue_t *pQueue, uint32_t nSlots);
+
+//***************************************************************************
+// Function Name:   FCS_SPSC_QUEUE_count
+// Returns:         Number of queued elements.
+// Param1:          *pQueue - Queue.
+// Description:     Exact on the consumer side. The producer may see a count that is
+// too high if the consumer pops meanwhile.
+//***************************************************************************
+extern uint32_t FCS_SPSC_QUEUE_count(const FCS_SpscQueue_t *pQueue);
+
+//***************************************************************************
+// Function Name:   FCS_SPSC_QUEUE_getDropped
+// Returns:         Number of elements rejected because the queue was full.
+// Param1:          *pQueue - Queue.
+// Description:     Counts since initialization, to size the queue for bursts.
+//***************************************************************************
+extern uint32_t FCS_SPSC_QUEUE_getDropped(const FCS_SpscQueue_t *pQueue);
+
+#endif /* SPSC_QUEUE_H_ */
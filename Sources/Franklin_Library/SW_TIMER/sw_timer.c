@@ -0,0 +1,522 @@
+//***********************************************************************************
+// Module Name:         sw_timer.c
+// Application:
+// Platform:            Kinetis K22 (Cortex-M4F), GNU C Compiler
+// Author(s):           Derrick Simeon
+// Notes:
+// Description:
+// Running timers are chained in a doubly linked delta list by pool index. The deltas
+// count from the list's origin tick: the head expires nDeltaTcks after the origin and
+// every other timer nDeltaTcks after the one before it. The origin moves forward each
+// time the service task runs, so a start computes its position as the ticks since the
+// origin plus its delay. Stopped timers are chained on a free list through the same
+// links.
+// Copyright (c) 2016, Franklin Control Systems, all rights reserved
+//***********************************************************************************
+
+//**************
+// Includes
+//**************
+
+// Standard C libraries
+#include <stddef.h>
+
+// Project-specific modules
+#include "sw_timer.h"
+
+//**************
+// Defines
+//**************
+
+#define TMR_NULL_IDX        0xFFFF                                  // End of a timer list
+
+//**************
+// Local Typedefs
+//**************
+
+// Software timer
+typedef struct _FCS_SwTimer_t {
+    FCS_SwTimerCb_t     pfnExpire;      // Expiry callback, NULL while in the pool
+    void                *pArg;          // Optional pointer argument passed to the callback
+    uint32_t            nDeltaTcks;     // Ticks after the previous timer of the list expires
+    uint32_t            nDelayTcks;     // Delay of the last start
+    uint32_t            nPeriodTcks;    // Ticks between expiries, 0 for one-shot
+    uint16_t            nNext;          // Next timer of the delta list or free list
+    uint16_t            nPrev;          // Previous timer of the delta list
+    uint8_t             nGen;           // Handle generation
+    bool                bRunning;       // Linked in the delta list
+} FCS_SwTimer_t;
+
+//**************
+// Local Variables
+//**************
+
+static FCS_SwTimer_t m_aTimers[FCS_SW_TIMER_MAX_TIMERS];   // Timer pool
+static uint16_t m_nFreeHead = TMR_NULL_IDX;     // First timer of the free list
+static uint16_t m_nHead = TMR_NULL_IDX;         // First timer to expire
+static uint16_t m_nTail = TMR_NULL_IDX;         // Last timer to expire
+static uint32_t m_nOriginTck = 0;               // Tick the head's delta counts from
+static uint32_t m_nListTcks = 0;                // Ticks from the origin until the tail expires
+static FCS_TaskHandle_t m_hSvcTask = FCS_TASK_SCHDLR_INVALID_HANDLE;   // Service task
+static bool m_bInService = false;               // Service task is expiring timers
+
+//**************
+// Local Functions
+//**************
+
+static FCS_SwTimer_t *_FCS_SW_TIMER_getTimer(FCS_SwTimerHandle_t hTimer);
+static void _FCS_SW_TIMER_insert(uint16_t idx, uint32_t nOffset);
+static void _FCS_SW_TIMER_unlink(uint16_t idx);
+static void _FCS_SW_TIMER_program(void);
+
+//***************************************************************************
+// Function Name:   _FCS_SW_TIMER_getTimer
+// Returns:         Pointer to the timer or NULL if the handle is stale.
+// Param1:          hTimer - Timer handle.
+// Description:     Resolves a handle to its pool entry in constant time.
+//***************************************************************************
+static FCS_SwTimer_t *_FCS_SW_TIMER_getTimer(FCS_SwTimerHandle_t hTimer)
+{
+    uint32_t idx = hTimer & 0xFFFF;
+
+    if((idx >= FCS_SW_TIMER_MAX_TIMERS) || (m_aTimers[idx].nGen != (uint8_t) (hTimer >> 16))
+            || (m_aTimers[idx].pfnExpire == NULL))
+    {
+        // Unknown index, pooled entry or the timer was destroyed since the handle was
+        // issued.
+        return NULL;
+    }
+
+    return &m_aTimers[idx];
+}
+
+//***************************************************************************
+// Function Name:   _FCS_SW_TIMER_insert
+// Returns:         void
+// Param1:          idx - Pool index of a stopped timer.
+// Param2:          nOffset - Ticks from the list's origin until the timer expires.
+// Description:     Links a timer into the delta list behind the timers expiring on
+// or before the same tick. The list is scanned from the end nearer to the offset.
+//***************************************************************************
+static void _FCS_SW_TIMER_insert(uint16_t idx, uint32_t nOffset)
+{
+    FCS_SwTimer_t *pTmr = &m_aTimers[idx];
+    uint16_t nCur;
+    uint32_t nAt;
+
+    pTmr->bRunning = true;
+
+    if(m_nHead == TMR_NULL_IDX)
+    {
+        // Only timer.
+        pTmr->nDeltaTcks = nOffset;
+        pTmr->nNext = TMR_NULL_IDX;
+        pTmr->nPrev = TMR_NULL_IDX;
+        m_nHead = idx;
+        m_nTail = idx;
+        m_nListTcks = nOffset;
+        return;
+    }
+
+    if(nOffset >= m_nListTcks)
+    {
+        // Expires last. Append.
+        pTmr->nDeltaTcks = nOffset - m_nListTcks;
+        pTmr->nNext = TMR_NULL_IDX;
+        pTmr->nPrev = m_nTail;
+        m_aTimers[m_nTail].nNext = idx;
+        m_nTail = idx;
+        m_nListTcks = nOffset;
+        return;
+    }
+
+    if(nOffset < (m_nListTcks / 2))
+    {
+        // Find the first timer expiring after the offset, from the head.
+        nCur = m_nHead;
+        nAt = m_aTimers[nCur].nDeltaTcks;
+
+        while(nAt <= nOffset)
+        {
+            nCur = m_aTimers[nCur].nNext;
+            nAt += m_aTimers[nCur].nDeltaTcks;
+        }
+    }
+    else
+    {
+        // Same from the tail, which expires after the offset.
+        nCur = m_nTail;
+        nAt = m_nListTcks;
+
+        while((nAt - m_aTimers[nCur].nDeltaTcks) > nOffset)
+        {
+            nAt -= m_aTimers[nCur].nDeltaTcks;
+            nCur = m_aTimers[nCur].nPrev;
+        }
+    }
+
+    // Insert before that timer and take the ticks up to the offset off its delta.
+    pTmr->nDeltaTcks = nOffset - (nAt - m_aTimers[nCur].nDeltaTcks);
+    m_aTimers[nCur].nDeltaTcks -= pTmr->nDeltaTcks;
+
+    pTmr->nNext = nCur;
+    pTmr->nPrev = m_aTimers[nCur].nPrev;
+
+    if(pTmr->nPrev == TMR_NULL_IDX)
+    {
+        m_nHead = idx;
+    }
+    else
+    {
+        m_aTimers[pTmr->nPrev].nNext = idx;
+    }
+
+    m_aTimers[nCur].nPrev = idx;
+}
+
+//***************************************************************************
+// Function Name:   _FCS_SW_TIMER_unlink
+// Returns:         void
+// Param1:          idx - Pool index of a running timer.
+// Description:     Removes a timer from the delta list. The next timer keeps its
+// expiry tick by taking over the delta.
+//***************************************************************************
+static void _FCS_SW_TIMER_unlink(uint16_t idx)
+{
+    FCS_SwTimer_t *pTmr = &m_aTimers[idx];
+
+    if(pTmr->nNext == TMR_NULL_IDX)
+    {
+        m_nTail = pTmr->nPrev;
+        m_nListTcks -= pTmr->nDeltaTcks;
+    }
+    else
+    {
+        m_aTimers[pTmr->nNext].nDeltaTcks += pTmr->nDeltaTcks;
+        m_aTimers[pTmr->nNext].nPrev = pTmr->nPrev;
+    }
+
+    if(pTmr->nPrev == TMR_NULL_IDX)
+    {
+        m_nHead = pTmr->nNext;
+    }
+    else
+    {
+        m_aTimers[pTmr->nPrev].nNext = pTmr->nNext;
+    }
+
+    pTmr->nNext = TMR_NULL_IDX;
+    pTmr->nPrev = TMR_NULL_IDX;
+    pTmr->bRunning = false;
+}
+
+//***************************************************************************
+// Function Name:   _FCS_SW_TIMER_program
+// Returns:         void
+// Param1:          void
+// Description:     Sets the service task's interval to the ticks until the head
+// timer expires. Deferred while the service task runs, which programs it once done.
+// In a cyclic executive build the frame table times the service task instead.
+//***************************************************************************
+static void _FCS_SW_TIMER_program(void)
+{
+#ifndef FCS_TASK_SCHDLR_CYCLIC_ENABLE
+    const FCS_Task_t *pSvc;
+    uint32_t nElaps;
+    uint32_t nIntvl = FCS_TASK_SCHDLR_IDLE_FOREVER;
+
+    pSvc = FCS_TASK_SCHDLR_getTaskHndl(m_hSvcTask);
+
+    if(m_bInService || (pSvc == NULL))
+    {
+        return;
+    }
+
+    if(m_nHead != TMR_NULL_IDX)
+    {
+        nElaps = FCS_TASK_SCHDLR_now() - m_nOriginTck;
+        nIntvl = (m_aTimers[m_nHead].nDeltaTcks > nElaps) ? (m_aTimers[m_nHead].nDeltaTcks - nElaps) : 0;
+    }
+
+    (void) FCS_TASK_SCHDLR_updateTaskHndl(m_hSvcTask, nIntvl, pSvc->priority);
+#endif
+}
+
+//***************************************************************************
+// Function Name:   FCS_SW_TIMER_init
+// Returns:         Success status of initialization.
+// Param1:          hSvcTask - Handle of the scheduler task running FCS_SW_TIMER_service.
+// Description:     Initializes the timer pool and stops every timer. Outstanding
+// timer handles become invalid.
+//***************************************************************************
+bool FCS_SW_TIMER_init(FCS_TaskHandle_t hSvcTask)
+{
+    uint16_t idx;
+
+    if(FCS_TASK_SCHDLR_getTaskHndl(hSvcTask) == NULL)
+    {
+        // Stale or invalid handle.
+        return false;
+    }
+
+    // Chain the pool onto the free list, lowest index first.
+    m_nFreeHead = TMR_NULL_IDX;
+
+    for(idx = FCS_SW_TIMER_MAX_TIMERS; idx > 0; idx--)
+    {
+        m_aTimers[idx - 1].pfnExpire = NULL;
+        m_aTimers[idx - 1].pArg = NULL;
+        m_aTimers[idx - 1].bRunning = false;
+        m_aTimers[idx - 1].nPrev = TMR_NULL_IDX;
+        m_aTimers[idx - 1].nNext = m_nFreeHead;
+        m_nFreeHead = idx - 1;
+
+        // Generation 0 is never used, so a handle is never 0.
+        m_aTimers[idx - 1].nGen++;
+
+        if(m_aTimers[idx - 1].nGen == 0)
+        {
+            m_aTimers[idx - 1].nGen = 1;
+        }
+    }
+
+    m_nHead = TMR_NULL_IDX;
+    m_nTail = TMR_NULL_IDX;
+    m_nOriginTck = FCS_TASK_SCHDLR_now();
+    m_nListTcks = 0;
+    m_hSvcTask = hSvcTask;
+    m_bInService = false;
+
+    _FCS_SW_TIMER_program();
+
+    return true;
+}
+
+//***************************************************************************
+// Function Name:   FCS_SW_TIMER_create
+// Returns:         Handle of the new timer or FCS_SW_TIMER_INVALID_HANDLE if the
+//                  pool is empty.
+// Param1:          pfnExpire - Called each time the timer expires.
+// Param2:          *pArg - Optional argument passed to pfnExpire.
+// Description:     Takes a stopped timer from the pool.
+//***************************************************************************
+FCS_SwTimerHandle_t FCS_SW_TIMER_create(FCS_SwTimerCb_t pfnExpire, void *pArg)
+{
+    FCS_SwTimer_t *pTmr;
+    uint16_t idx = m_nFreeHead;
+
+    if((pfnExpire == NULL) || (idx == TMR_NULL_IDX))
+    {
+        // No callback or the pool is empty.
+        return FCS_SW_TIMER_INVALID_HANDLE;
+    }
+
+    pTmr = &m_aTimers[idx];
+    m_nFreeHead = pTmr->nNext;
+
+    pTmr->pfnExpire = pfnExpire;
+    pTmr->pArg = pArg;
+    pTmr->nDeltaTcks = 0;
+    pTmr->nDelayTcks = 0;
+    pTmr->nPeriodTcks = 0;
+    pTmr->nNext = TMR_NULL_IDX;
+    pTmr->nPrev = TMR_NULL_IDX;
+    pTmr->bRunning = false;
+
+    return ((FCS_SwTimerHandle_t) pTmr->nGen << 16) | idx;
+}
+
+//***************************************************************************
+// Function Name:   FCS_SW_TIMER_destroy
+// Returns:         Success status of the removal.
+// Param1:          hTimer - Handle of the timer.
+// Description:     Stops a timer and returns it to the pool.
+//***************************************************************************
+bool FCS_SW_TIMER_destroy(FCS_SwTimerHandle_t hTimer)
+{
+    FCS_SwTimer_t *pTmr = _FCS_SW_TIMER_getTimer(hTimer);
+    uint16_t idx = (uint16_t) (hTimer & 0xFFFF);
+
+    if(pTmr == NULL)
+    {
+        // Stale or invalid handle.
+        return false;
+    }
+
+    if(pTmr->bRunning)
+    {
+        _FCS_SW_TIMER_unlink(idx);
+    }
+
+    // Invalidate outstanding handles and return the entry to the pool.
+    pTmr->pfnExpire = NULL;
+    pTmr->pArg = NULL;
+    pTmr->nGen++;
+
+    if(pTmr->nGen == 0)
+    {
+        pTmr->nGen = 1;
+    }
+
+    pTmr->nNext = m_nFreeHead;
+    m_nFreeHead = idx;
+
+    return true;
+}
+
+//***************************************************************************
+// Function Name:   FCS_SW_TIMER_start
+// Returns:         Success status of the start.
+// Param1:          hTimer - Handle of the timer.
+// Param2:          nDelayTcks - Ticks from now until the first expiry, below 2^31.
+// Param3:          nPeriodTcks - Ticks between later expiries, 0 for a one-shot timer.
+// Description:     Starts a timer, or restarts it if it is running.
+//***************************************************************************
+bool FCS_SW_TIMER_start(FCS_SwTimerHandle_t hTimer, uint32_t nDelayTcks,
+        uint32_t nPeriodTcks)
+{
+    FCS_SwTimer_t *pTmr = _FCS_SW_TIMER_getTimer(hTimer);
+    uint16_t idx = (uint16_t) (hTimer & 0xFFFF);
+    uint32_t nNow;
+
+    if(pTmr == NULL)
+    {
+        // Stale or invalid handle.
+        return false;
+    }
+
+    if(pTmr->bRunning)
+    {
+        _FCS_SW_TIMER_unlink(idx);
+    }
+
+    nNow = FCS_TASK_SCHDLR_now();
+
+    if((m_nHead == TMR_NULL_IDX) && !m_bInService)
+    {
+        // Restart the origin so offsets stay small while timers are seldom used. The
+        // service task keeps it at the expiry being run.
+        m_nOriginTck = nNow;
+    }
+
+    pTmr->nDelayTcks = nDelayTcks;
+    pTmr->nPeriodTcks = nPeriodTcks;
+    _FCS_SW_TIMER_insert(idx, (nNow - m_nOriginTck) + nDelayTcks);
+
+    if(m_nHead == idx)
+    {
+        // Expires first. Have the service task run sooner.
+        _FCS_SW_TIMER_program();
+    }
+
+    return true;
+}
+
+//***************************************************************************
+// Function Name:   FCS_SW_TIMER_restart
+// Returns:         Success status of the restart.
+// Param1:          hTimer - Handle of the timer.
+// Description:     Starts a timer again with the delay and period it was last
+// started with.
+//***************************************************************************
+bool FCS_SW_TIMER_restart(FCS_SwTimerHandle_t hTimer)
+{
+    FCS_SwTimer_t *pTmr = _FCS_SW_TIMER_getTimer(hTimer);
+
+    if(pTmr == NULL)
+    {
+        // Stale or invalid handle.
+        return false;
+    }
+
+    return FCS_SW_TIMER_start(hTimer, pTmr->nDelayTcks, pTmr->nPeriodTcks);
+}
+
+//***************************************************************************
+// Function Name:   FCS_SW_TIMER_stop
+// Returns:         Success status of the stop.
+// Param1:          hTimer - Handle of the timer.
+// Description:     Stops a timer. The service task is left to run at the tick it is
+// programmed for, where it finds nothing due and reprograms itself.
+//***************************************************************************
+bool FCS_SW_TIMER_stop(FCS_SwTimerHandle_t hTimer)
+{
+    FCS_SwTimer_t *pTmr = _FCS_SW_TIMER_getTimer(hTimer);
+
+    if(pTmr == NULL)
+    {
+        // Stale or invalid handle.
+        return false;
+    }
+
+    if(pTmr->bRunning)
+    {
+        _FCS_SW_TIMER_unlink((uint16_t) (hTimer & 0xFFFF));
+    }
+
+    return true;
+}
+
+//***************************************************************************
+// Function Name:   FCS_SW_TIMER_isRunning
+// Returns:         True if the timer is running.
+// Param1:          hTimer - Handle of the timer.
+// Description:     Checks whether a timer is waiting to expire.
+//***************************************************************************
+bool FCS_SW_TIMER_isRunning(FCS_SwTimerHandle_t hTimer)
+{
+    FCS_SwTimer_t *pTmr = _FCS_SW_TIMER_getTimer(hTimer);
+
+    return (pTmr != NULL) && pTmr->bRunning;
+}
+
+//***************************************************************************
+// Function Name:   FCS_SW_TIMER_service
+// Returns:         void
+// Param1:          *pArg - Unused.
+// Description:     Expires the timers due by the current tick. The origin moves to
+// each expiry in turn, so a periodic timer is placed a period after its expiry and
+// a timer started from a callback a delay after the current tick.
+//***************************************************************************
+void FCS_SW_TIMER_service(void *pArg)
+{
+    FCS_SwTimer_t *pTmr;
+    uint32_t nNow = FCS_TASK_SCHDLR_now();
+    uint16_t idx;
+
+    (void) pArg;
+
+    m_bInService = true;
+
+    while((m_nHead != TMR_NULL_IDX) && (m_aTimers[m_nHead].nDeltaTcks <= (nNow - m_nOriginTck)))
+    {
+        idx = m_nHead;
+        pTmr = &m_aTimers[idx];
+
+        // Move the origin to the expiry. The next timer's delta already counts from it.
+        m_nOriginTck += pTmr->nDeltaTcks;
+        m_nListTcks -= pTmr->nDeltaTcks;
+        pTmr->nDeltaTcks = 0;
+        _FCS_SW_TIMER_unlink(idx);
+
+        if(pTmr->nPeriodTcks > 0)
+        {
+            _FCS_SW_TIMER_insert(idx, pTmr->nPeriodTcks);
+        }
+
+        // The callback may stop, start or destroy any timer, this one included.
+        pTmr->pfnExpire(pTmr->pArg);
+    }
+
+    if(m_nHead != TMR_NULL_IDX)
+    {
+        // Nothing else is due. Count the deltas from the current tick.
+        m_aTimers[m_nHead].nDeltaTcks -= nNow - m_nOriginTck;
+        m_nListTcks -= nNow - m_nOriginTck;
+        m_nOriginTck = nNow;
+    }
+
+    m_bInService = false;
+
+    _FCS_SW_TIMER_program();
+}
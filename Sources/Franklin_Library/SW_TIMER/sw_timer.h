@@ -0,0 +1,144 @@
+//***********************************************************************************
+// Module Name:         sw_timer.h
+// Application:
+// Platform:            Kinetis K22 (Cortex-M4F), GNU C Compiler
+// Author(s):           Derrick Simeon
+// Notes:
+// Description:
+// One-shot and periodic software timers counted in task scheduler clock ticks. Timers
+// are taken from a fixed pool and kept in a delta list, each entry holding the ticks
+// after the entry before it expires. Passing ticks therefore only reduce the head
+// entry, however many timers are running.
+//
+// The timers are serviced by one scheduler task running FCS_SW_TIMER_service. Its
+// interval is reprogrammed to the ticks until the head timer expires, so the service
+// only runs when a timer is due and tickless mode can sleep until then. Timer
+// callbacks run from the service task, not from interrupts.
+//
+// Usage instructions:
+// Add FCS_SW_TIMER_service as a priority task (or list it in the static task table)
+// and pass its handle to FCS_SW_TIMER_init. The pool size is set with
+// FCS_SW_TIMER_MAX_TIMERS. The timer functions may be called from tasks, including
+// timer callbacks, but not from interrupts.
+// Copyright (c) 2016, Franklin Control Systems, all rights reserved
+//***********************************************************************************
+
+#ifndef SW_TIMER_H_
+#define SW_TIMER_H_
+
+//**************
+// Includes
+//**************
+
+// Standard C libraries
+#include <stdint.h>
+#include <stdbool.h>
+
+// Project-specific modules
+#include "task_schdlr.h"
+
+//**************
+// Defines
+//**************
+
+// Timers in the pool (at most 65535).
+#ifndef FCS_SW_TIMER_MAX_TIMERS
+#define FCS_SW_TIMER_MAX_TIMERS         32
+#endif
+
+// Handle value never assigned to a timer. Returned when a timer could not be created.
+#define FCS_SW_TIMER_INVALID_HANDLE     0
+
+//**************
+// Global Typedefs
+//**************
+
+// Timer handle. Pool index in the low 16 bits and the index's generation above, so a
+// handle to a destroyed timer is rejected even after its entry has been reused.
+typedef uint32_t FCS_SwTimerHandle_t;
+
+// Called when a timer expires, with the argument given at creation
+typedef void (*FCS_SwTimerCb_t)(void *pArg);
+
+//**************
+// Global Functions
+//**************
+
+//***************************************************************************
+// Function Name:   FCS_SW_TIMER_init
+// Returns:         Success status of initialization.
+// Param1:          hSvcTask - Handle of the scheduler task running FCS_SW_TIMER_service.
+// Description:     Initializes the timer pool and stops every timer. Outstanding
+// timer handles become invalid.
+//***************************************************************************
+extern bool FCS_SW_TIMER_init(FCS_TaskHandle_t hSvcTask);
+
+//***************************************************************************
+// Function Name:   FCS_SW_TIMER_create
+// Returns:         Handle of the new timer or FCS_SW_TIMER_INVALID_HANDLE if the
+//                  pool is empty.
+// Param1:          pfnExpire - Called each time the timer expires.
+// Param2:          *pArg - Optional argument passed to pfnExpire.
+// Description:     Takes a stopped timer from the pool.
+//***************************************************************************
+extern FCS_SwTimerHandle_t FCS_SW_TIMER_create(FCS_SwTimerCb_t pfnExpire, void *pArg);
+
+//***************************************************************************
+// Function Name:   FCS_SW_TIMER_destroy
+// Returns:         Success status of the removal.
+// Param1:          hTimer - Handle of the timer.
+// Description:     Stops a timer and returns it to the pool.
+//***************************************************************************
+extern bool FCS_SW_TIMER_destroy(FCS_SwTimerHandle_t hTimer);
+
+//***************************************************************************
+// Function Name:   FCS_SW_TIMER_start
+// Returns:         Success status of the start.
+// Param1:          hTimer - Handle of the timer.
+// Param2:          nDelayTcks - Ticks from now until the first expiry, below 2^31.
+// Param3:          nPeriodTcks - Ticks between later expiries, 0 for a one-shot timer.
+// Description:     Starts a timer, or restarts it if it is running. Periodic expiries
+// are counted from the previous expiry, so the timer does not drift when the service
+// task runs late; a late service runs every expiry that passed. Placing the timer
+// scans the delta list from its nearer end, so timers started with the same delay
+// queue at the tail in constant time.
+//***************************************************************************
+extern bool FCS_SW_TIMER_start(FCS_SwTimerHandle_t hTimer, uint32_t nDelayTcks,
+        uint32_t nPeriodTcks);
+
+//***************************************************************************
+// Function Name:   FCS_SW_TIMER_restart
+// Returns:         Success status of the restart.
+// Param1:          hTimer - Handle of the timer.
+// Description:     Starts a timer again with the delay and period it was last
+// started with, e.g. to push back a protocol timeout.
+//***************************************************************************
+extern bool FCS_SW_TIMER_restart(FCS_SwTimerHandle_t hTimer);
+
+//***************************************************************************
+// Function Name:   FCS_SW_TIMER_stop
+// Returns:         Success status of the stop.
+// Param1:          hTimer - Handle of the timer.
+// Description:     Stops a timer in constant time. Stopping a stopped timer succeeds.
+//***************************************************************************
+extern bool FCS_SW_TIMER_stop(FCS_SwTimerHandle_t hTimer);
+
+//***************************************************************************
+// Function Name:   FCS_SW_TIMER_isRunning
+// Returns:         True if the timer is running.
+// Param1:          hTimer - Handle of the timer.
+// Description:     Checks whether a timer is waiting to expire. A one-shot timer
+// stops before its callback runs.
+//***************************************************************************
+extern bool FCS_SW_TIMER_isRunning(FCS_SwTimerHandle_t hTimer);
+
+//***************************************************************************
+// Function Name:   FCS_SW_TIMER_service
+// Returns:         void
+// Param1:          *pArg - Unused.
+// Description:     Scheduler task that expires the due timers in order of expiry,
+// then reprograms its own interval to the next one.
+//***************************************************************************
+extern void FCS_SW_TIMER_service(void *pArg);
+
+#endif /* SW_TIMER_H_ */
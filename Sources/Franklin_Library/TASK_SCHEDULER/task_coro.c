@@ -0,0 +1,83 @@
+//***********************************************************************************
+// Module Name:         task_coro.c
+// Application:
+// Platform:            Kinetis K22 (Cortex-M4F), GNU C Compiler
+// Author(s):           Derrick Simeon
+// Notes:
+// Description:
+// Coroutine events. An event is a flag set by an interrupt or task and cleared by the
+// coroutine awaiting it; setting it signals the waiting task so the coroutine resumes
+// on the dispatcher's next loop iteration.
+// Copyright (c) 2016, Franklin Control Systems, all rights reserved
+//***********************************************************************************
+
+//**************
+// Includes
+//**************
+
+// Project-specific modules
+#include "task_coro.h"
+#include "task_schdlr_port.h"
+
+//***************************************************************************
+// Function Name:   FCS_CORO_init
+// Returns:         void
+// Param1:          *pCoro - Coroutine state.
+// Param2:          hTask - Handle of the task running the coroutine.
+// Description:     Sets a coroutine to start at the top of its body.
+//***************************************************************************
+void FCS_CORO_init(FCS_Coro_t *pCoro, FCS_TaskHandle_t hTask)
+{
+    pCoro->nLine = 0;
+    pCoro->hTask = hTask;
+    pCoro->nWaitTck = 0;
+}
+
+//***************************************************************************
+// Function Name:   FCS_CORO_initEvent
+// Returns:         void
+// Param1:          *pEvent - Event.
+// Description:     Clears an event and forgets its waiter.
+//***************************************************************************
+void FCS_CORO_initEvent(FCS_CoroEvent_t *pEvent)
+{
+    pEvent->bSet = false;
+    pEvent->hWaiter = FCS_TASK_SCHDLR_INVALID_HANDLE;
+}
+
+//***************************************************************************
+// Function Name:   FCS_CORO_setEvent
+// Returns:         void
+// Param1:          *pEvent - Event.
+// Description:     Sets an event and signals the task awaiting it.
+//***************************************************************************
+void FCS_CORO_setEvent(FCS_CoroEvent_t *pEvent)
+{
+    FCS_TaskHandle_t hWaiter;
+
+    pEvent->bSet = true;
+
+    // A stale or invalid waiter is rejected by the scheduler.
+    hWaiter = pEvent->hWaiter;
+    (void) FCS_TASK_SCHDLR_signalHndl(hWaiter);
+}
+
+//***************************************************************************
+// Function Name:   FCS_CORO_takeEvent
+// Returns:         True if the event was set.
+// Param1:          *pEvent - Event.
+// Description:     Clears an event, reporting whether it was set.
+//***************************************************************************
+bool FCS_CORO_takeEvent(FCS_CoroEvent_t *pEvent)
+{
+    uint32_t nState;
+    bool bSet;
+
+    // Test and clear together so a set from an interrupt between them is not lost.
+    nState = FCS_TASK_SCHDLR_PORT_enterCritical();
+    bSet = pEvent->bSet;
+    pEvent->bSet = false;
+    FCS_TASK_SCHDLR_PORT_exitCritical(nState);
+
+    return bSet;
+}
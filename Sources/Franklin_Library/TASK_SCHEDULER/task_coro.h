@@ -0,0 +1,174 @@
+//***********************************************************************************
+// Module Name:         task_coro.h
+// Application:
+// Platform:            Kinetis K22 (Cortex-M4F), GNU C Compiler
+// Author(s):           Derrick Simeon
+// Notes:
+// Description:
+// Stackless coroutines for scheduler tasks. A long job (a flash write, a multi-step
+// sensor init) is written as straight-line code in a task function and returns to the
+// dispatcher at each FCS_CORO_YIELD or FCS_CORO_AWAIT_xxx, resuming from that point
+// on a later run of the task. Only the resume point is kept between runs, in an
+// FCS_Coro_t, so no per-task stack is needed and a long job no longer delays other
+// tasks for its whole length.
+//
+// The resume points are case labels of a switch on the line number, so:
+// - Local variables do not keep their values across a yield or await. Keep such
+//   state in static variables or in the structure passed as the task argument.
+// - A yield or await cannot be placed inside a switch statement of the task body.
+// - Only one yield or await may be written on a source line.
+//
+// Usage instructions:
+// Call FCS_CORO_init with the handle of the task running the coroutine, e.g.
+//
+//  static FCS_Coro_t m_coro;
+//
+//  void FlashTask(void *pArg)
+//  {
+//      FCS_CORO_BEGIN(&m_coro);
+//      for(m_nPage = 0; m_nPage < PAGES; m_nPage++)
+//      {
+//          Flash_Write(m_nPage);
+//          FCS_CORO_AWAIT_UNTIL(&m_coro, Flash_Idle());
+//      }
+//      FCS_CORO_AWAIT_EVENT(&m_coro, &m_evtNext);
+//      FCS_CORO_END(&m_coro);
+//  }
+//
+// A coroutine runs as a priority or idle task, not as an Immediate task. When it
+// returns from FCS_CORO_END it starts again from the top on its next run.
+// Copyright (c) 2016, Franklin Control Systems, all rights reserved
+//***********************************************************************************
+
+#ifndef TASK_CORO_H_
+#define TASK_CORO_H_
+
+//**************
+// Includes
+//**************
+
+// Standard C libraries
+#include <stdint.h>
+#include <stdbool.h>
+
+// Project-specific modules
+#include "task_schdlr.h"
+
+//**************
+// Defines
+//**************
+
+// Marks the jump from a yield into its resume label as intended for compilers that
+// warn about switch fall-through.
+#if defined(__GNUC__) && (__GNUC__ >= 7)
+#define FCS_CORO_FALLTHROUGH            __attribute__((fallthrough))
+#else
+#define FCS_CORO_FALLTHROUGH
+#endif
+
+// Starts the coroutine body. Must be the first statement of the task function.
+#define FCS_CORO_BEGIN(pCoro)           switch((pCoro)->nLine) { case 0:
+
+// Ends the coroutine body. Must be the last statement of the task function.
+#define FCS_CORO_END(pCoro)             } (pCoro)->nLine = 0; return
+
+// Returns to the dispatcher and resumes on its next loop iteration, after waiting
+// ticks and ready tasks, through a task signal. An idle task resumes on its next
+// round-robin turn instead.
+#define FCS_CORO_YIELD(pCoro)                                                   \
+    do {                                                                        \
+        (pCoro)->nLine = __LINE__;                                              \
+        (void) FCS_TASK_SCHDLR_signalHndl((pCoro)->hTask);                      \
+        return;                                                                 \
+        case __LINE__:;                                                         \
+    } while(0)
+
+// Returns to the dispatcher until the condition is true. The condition is evaluated
+// each time the task runs, first when the await is reached.
+#define FCS_CORO_AWAIT_UNTIL(pCoro, cond)                                       \
+    do {                                                                        \
+        (pCoro)->nLine = __LINE__;                                              \
+        FCS_CORO_FALLTHROUGH;                                                   \
+        case __LINE__:                                                          \
+        if(!(cond))                                                             \
+        {                                                                       \
+            return;                                                             \
+        }                                                                       \
+    } while(0)
+
+// Returns to the dispatcher until at least nTicks scheduler ticks have passed. The
+// time is checked each time the task runs, so the coroutine resumes on the task's
+// first run after the wait ends; give the task a short interval for a fine wait.
+#define FCS_CORO_AWAIT_TICKS(pCoro, nTicks)                                     \
+    do {                                                                        \
+        (pCoro)->nWaitTck = FCS_TASK_SCHDLR_now();                              \
+        FCS_CORO_AWAIT_UNTIL((pCoro),                                           \
+                (FCS_TASK_SCHDLR_now() - (pCoro)->nWaitTck) >= (uint32_t) (nTicks)); \
+    } while(0)
+
+// Returns to the dispatcher until the event is set, then clears it. Setting the event
+// signals the coroutine's task, so it resumes without waiting for its interval.
+#define FCS_CORO_AWAIT_EVENT(pCoro, pEvent)                                     \
+    do {                                                                        \
+        (pEvent)->hWaiter = (pCoro)->hTask;                                     \
+        FCS_CORO_AWAIT_UNTIL((pCoro), FCS_CORO_takeEvent(pEvent));              \
+    } while(0)
+
+//**************
+// Global Typedefs
+//**************
+
+// Coroutine state kept between runs of its task
+typedef struct _FCS_Coro_t {
+    uint16_t            nLine;          // Line of the resume point, 0 to start at the top
+    FCS_TaskHandle_t    hTask;          // Task running the coroutine
+    uint32_t            nWaitTck;       // Tick an FCS_CORO_AWAIT_TICKS started at
+} FCS_Coro_t;
+
+// Event awaited by a coroutine. Sets before the coroutine takes it count as one.
+typedef struct _FCS_CoroEvent_t {
+    volatile bool               bSet;       // Set and not yet taken
+    volatile FCS_TaskHandle_t   hWaiter;    // Task of the last coroutine to await the event
+} FCS_CoroEvent_t;
+
+//**************
+// Global Functions
+//**************
+
+//***************************************************************************
+// Function Name:   FCS_CORO_init
+// Returns:         void
+// Param1:          *pCoro - Coroutine state.
+// Param2:          hTask - Handle of the task running the coroutine.
+// Description:     Sets a coroutine to start at the top of its body on the task's
+// next run. Also used to abandon a coroutine part way through.
+//***************************************************************************
+extern void FCS_CORO_init(FCS_Coro_t *pCoro, FCS_TaskHandle_t hTask);
+
+//***************************************************************************
+// Function Name:   FCS_CORO_initEvent
+// Returns:         void
+// Param1:          *pEvent - Event.
+// Description:     Clears an event and forgets its waiter.
+//***************************************************************************
+extern void FCS_CORO_initEvent(FCS_CoroEvent_t *pEvent);
+
+//***************************************************************************
+// Function Name:   FCS_CORO_setEvent
+// Returns:         void
+// Param1:          *pEvent - Event.
+// Description:     Sets an event and signals the task of the coroutine awaiting it.
+// Safe to call from interrupts.
+//***************************************************************************
+extern void FCS_CORO_setEvent(FCS_CoroEvent_t *pEvent);
+
+//***************************************************************************
+// Function Name:   FCS_CORO_takeEvent
+// Returns:         True if the event was set.
+// Param1:          *pEvent - Event.
+// Description:     Clears an event, reporting whether it was set. Used by
+// FCS_CORO_AWAIT_EVENT.
+//***************************************************************************
+extern bool FCS_CORO_takeEvent(FCS_CoroEvent_t *pEvent);
+
+#endif /* TASK_CORO_H_ */
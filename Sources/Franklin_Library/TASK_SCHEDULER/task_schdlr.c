@@ -9,31 +9,30 @@
 // ===========================
 // | Empty                    | <= High address
 // ===========================
-// | Empty                    |
+// | Task #5 Idle Priority    |
 // ===========================
 // | ...                      |
 // | ...                      |
 // | ...                      |
 // ===========================
-// | Empty                    |
-// ===========================
-// | Task #6 Idle Priority    |
+// | Task #4 Low Priority     |
 // ===========================
-// | Task #5 Idle Priority    |
+// | Empty                    |
 // ===========================
-// | Task #4 Low Priority     |
+// | Task #1 High Priority    |
 // ===========================
 // | Task #3 Normal Priority  |
 // ===========================
-// | Task #2 Normal Priority  |
-// ===========================
-// | Task #1 High Priority    | <= Low address
+// | Task #2 Normal Priority  | <= Low address
 // ===========================
 //
-// Reordering of priority tasks in memory is done each time a task is added or removed
-// from the task list. These tasks are arranged by descending priority starting from the
-// lowest memory address, allowing the scheduler to run without comparing each task's
-// priority level at execution time.
+// Each task occupies a fixed slot of the task list for its whole life. The slot index
+// doubles as the task's ID. Free slots are kept on a stack and the tasks of each priority
+// level are chained in a doubly linked list, in the order they were added. Adding and
+// removing a task therefore never moves task memory, and pointers into a task (such as
+// its elapsed tick counter) stay valid until the task is removed. The dispatcher walks
+// the lists from the highest priority level down, so it still runs without comparing
+// each task's priority level at execution time.
 //
 // Usage instructions:
 // The task list size should be optimized for the application by setting the define macro,
@@ -52,11 +51,88 @@
 
 // Project-specific modules
 #include "task_schdlr.h"
+#include "task_schdlr_port.h"
+#ifdef FCS_TASK_SCHDLR_CYCLIC_ENABLE
+#include "task_schdlr_frames.h"
+#endif
 
 //**************
 // Defines
 //**************
 
+#define TASK_NULL_IDX       0xFF                                    // End of an intrusive task list
+#define TASK_PRTY_LVLS      (FCS_TASKPRIORITY_Immediate + 1)        // Task lists, indexed by priority
+
+#ifdef FCS_TASK_SCHDLR_IMMEDIATE_ENABLE
+#define TASK_PRTY_MAX       FCS_TASKPRIORITY_Immediate              // Highest assignable priority
+#else
+#define TASK_PRTY_MAX       FCS_TASKPRIORITY_Critical
+#endif
+
+#if defined(FCS_TASK_SCHDLR_WHEEL_ENABLE) && defined(FCS_TASK_SCHDLR_SOA_ENABLE)
+#error "FCS_TASK_SCHDLR_SOA_ENABLE only applies to the linear dispatcher"
+#endif
+
+#if defined(FCS_TASK_SCHDLR_EDF_ENABLE) \
+        && (defined(FCS_TASK_SCHDLR_WHEEL_ENABLE) || defined(FCS_TASK_SCHDLR_SOA_ENABLE))
+#error "FCS_TASK_SCHDLR_EDF_ENABLE only applies to the linear dispatcher"
+#endif
+
+#if defined(FCS_TASK_SCHDLR_CYCLIC_ENABLE) && !defined(FCS_TASK_SCHDLR_STATIC_ENABLE)
+#error "FCS_TASK_SCHDLR_CYCLIC_ENABLE requires FCS_TASK_SCHDLR_STATIC_ENABLE"
+#endif
+
+#if defined(FCS_TASK_SCHDLR_CYCLIC_ENABLE) && (defined(FCS_TASK_SCHDLR_WHEEL_ENABLE) \
+        || defined(FCS_TASK_SCHDLR_SOA_ENABLE) || defined(FCS_TASK_SCHDLR_EDF_ENABLE))
+#error "FCS_TASK_SCHDLR_CYCLIC_ENABLE replaces the other dispatchers"
+#endif
+
+#ifdef FCS_TASK_SCHDLR_SOA_ENABLE
+#define SOA_WORDS           ((FCS_TASK_SCHDLR_MAX_TASKS + 31) / 32) // Priority mask words
+#define SOA_SLOTS           (SOA_WORDS * 32)                        // Timing array slots, padded
+#define TASK_INTVL(idx)     m_aIntvlTcks[idx]                       // Interval ticks of a task
+#define TASK_ELAPS(idx)     m_aElapsTcks[idx]                       // Elapsed ticks of a task
+#else
+#define TASK_INTVL(idx)     m_pTaskLst[idx].nIntvlTcks
+#define TASK_ELAPS(idx)     m_pTaskLst[idx].nElapsTcks
+#endif
+
+#define TASK_MASK_WORDS     ((FCS_TASK_SCHDLR_MAX_TASKS + 31) / 32) // Words of a mask with a bit per task ID
+
+#if !defined(FCS_TASK_SCHDLR_WHEEL_ENABLE) && !defined(FCS_TASK_SCHDLR_EDF_ENABLE) \
+        && !defined(FCS_TASK_SCHDLR_CYCLIC_ENABLE)
+#define RDY_QUEUE                                                   // Due tasks are queued in ready bitmaps
+#endif
+
+// Priority levels whose tasks can be signaled. Idle tasks already run whenever nothing
+// else is pending and Immediate tasks only run from the tick interrupt.
+#define SIG_LEVEL(prty)     (((prty) != FCS_TASKPRIORITY_Idle) && ((prty) != FCS_TASKPRIORITY_Immediate))
+
+#ifdef FCS_TASK_SCHDLR_STATIC_ENABLE
+#define TASK_CODE(idx)      m_aTaskDesc[idx].code                   // Code of a task
+#define TASK_ARG(idx)       m_aTaskDesc[idx].pArg                   // Argument of a task
+
+// Static task table entry. The priority level is checked at compile time.
+#define TASK_DESC(name, code, pArg, intvlTicks, priority) \
+        {{.pfnNoArg = (void (*)(void)) (code)}, (pArg), (intvlTicks), \
+                (FCS_TaskPriority_e) ((priority) + (0 * sizeof(char [((unsigned int) (priority) <= TASK_PRTY_MAX) ? 1 : -1])))},
+#else
+#define TASK_CODE(idx)      m_pTaskLst[idx].code
+#define TASK_ARG(idx)       m_pTaskLst[idx].pArg
+#endif
+
+#ifdef FCS_TASK_SCHDLR_WHEEL_ENABLE
+#define WHEEL_LVL_BITS      6                                       // Slot index bits per wheel level
+#define WHEEL_LVL_SLOTS     (1UL << WHEEL_LVL_BITS)                 // Slots per wheel level
+#define WHEEL_SLOT_MASK     (WHEEL_LVL_SLOTS - 1)                   // Slot index mask
+#define WHEEL_LVLS          4                                       // Number of wheel levels
+#define WHEEL_MAX_DELTA     ((1UL << (WHEEL_LVL_BITS * WHEEL_LVLS)) - 1)  // Wheel horizon in ticks
+
+// Priority levels released by the wheel. Idle tasks have no interval and Immediate
+// tasks are released from the tick interrupt.
+#define WHEEL_FILED(prty)   (((prty) != FCS_TASKPRIORITY_Idle) && ((prty) != FCS_TASKPRIORITY_Immediate))
+#endif
+
 //**************
 // Local Typedefs
 //**************
@@ -67,23 +143,144 @@
 
 static FCS_Task_t *m_pTaskLst = NULL;   // Active task list
 
-static uint8_t m_nClkTcks = 0;      // Elapsed clock ticks for dispatcher processing
+#ifdef FCS_TASK_SCHDLR_STATIC_ENABLE
+// Static task table, in flash
+static const FCS_TaskDesc_t m_aTaskDesc[FCS_TASK_SCHDLR_STATIC_TASKS] = {
+    FCS_TASK_SCHDLR_TASKS(TASK_DESC)
+};
+#endif
+
+// The tick counters are each written from one side only. The timer ISR advances
+// m_nTickCnt and the dispatcher catches m_nTickSeen up to a snapshot of it, so neither
+// needs a read-modify-write of a variable the other side writes.
+static volatile uint32_t m_nTickCnt = 0;    // Clock ticks counted by the timer, free-running
+static volatile uint32_t m_nTickSeen = 0;   // Clock ticks consumed by the dispatcher
+static volatile uint32_t m_nTickOvrs = 0;   // Ticks counted while the previous one was pending
+#ifdef FCS_TASK_SCHDLR_IMMEDIATE_ENABLE
+static uint32_t m_nImmTickSeen = 0;         // Clock ticks consumed by the Immediate dispatch
+#endif
 static uint8_t m_nMaxTasks = 0;     // Maximum number of tasks supported by task list
 static uint8_t m_nPrtyTasks = 0;    // Number of active priority tasks
 static uint8_t m_nIdleTasks = 0;    // Number of active idle tasks
 
+static uint8_t m_aPrtyHead[TASK_PRTY_LVLS];             // First task, per priority level
+static uint8_t m_aPrtyTail[TASK_PRTY_LVLS];             // Last task, per priority level
+static uint8_t m_nIdleNext = TASK_NULL_IDX;             // Next idle task to run, round-robin
+
+#ifdef FCS_TASK_SCHDLR_IDLE_BUDGET_ENABLE
+static uint32_t m_nIdleStartCyc = 0;                    // Cycle count the running idle task started at
+static uint32_t m_nIdleBudgetCyc = 0;                   // Cycle budget of the running idle task
+#endif
+
+// Signals are set from interrupts and taken by the dispatcher, each inside a critical
+// section. A level's bit may stay set after its tasks' signals were cleared.
+static volatile uint32_t m_nSigLvls = 0;                        // Levels with signaled tasks, one bit each
+static volatile uint32_t m_aSigMask[TASK_PRTY_LVLS][TASK_MASK_WORDS]; // Signaled tasks, per priority level
+
+#ifdef RDY_QUEUE
+// A level's bit is set exactly while it has ready tasks.
+static uint32_t m_nRdyLvls = 0;                                 // Levels with ready tasks, one bit each
+static uint32_t m_aRdyMask[TASK_PRTY_LVLS][TASK_MASK_WORDS];    // Released tasks, per priority level
+#endif
+
+static uint8_t m_aTaskGen[FCS_TASK_SCHDLR_MAX_TASKS];   // Handle generation, per task ID
+static uint8_t m_aFreeIds[FCS_TASK_SCHDLR_MAX_TASKS];   // Stack of unassigned task IDs
+static uint8_t m_nFreeIds = 0;                          // Number of unassigned task IDs
+
+#ifndef FCS_TASK_SCHDLR_PROFILE_DISABLE
+static FCS_TaskProfile_t m_aProf[FCS_TASK_SCHDLR_MAX_TASKS];  // Execution time profile, per task ID
+#endif
+
+#ifdef FCS_TASK_SCHDLR_SOA_ENABLE
+static uint32_t m_aIntvlTcks[SOA_SLOTS];                    // Interval ticks, per task ID
+static uint32_t m_aElapsTcks[SOA_SLOTS];                    // Elapsed ticks, per task ID
+static uint32_t m_aPrtyMask[TASK_PRTY_LVLS][SOA_WORDS];     // Linked tasks, per priority level
+static uint16_t m_nSoaSlots = 0;                            // Highest task ID assigned + 1
+#endif
+
+#ifdef FCS_TASK_SCHDLR_WHEEL_ENABLE
+static uint32_t m_nWheelTck = 0;                            // Ticks processed by the wheel
+static uint8_t m_aWheel[WHEEL_LVLS][WHEEL_LVL_SLOTS];       // Slot list heads, per level
+static uint8_t m_aRdyHead[TASK_PRTY_LVLS];                  // Expired task list heads, per priority
+static uint8_t m_aRdyTail[TASK_PRTY_LVLS];                  // Expired task list tails, per priority
+#endif
+
+#ifdef FCS_TASK_SCHDLR_EDF_ENABLE
+static uint8_t m_aEdfHeap[FCS_TASK_SCHDLR_MAX_TASKS];       // Released tasks, min-heap on deadline
+static uint8_t m_nEdfCnt = 0;                               // Number of released tasks
+#endif
+
+#ifdef FCS_TASK_SCHDLR_CYCLIC_ENABLE
+static const uint8_t m_aFrmTasks[] = {FCS_TASK_SCHDLR_FRAME_TASKS};     // Task IDs run by each frame
+static const uint16_t m_aFrmStart[FCS_TASK_SCHDLR_FRAMES + 1] = {FCS_TASK_SCHDLR_FRAME_START};  // First entry, per frame
+static uint16_t m_nFrmIdx = 0;                              // Frame started last
+static uint32_t m_nFrmElaps = 0;                            // Ticks since the last frame started
+static uint32_t m_nFrmTck = 0;                              // Tick the frame being run started at
+#endif
+
+#ifdef FCS_TASK_SCHDLR_TICKLESS_ENABLE
+static void (*m_pfnSetTickSpan)(uint32_t nTicks) = NULL;    // Tick timer reprogramming callback
+static bool m_bTickSpanStale = true;                        // Tick span needs to be recomputed
+#endif
+
+#ifndef FCS_TASK_SCHDLR_STATIC_ENABLE
+static bool m_bAutoStagger = false;     // Stagger the phase of each task added
+#endif
+
+#ifndef FCS_TASK_SCHDLR_CYCLIC_ENABLE
+static uint32_t m_aStaggerLoad[FCS_TASK_SCHDLR_STAGGER_SPAN];  // Runtime sharing each offset, while staggering
+#endif
+
+// Timing fault policy callback
+static FCS_TaskFaultAction_e (*m_pfnFaultPolicy)(FCS_TaskHandle_t hTask, FCS_TaskFault_e fault,
+        uint32_t nTicks) = NULL;
+
 #ifdef _DEBUG_ENABLE
 static void (*m_pfnTimingStart)(void) = NULL;
 static void (*m_pfnTimingStop)(void) = NULL;
 #endif
 
+#ifdef FCS_TASK_SCHDLR_WATCHDOG_ENABLE
+static void (*m_pfnWdogRefresh)(void) = NULL;           // Watchdog refresh callback
+static uint32_t m_nWdogPeriodTcks = 1;                  // Ticks between heartbeat checks
+static uint32_t m_nWdogTck = 0;                         // Tick count at the last heartbeat check
+static bool m_bWdogLapsed = false;                      // A task starved, refreshes stopped
+static volatile uint8_t m_nRunIdx = TASK_NULL_IDX;      // Task being run by the dispatcher
+static volatile uint32_t m_nRunTck = 0;                 // Tick count the running task started at
+
+// Reset cause, in RAM the startup code does not initialize
+static FCS_TaskWdogRecord_t m_wdogRec __attribute__((section(".noinit")));
+static uint32_t m_nWdogRecChk __attribute__((section(".noinit")));     // Check word of m_wdogRec
+#endif
+
+#ifdef FCS_TASK_SCHDLR_SLEEP_ENABLE
+static uint32_t (*m_pfnSleep)(uint8_t nMode, uint32_t nTicks) = NULL;  // Sleep callback
+static uint8_t m_nSleepModes = 0;                                       // Modes offered by it
+static FCS_TaskSleepStats_t m_aSleepStats[FCS_TASK_SCHDLR_SLEEP_MODES]; // Statistics per mode
+#endif
+
+#ifdef FCS_TASK_SCHDLR_LOAD_ENABLE
+static bool m_bLoadBusy = false;                        // A busy span is open
+static uint32_t m_nLoadStartCyc = 0;                    // Cycle count the open busy span started at
+static uint32_t m_nLoadSpanCyc = 0;                     // Busy cycles of closed spans since the last tick
+static uint32_t m_nLoadIdleCyc = 0;                     // Idle task cycles since the last tick
+static uint32_t m_nLoadSecCyc = 0;                      // Busy cycles of the second being counted
+static uint32_t m_nLoadSecIdleCyc = 0;                  // Idle task cycles of the second being counted
+static uint32_t m_nLoadSecTcks = 0;                     // Ticks of the second being counted
+static uint32_t m_nLoadPeakCyc = 0;                     // Busy cycles of the busiest tick
+static uint16_t m_aLoadSecs[FCS_TASK_SCHDLR_LOAD_SECS]; // Load of the last seconds, oldest overwritten
+static uint16_t m_aLoadIdleSecs[FCS_TASK_SCHDLR_LOAD_SECS]; // Idle task load of the same seconds
+static uint8_t m_nLoadSecNext = 0;                      // Slot of the next second
+static uint8_t m_nLoadSecCnt = 0;                       // Seconds counted, up to FCS_TASK_SCHDLR_LOAD_SECS
+#endif
+
 //**************
 // Global Variables
 //**************
 // Get array size.
 #define ARRAY_COUNT(array)          (sizeof(array) / sizeof((array)[0]))
 // Main system task list
-static FCS_Task_t _m_taskLst[64];
+static FCS_Task_t _m_taskLst[FCS_TASK_SCHDLR_MAX_TASKS];
 
 
 void Scheduler_Init()
@@ -96,8 +293,86 @@ void Scheduler_Init()
 //**************
 
 static void _FCS_TASK_SCHDLR_initTask(FCS_Task_t *pTask);
+static uint32_t _FCS_TASK_SCHDLR_takeTicks(void);
+#ifndef FCS_TASK_SCHDLR_STATIC_ENABLE
 static bool _FCS_TASK_SCHDLR_validateArguments(FCS_TaskCode_t taskCode, void *pTaskArg);
 static FCS_Task_t *_FCS_TASK_SCHDLR_getTask(FCS_TaskCode_t taskCode, void *pTaskArg);
+#endif
+static FCS_Task_t *_FCS_TASK_SCHDLR_getTaskHndl(FCS_TaskHandle_t hTask);
+static void _FCS_TASK_SCHDLR_prtyLink(uint8_t idx);
+static void _FCS_TASK_SCHDLR_prtyUnlink(uint8_t idx);
+static void _FCS_TASK_SCHDLR_linkTask(uint8_t id, uint32_t intvlTicks, FCS_TaskPriority_e priority);
+static bool _FCS_TASK_SCHDLR_removeTask(FCS_Task_t *pTask);
+static bool _FCS_TASK_SCHDLR_updateTask(FCS_Task_t *pTask, uint32_t intvlTicks,
+        FCS_TaskPriority_e priority);
+#ifndef FCS_TASK_SCHDLR_CYCLIC_ENABLE
+static uint32_t _FCS_TASK_SCHDLR_releaseIn(uint8_t idx);
+static void _FCS_TASK_SCHDLR_setReleaseIn(FCS_Task_t *pTask, uint32_t nTicks);
+static uint32_t _FCS_TASK_SCHDLR_gcd(uint32_t a, uint32_t b);
+static void _FCS_TASK_SCHDLR_stagger(FCS_Task_t *pTask);
+#endif
+static void _FCS_TASK_SCHDLR_sigSet(uint8_t idx);
+static void _FCS_TASK_SCHDLR_sigRefile(uint8_t idx, bool bKeep);
+static uint8_t _FCS_TASK_SCHDLR_sigTake(void);
+static void _FCS_TASK_SCHDLR_runTask(FCS_Task_t *pTask, uint32_t nLateTcks);
+static void _FCS_TASK_SCHDLR_checkFaults(FCS_Task_t *pTask, uint8_t nGen, uint32_t nLateTcks,
+        uint32_t nRunTcks, uint32_t nIntvl);
+static void _FCS_TASK_SCHDLR_faultPolicy(FCS_Task_t *pTask, FCS_TaskFault_e fault, uint32_t nTicks);
+#ifndef FCS_TASK_SCHDLR_PROFILE_DISABLE
+static void _FCS_TASK_SCHDLR_profClear(uint8_t idx);
+static uint32_t _FCS_TASK_SCHDLR_profStart(uint8_t idx);
+static void _FCS_TASK_SCHDLR_profStop(uint8_t idx, uint8_t nGen, uint32_t nStartCyc);
+#endif
+#ifdef FCS_TASK_SCHDLR_WATCHDOG_ENABLE
+static uint32_t _FCS_TASK_SCHDLR_wdogRecChk(void);
+static void _FCS_TASK_SCHDLR_wdogRecord(FCS_TaskWdogCause_e cause, uint8_t idx, uint32_t nTicks);
+static void _FCS_TASK_SCHDLR_wdogSupervise(void);
+#endif
+#ifdef FCS_TASK_SCHDLR_SLEEP_ENABLE
+static void _FCS_TASK_SCHDLR_sleep(void);
+#endif
+#ifdef FCS_TASK_SCHDLR_LOAD_ENABLE
+static void _FCS_TASK_SCHDLR_loadTick(uint32_t nTicks);
+static void _FCS_TASK_SCHDLR_loadSecond(void);
+static uint32_t _FCS_TASK_SCHDLR_loadShare(uint32_t *pnCyc, uint32_t nSecs);
+#endif
+#if !defined(FCS_TASK_SCHDLR_WHEEL_ENABLE) && !defined(FCS_TASK_SCHDLR_CYCLIC_ENABLE)
+static void _FCS_TASK_SCHDLR_dispatchTask(uint8_t idx);
+#endif
+#ifdef RDY_QUEUE
+static void _FCS_TASK_SCHDLR_rdyClear(uint8_t idx);
+static uint8_t _FCS_TASK_SCHDLR_rdyTake(void);
+#endif
+#ifdef FCS_TASK_SCHDLR_SOA_ENABLE
+static void _FCS_TASK_SCHDLR_soaAdvance(uint32_t ticks);
+#elif defined(RDY_QUEUE)
+static void _FCS_TASK_SCHDLR_rdyAdvance(uint32_t ticks);
+#endif
+#ifdef FCS_TASK_SCHDLR_WHEEL_ENABLE
+static uint32_t _FCS_TASK_SCHDLR_wheelIntvl(const FCS_Task_t *pTask);
+static void _FCS_TASK_SCHDLR_wheelInsert(uint8_t idx);
+static void _FCS_TASK_SCHDLR_wheelUnlink(uint8_t idx);
+static void _FCS_TASK_SCHDLR_wheelQueueReady(uint8_t idx);
+static void _FCS_TASK_SCHDLR_wheelInit(void);
+static void _FCS_TASK_SCHDLR_wheelAdvance(uint32_t ticks);
+static void _FCS_TASK_SCHDLR_wheelDispatch(uint8_t idx);
+static bool _FCS_TASK_SCHDLR_wheelHasReady(void);
+static void _FCS_TASK_SCHDLR_wheelRunNext(void);
+static uint32_t _FCS_TASK_SCHDLR_wheelIdleTicks(void);
+#endif
+#ifdef FCS_TASK_SCHDLR_EDF_ENABLE
+static bool _FCS_TASK_SCHDLR_edfBefore(uint8_t idxA, uint8_t idxB);
+static void _FCS_TASK_SCHDLR_edfPlace(uint8_t pos, uint8_t idx);
+static void _FCS_TASK_SCHDLR_edfSift(uint8_t pos);
+static void _FCS_TASK_SCHDLR_edfPush(uint8_t idx);
+static void _FCS_TASK_SCHDLR_edfUnlink(uint8_t idx);
+static void _FCS_TASK_SCHDLR_edfAdvance(uint32_t ticks);
+static void _FCS_TASK_SCHDLR_edfDispatch(void);
+#endif
+#ifdef FCS_TASK_SCHDLR_CYCLIC_ENABLE
+static void _FCS_TASK_SCHDLR_cycAdvance(uint32_t ticks);
+static void _FCS_TASK_SCHDLR_cycDispatch(uint32_t nLateTcks);
+#endif
 
 //***************************************************************************
 // Function Name:   _FCS_TASK_SCHDLR_initTask
@@ -107,13 +382,62 @@ static FCS_Task_t *_FCS_TASK_SCHDLR_getTask(FCS_TaskCode_t taskCode, void *pTask
 //***************************************************************************
 static void _FCS_TASK_SCHDLR_initTask(FCS_Task_t *pTask)
 {
+#ifndef FCS_TASK_SCHDLR_STATIC_ENABLE
     pTask->code.pfnNoArg = NULL;
     pTask->pArg = NULL;
+#endif
     pTask->priority = FCS_TASKPRIORITY_Idle;
     pTask->nIntvlTcks = 0;
     pTask->nElapsTcks = 0;
+    pTask->release = FCS_TASKRELEASE_Relative;
+    pTask->nMissCnt = 0;
+    pTask->bOverrun = false;
+    pTask->nLateLimTcks = 0;
+    pTask->nLateCnt = 0;
+    pTask->nOvrnCnt = 0;
+#ifdef FCS_TASK_SCHDLR_IDLE_BUDGET_ENABLE
+    pTask->nBudgetCyc = 0;
+#endif
+    pTask->nPrtyNext = TASK_NULL_IDX;
+    pTask->nPrtyPrev = TASK_NULL_IDX;
+#ifdef FCS_TASK_SCHDLR_WHEEL_ENABLE
+    pTask->nWheelNext = TASK_NULL_IDX;
+    pTask->nWheelPrev = TASK_NULL_IDX;
+    pTask->pWheelList = NULL;
+#endif
+#ifdef FCS_TASK_SCHDLR_EDF_ENABLE
+    pTask->nDlTcks = 0;
+    pTask->nAbsDlTck = 0;
+    pTask->nHeapPos = TASK_NULL_IDX;
+#endif
+#ifdef FCS_TASK_SCHDLR_CYCLIC_ENABLE
+    pTask->nFrmTck = 0;
+#endif
+#ifdef FCS_TASK_SCHDLR_WATCHDOG_ENABLE
+    pTask->nHbWinTcks = 0;
+    pTask->nHbTck = 0;
+    pTask->bHbManual = false;
+#endif
+}
+
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_takeTicks
+// Returns:         Clock ticks counted since the last call.
+// Param1:          void
+// Description:     Consumes the pending clock ticks. The tick counter is read once,
+// so ticks counted while this runs stay pending for the next call.
+//***************************************************************************
+static uint32_t _FCS_TASK_SCHDLR_takeTicks(void)
+{
+    uint32_t nSnap = m_nTickCnt;
+    uint32_t nTicks = nSnap - m_nTickSeen;
+
+    m_nTickSeen = nSnap;
+
+    return nTicks;
 }
 
+#ifndef FCS_TASK_SCHDLR_STATIC_ENABLE
 //***************************************************************************
 // Function Name:   _FCS_TASK_SCHDLR_validateArguments
 // Returns:         void
@@ -142,6 +466,7 @@ static bool _FCS_TASK_SCHDLR_validateArguments(FCS_TaskCode_t taskCode, void *pT
 static FCS_Task_t *_FCS_TASK_SCHDLR_getTask(FCS_TaskCode_t taskCode, void *pTaskArg)
 {
     FCS_Task_t *pTask;
+    uint8_t prty;
     uint8_t idx;
 
     if(!_FCS_TASK_SCHDLR_validateArguments(taskCode, pTaskArg))
@@ -154,36 +479,40 @@ static FCS_Task_t *_FCS_TASK_SCHDLR_getTask(FCS_TaskCode_t taskCode, void *pTask
         // Initialize task as not yet found.
         pTask = NULL;
 
-        // Search the task list.
-        for(idx = 0; (idx < (m_nPrtyTasks + m_nIdleTasks)) && (pTask == NULL); idx++)
+        // Search the task lists of every priority level.
+        for(prty = 0; (prty < TASK_PRTY_LVLS) && (pTask == NULL); prty++)
         {
-            if(pTaskArg == NULL)
-            {
-                // No task argument.
-                if(m_pTaskLst[idx].code.pfnNoArg == taskCode.pfnNoArg)
-                {
-                    // Task found in the current task list.
-                    pTask = &m_pTaskLst[idx];
-                }
-                else
-                {
-                    // Task not found.
-                    (void) 0;
-                }
-            }
-            else
+            for(idx = m_aPrtyHead[prty]; (idx != TASK_NULL_IDX) && (pTask == NULL);
+                    idx = m_pTaskLst[idx].nPrtyNext)
             {
-                // Task has argument.
-                if((m_pTaskLst[idx].code.pfnHasArg == taskCode.pfnHasArg)
-                        && (m_pTaskLst[idx].pArg == pTaskArg))
+                if(pTaskArg == NULL)
                 {
-                    // Task found in the current task list.
-                    pTask = &m_pTaskLst[idx];
+                    // No task argument.
+                    if(m_pTaskLst[idx].code.pfnNoArg == taskCode.pfnNoArg)
+                    {
+                        // Task found in the current task list.
+                        pTask = &m_pTaskLst[idx];
+                    }
+                    else
+                    {
+                        // Task not found.
+                        (void) 0;
+                    }
                 }
                 else
                 {
-                    // Task not found.
-                    (void) 0;
+                    // Task has argument.
+                    if((m_pTaskLst[idx].code.pfnHasArg == taskCode.pfnHasArg)
+                            && (m_pTaskLst[idx].pArg == pTaskArg))
+                    {
+                        // Task found in the current task list.
+                        pTask = &m_pTaskLst[idx];
+                    }
+                    else
+                    {
+                        // Task not found.
+                        (void) 0;
+                    }
                 }
             }
         }
@@ -191,262 +520,3291 @@ static FCS_Task_t *_FCS_TASK_SCHDLR_getTask(FCS_TaskCode_t taskCode, void *pTask
 
     return pTask;
 }
-
-//**************
-// Global Functions
-//**************
+#endif
 
 //***************************************************************************
-// Function Name:   FCS_TASK_SCHDLR_init
-// Returns:         void
-// Param1:          *pTaskLst - Task list (array) to operate on.
-// Param2:          maxTaskCnt - Max amount of tasks supported by task list.
-// Description:     Initializes the scheduler and task list.
+// Function Name:   _FCS_TASK_SCHDLR_getTaskHndl
+// Returns:         Pointer to the task or NULL if the handle is stale.
+// Param1:          hTask - Task handle.
+// Description:     Resolves a handle to its task slot in constant time.
 //***************************************************************************
-void FCS_TASK_SCHDLR_init(FCS_Task_t *pTaskLst, uint8_t nMaxTasks)
+static FCS_Task_t *_FCS_TASK_SCHDLR_getTaskHndl(FCS_TaskHandle_t hTask)
 {
-    uint8_t idx;
+    FCS_TaskID_t id = (FCS_TaskID_t) (hTask & 0xFF);
 
-    // Initialize scheduler.
-    m_nClkTcks = 0;
-    m_nMaxTasks = nMaxTasks;
-    m_nPrtyTasks = 0;
-    m_nIdleTasks = 0;
-    m_pTaskLst = pTaskLst;
-
-    // Initialize task list.
-    for(idx = 0; idx < m_nMaxTasks; idx++)
+    if((id >= m_nMaxTasks) || (m_aTaskGen[id] != (uint8_t) (hTask >> 8))
+            || (TASK_CODE(id).pfnNoArg == NULL))
     {
-        _FCS_TASK_SCHDLR_initTask(&m_pTaskLst[idx]);
+        // Unknown ID, unused slot or the task was removed since the handle was issued.
+        return NULL;
     }
 
-#ifdef _DEBUG_ENABLE
-    m_pfnTimingStart = NULL;
-    m_pfnTimingStop = NULL;
-#endif
+    return &m_pTaskLst[id];
 }
 
 //***************************************************************************
-// Function Name:   FCS_TASK_SCHDLR_clockTick
+// Function Name:   _FCS_TASK_SCHDLR_prtyLink
 // Returns:         void
-// Param1:          void
-// Description:     Increments the scheduler's clock tick counter. A hardware
-// timer is required to call this function at the desired tick frequency.
+// Param1:          idx - Slot of the task to link.
+// Description:     Appends a task to the list of its priority level.
 //***************************************************************************
-void FCS_TASK_SCHDLR_clockTick(void)
+static void _FCS_TASK_SCHDLR_prtyLink(uint8_t idx)
 {
-    // Increment the clock tick counter.
-    m_nClkTcks++;
+    FCS_TaskPriority_e priority = m_pTaskLst[idx].priority;
+
+#ifdef FCS_TASK_SCHDLR_IMMEDIATE_ENABLE
+    if((priority == FCS_TASKPRIORITY_Immediate) && (m_aPrtyHead[priority] == TASK_NULL_IDX))
+    {
+        // The Immediate dispatch is not pended while there are no Immediate tasks.
+        // Skip the ticks it did not take.
+        m_nImmTickSeen = m_nTickCnt;
+    }
+#endif
+
+    m_pTaskLst[idx].nPrtyNext = TASK_NULL_IDX;
+    m_pTaskLst[idx].nPrtyPrev = m_aPrtyTail[priority];
+
+    if(m_aPrtyTail[priority] == TASK_NULL_IDX)
+    {
+        m_aPrtyHead[priority] = idx;
+    }
+    else
+    {
+        m_pTaskLst[m_aPrtyTail[priority]].nPrtyNext = idx;
+    }
+
+    m_aPrtyTail[priority] = idx;
+
+#ifdef FCS_TASK_SCHDLR_SOA_ENABLE
+    m_aPrtyMask[priority][idx >> 5] |= (1UL << (idx & 31));
+#endif
+
+    // Update task count.
+    if(priority == FCS_TASKPRIORITY_Idle)
+    {
+        m_nIdleTasks++;
+    }
+    else
+    {
+        m_nPrtyTasks++;
+    }
 }
 
 //***************************************************************************
-// Function Name:   FCS_TASK_SCHDLR_addTask
-// Returns:         Success status of task addition.
-// Param1:          taskCode - Points to task's executable code.
-// Param2:          *pTaskArg - Optional argument passed to task's code.
-// Param3:          intvlTicks - Dispatch interval.
-// Param4:          priority - Priority level.
-// Description:     Adds a new task to the task list. The function call
-// representing the task's executable code will be called with the optional
-// argument if one is provided.
+// Function Name:   _FCS_TASK_SCHDLR_prtyUnlink
+// Returns:         void
+// Param1:          idx - Slot of the task to unlink.
+// Description:     Removes a task from the list of its priority level. If the
+// dispatcher was about to continue with this task, it continues with the next one.
 //***************************************************************************
-bool FCS_TASK_SCHDLR_addTask(FCS_TaskCode_t taskCode, void *pTaskArg,
-        uint32_t intvlTicks, FCS_TaskPriority_e priority)
+static void _FCS_TASK_SCHDLR_prtyUnlink(uint8_t idx)
 {
-    FCS_Task_t *pTask;
-    FCS_Task_t tempTask;
-    uint32_t nTempTicks;
-    uint8_t idx;
+    FCS_Task_t *pTask = &m_pTaskLst[idx];
 
-    if(!_FCS_TASK_SCHDLR_validateArguments(taskCode, pTaskArg))
+    if(m_nIdleNext == idx)
     {
-        // Invalid arguments.
-        return false;
+        m_nIdleNext = pTask->nPrtyNext;
     }
 
-    // Search for existing task with same code and argument.
-    if(_FCS_TASK_SCHDLR_getTask(taskCode, pTaskArg) != NULL)
+    if(pTask->nPrtyPrev == TASK_NULL_IDX)
     {
-        // Task already exists.
-        return false;
+        m_aPrtyHead[pTask->priority] = pTask->nPrtyNext;
     }
-
-    // Check if task list is already full.
-    if((m_nPrtyTasks + m_nIdleTasks) >= m_nMaxTasks)
+    else
     {
-        // Task list is full. Failed to add new task.
-        return false;
+        m_pTaskLst[pTask->nPrtyPrev].nPrtyNext = pTask->nPrtyNext;
     }
 
-    // Update existing priority tasks' elapsed times before adding the new task.
-    if(m_nClkTcks > 0)
+    if(pTask->nPrtyNext == TASK_NULL_IDX)
     {
-        // Save tick count so each task is processed the same.
-        nTempTicks = m_nClkTcks;
-        m_nClkTcks -= nTempTicks;
-
-        for(idx = 0; idx < m_nPrtyTasks; idx++)
-        {
-            // Calculate task's elapsed time.
-            m_pTaskLst[idx].nElapsTcks += nTempTicks;
-        }
+        m_aPrtyTail[pTask->priority] = pTask->nPrtyPrev;
+    }
+    else
+    {
+        m_pTaskLst[pTask->nPrtyNext].nPrtyPrev = pTask->nPrtyPrev;
     }
 
-    // Get next available task structure in the task list.
-    pTask = &m_pTaskLst[m_nPrtyTasks + m_nIdleTasks];
+    pTask->nPrtyNext = TASK_NULL_IDX;
+    pTask->nPrtyPrev = TASK_NULL_IDX;
 
-    // Update task count.
-    switch(priority)
-    {
-        case FCS_TASKPRIORITY_Idle:
-            m_nIdleTasks++;
-            break;
+#ifdef FCS_TASK_SCHDLR_SOA_ENABLE
+    m_aPrtyMask[pTask->priority][idx >> 5] &= ~(1UL << (idx & 31));
+#endif
 
-        case FCS_TASKPRIORITY_Low:
-        case FCS_TASKPRIORITY_Normal:
-        case FCS_TASKPRIORITY_High:
-        case FCS_TASKPRIORITY_Critical:
-            m_nPrtyTasks++;
-            break;
+#ifdef RDY_QUEUE
+    // A task leaving its level is not dispatched from the level's ready bitmap.
+    _FCS_TASK_SCHDLR_rdyClear(idx);
+#endif
 
-        default:
-            // Unexpected priority assignment.
-            return false;
+    // Update task count.
+    if(pTask->priority == FCS_TASKPRIORITY_Idle)
+    {
+        m_nIdleTasks--;
+    }
+    else
+    {
+        m_nPrtyTasks--;
     }
+}
+
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_linkTask
+// Returns:         void
+// Param1:          id - ID of a task whose code is set.
+// Param2:          intvlTicks - Dispatch interval.
+// Param3:          priority - Priority level.
+// Description:     Starts a task's timing and queues it behind the tasks of the same
+// priority level. Immediate tasks become visible to the tick interrupt here, once
+// fully set up.
+//***************************************************************************
+static void _FCS_TASK_SCHDLR_linkTask(uint8_t id, uint32_t intvlTicks, FCS_TaskPriority_e priority)
+{
+    FCS_Task_t *pTask = &m_pTaskLst[id];
+#ifdef FCS_TASK_SCHDLR_IMMEDIATE_ENABLE
+    uint32_t nLock;
+#endif
 
-    // Timed tasks are added going from lowest to highest index in the tasks array.
-    pTask->code = taskCode;
-    pTask->pArg = pTaskArg;
     pTask->nIntvlTcks = intvlTicks;
     pTask->nElapsTcks = 0;
     pTask->priority = priority;
 
-    // Reorganize tasks. Start from high address and work to low address.
-    for((void) 0; (pTask > m_pTaskLst) && (pTask->priority > (pTask - 1)->priority); pTask--)
+#ifndef FCS_TASK_SCHDLR_PROFILE_DISABLE
+    _FCS_TASK_SCHDLR_profClear(id);
+#endif
+
+    // A new task starts without signals.
+    _FCS_TASK_SCHDLR_sigRefile(id, false);
+
+#ifdef FCS_TASK_SCHDLR_SOA_ENABLE
+    m_aIntvlTcks[id] = intvlTicks;
+    m_aElapsTcks[id] = 0;
+
+    if(id >= m_nSoaSlots)
     {
-        // This task has higher priority. Swap their positions.
-        tempTask = *pTask;
-        *pTask = *(pTask - 1);
-        *(pTask - 1) = tempTask;
+        // Extend the tick pass over the new ID.
+        m_nSoaSlots = (uint16_t) id + 1;
+    }
+#endif
 
-        // If elapsed tick counter was previously used as either task's argument, preserve it.
-        if(pTask->pArg == &(pTask - 1)->nElapsTcks)
-        {
-            pTask->pArg = &pTask->nElapsTcks;
-        }
+#ifdef FCS_TASK_SCHDLR_IMMEDIATE_ENABLE
+    nLock = FCS_TASK_SCHDLR_lockImmediate();
+    _FCS_TASK_SCHDLR_prtyLink(id);
+    FCS_TASK_SCHDLR_unlockImmediate(nLock);
+#else
+    _FCS_TASK_SCHDLR_prtyLink(id);
+#endif
 
-        if((pTask - 1)->pArg == &pTask->nElapsTcks)
-        {
-            (pTask - 1)->pArg = &(pTask - 1)->nElapsTcks;
-        }
+#ifdef FCS_TASK_SCHDLR_WHEEL_ENABLE
+    if(WHEEL_FILED(priority))
+    {
+        pTask->nRlsTck = m_nWheelTck + _FCS_TASK_SCHDLR_wheelIntvl(pTask);
+        _FCS_TASK_SCHDLR_wheelInsert(id);
     }
+#endif
 
-    // Task successfully added.
-    return true;
+#ifdef FCS_TASK_SCHDLR_TICKLESS_ENABLE
+    m_bTickSpanStale = true;
+#endif
 }
 
 //***************************************************************************
-// Function Name:   FCS_TASK_SCHDLR_removeTask
+// Function Name:   _FCS_TASK_SCHDLR_removeTask
 // Returns:         Success status of task removal.
-// Param1:          task - Task to remove.
-// Description:     Removes a task from the task list.
+// Param1:          *pTask - Task to remove.
+// Description:     Removes a task from the task list and retires its ID's handle.
 //***************************************************************************
-bool FCS_TASK_SCHDLR_removeTask(FCS_Task_t task)
+static bool _FCS_TASK_SCHDLR_removeTask(FCS_Task_t *pTask)
 {
-    FCS_Task_t *pTask;
-
-    // Search for task in the task list.
-    pTask = _FCS_TASK_SCHDLR_getTask(task.code, task.pArg);
-
-    if(pTask == NULL)
-    {
-        // Task not found.
-        return false;
-    }
+    FCS_TaskID_t id = pTask->id;
+#ifdef FCS_TASK_SCHDLR_IMMEDIATE_ENABLE
+    uint32_t nLock = FCS_TASK_SCHDLR_lockImmediate();
+#endif
 
-    // Update task count.
-    switch(pTask->priority)
-    {
-        case FCS_TASKPRIORITY_Idle:
-            m_nIdleTasks--;
-            break;
+    _FCS_TASK_SCHDLR_prtyUnlink(id);
 
-        case FCS_TASKPRIORITY_Low:
-        case FCS_TASKPRIORITY_Normal:
-        case FCS_TASKPRIORITY_High:
-        case FCS_TASKPRIORITY_Critical:
-            m_nPrtyTasks--;
-            break;
+#ifdef FCS_TASK_SCHDLR_WHEEL_ENABLE
+    _FCS_TASK_SCHDLR_wheelUnlink(id);
+#endif
 
-        default:
-            // Unexpected priority assignment.
-            return false;
-    }
+#ifdef FCS_TASK_SCHDLR_EDF_ENABLE
+    _FCS_TASK_SCHDLR_edfUnlink(id);
+#endif
 
     // Remove task by initializing the structure.
     _FCS_TASK_SCHDLR_initTask(pTask);
 
-    // Shift the task list if necessary.
-    for((void) 0; pTask < &m_pTaskLst[m_nPrtyTasks + m_nIdleTasks]; pTask++)
-    {
-        // Shift task down.
-        *pTask = *(pTask + 1);
+    // Invalidate outstanding handles and release the slot. Generation 0 is never used.
+    m_aTaskGen[id]++;
 
-        // If elapsed tick counter was previously used as the task's argument, preserve it.
-        if(pTask->pArg == &(pTask + 1)->nElapsTcks)
-        {
-            pTask->pArg = &pTask->nElapsTcks;
-        }
+    if(m_aTaskGen[id] == 0)
+    {
+        m_aTaskGen[id] = 1;
     }
 
-    // Task successfully removed.
+    // Drop a pending signal. None can be set once the handle is retired.
+    _FCS_TASK_SCHDLR_sigRefile(id, false);
+
+    m_aFreeIds[m_nFreeIds++] = id;
+
+#ifdef FCS_TASK_SCHDLR_IMMEDIATE_ENABLE
+    FCS_TASK_SCHDLR_unlockImmediate(nLock);
+#endif
+
+#ifdef FCS_TASK_SCHDLR_TICKLESS_ENABLE
+    m_bTickSpanStale = true;
+#endif
+
+    // Task successfully removed.
+    return true;
+}
+
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_updateTask
+// Returns:         Success status of task update.
+// Param1:          *pTask - Task to update.
+// Param2:          intvlTicks - Dispatch interval.
+// Param3:          priority - Priority level.
+// Description:     Updates a task's dispatch interval and priority level. A task
+// moved to another priority level is queued behind that level's existing tasks.
+//***************************************************************************
+static bool _FCS_TASK_SCHDLR_updateTask(FCS_Task_t *pTask, uint32_t intvlTicks,
+        FCS_TaskPriority_e priority)
+{
+#ifdef FCS_TASK_SCHDLR_IMMEDIATE_ENABLE
+    uint32_t nLock;
+#endif
+
+    if((unsigned int) priority > TASK_PRTY_MAX)
+    {
+        // Unexpected priority assignment.
+        return false;
+    }
+
+#ifdef FCS_TASK_SCHDLR_IMMEDIATE_ENABLE
+    nLock = FCS_TASK_SCHDLR_lockImmediate();
+#endif
+
+    if(priority != pTask->priority)
+    {
+        // Move the task to the list of its new priority level.
+        _FCS_TASK_SCHDLR_prtyUnlink(pTask->id);
+        pTask->priority = priority;
+        _FCS_TASK_SCHDLR_prtyLink(pTask->id);
+
+        // A pending signal follows the task to its new level.
+        _FCS_TASK_SCHDLR_sigRefile(pTask->id, true);
+    }
+
+    // Update the interval ticks.
+    pTask->nIntvlTcks = intvlTicks;
+    pTask->nElapsTcks = 0;
+
+#ifdef FCS_TASK_SCHDLR_SOA_ENABLE
+    m_aIntvlTcks[pTask->id] = intvlTicks;
+    m_aElapsTcks[pTask->id] = 0;
+#endif
+
+#ifdef RDY_QUEUE
+    _FCS_TASK_SCHDLR_rdyClear(pTask->id);
+#endif
+
+#ifdef FCS_TASK_SCHDLR_EDF_ENABLE
+    // The released activation is dropped along with the elapsed ticks.
+    _FCS_TASK_SCHDLR_edfUnlink(pTask->id);
+#endif
+
+#ifdef FCS_TASK_SCHDLR_WHEEL_ENABLE
+    // Restart the interval from the current wheel tick.
+    _FCS_TASK_SCHDLR_wheelUnlink(pTask->id);
+    pTask->nRlsTck = m_nWheelTck + _FCS_TASK_SCHDLR_wheelIntvl(pTask);
+
+    if(WHEEL_FILED(priority))
+    {
+        _FCS_TASK_SCHDLR_wheelInsert(pTask->id);
+    }
+#endif
+
+#ifdef FCS_TASK_SCHDLR_IMMEDIATE_ENABLE
+    FCS_TASK_SCHDLR_unlockImmediate(nLock);
+#endif
+
+#ifdef FCS_TASK_SCHDLR_TICKLESS_ENABLE
+    m_bTickSpanStale = true;
+#endif
+
+    return true;
+}
+
+#ifndef FCS_TASK_SCHDLR_CYCLIC_ENABLE
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_releaseIn
+// Returns:         Ticks from the last tick taken until the task's next release,
+//                  0 if a release is pending.
+// Param1:          idx - ID of a task with an interval.
+// Description:     Reads a task's release phase from its timing state.
+//***************************************************************************
+static uint32_t _FCS_TASK_SCHDLR_releaseIn(uint8_t idx)
+{
+    FCS_Task_t *pTask = &m_pTaskLst[idx];
+    uint32_t nIntvl = (pTask->nIntvlTcks > 0) ? pTask->nIntvlTcks : 1;
+    uint32_t nElaps = pTask->nElapsTcks;
+
+#ifdef FCS_TASK_SCHDLR_WHEEL_ENABLE
+    if(pTask->priority != FCS_TASKPRIORITY_Immediate)
+    {
+        if((pTask->pWheelList >= &m_aRdyHead[0]) && (pTask->pWheelList < &m_aRdyHead[TASK_PRTY_LVLS]))
+        {
+            // Released and waiting on a ready list.
+            return 0;
+        }
+
+        return pTask->nRlsTck - m_nWheelTck;
+    }
+#endif
+
+#ifdef FCS_TASK_SCHDLR_SOA_ENABLE
+    if(pTask->priority != FCS_TASKPRIORITY_Immediate)
+    {
+        nElaps = m_aElapsTcks[idx];
+    }
+#endif
+
+    return (nElaps >= nIntvl) ? 0 : (nIntvl - nElaps);
+}
+
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_setReleaseIn
+// Returns:         void
+// Param1:          *pTask - Task with an interval.
+// Param2:          nTicks - Ticks from the last tick taken until the next release,
+//                  1 to the task's interval.
+// Description:     Moves a task's next release, and the releases following it. A
+// release already pending is dropped.
+//***************************************************************************
+static void _FCS_TASK_SCHDLR_setReleaseIn(FCS_Task_t *pTask, uint32_t nTicks)
+{
+    uint32_t nIntvl = (pTask->nIntvlTcks > 0) ? pTask->nIntvlTcks : 1;
+#ifdef FCS_TASK_SCHDLR_IMMEDIATE_ENABLE
+    uint32_t nLock = FCS_TASK_SCHDLR_lockImmediate();
+#endif
+
+    // The task is released once its elapsed ticks reach the interval.
+    pTask->nElapsTcks = nIntvl - nTicks;
+
+#ifdef FCS_TASK_SCHDLR_SOA_ENABLE
+    m_aElapsTcks[pTask->id] = nIntvl - nTicks;
+#endif
+
+#ifdef RDY_QUEUE
+    _FCS_TASK_SCHDLR_rdyClear(pTask->id);
+#endif
+
+#ifdef FCS_TASK_SCHDLR_EDF_ENABLE
+    _FCS_TASK_SCHDLR_edfUnlink(pTask->id);
+#endif
+
+#ifdef FCS_TASK_SCHDLR_WHEEL_ENABLE
+    if(WHEEL_FILED(pTask->priority))
+    {
+        _FCS_TASK_SCHDLR_wheelUnlink(pTask->id);
+        pTask->nRlsTck = m_nWheelTck + nTicks;
+        _FCS_TASK_SCHDLR_wheelInsert(pTask->id);
+    }
+#endif
+
+#ifdef FCS_TASK_SCHDLR_IMMEDIATE_ENABLE
+    FCS_TASK_SCHDLR_unlockImmediate(nLock);
+#endif
+
+#ifdef FCS_TASK_SCHDLR_TICKLESS_ENABLE
+    m_bTickSpanStale = true;
+#endif
+}
+
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_gcd
+// Returns:         Greatest common divisor of the values.
+// Param1:          a - First value.
+// Param2:          b - Second value.
+// Description:     Euclid's algorithm.
+//***************************************************************************
+static uint32_t _FCS_TASK_SCHDLR_gcd(uint32_t a, uint32_t b)
+{
+    uint32_t t;
+
+    while(b != 0)
+    {
+        t = a % b;
+        a = b;
+        b = t;
+    }
+
+    return a;
+}
+
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_stagger
+// Returns:         void
+// Param1:          *pTask - Task with an interval to place.
+// Description:     Moves a task's releases to the ticks least loaded by the other
+// tasks with an interval. Another task j shares some of the task's release ticks
+// exactly when the two next releases are congruent modulo gcd(interval, interval j).
+// Each task j is charged, once, to every offset in its class modulo that gcd, with
+// the mean measured cycles or the average of the measured tasks for tasks that have
+// not run yet. The charges repeat every lcm of those gcd's, which divides the
+// interval, so only one such span of offsets is scanned, and at most
+// FCS_TASK_SCHDLR_STAGGER_SPAN of them.
+//***************************************************************************
+static void _FCS_TASK_SCHDLR_stagger(FCS_Task_t *pTask)
+{
+    uint32_t nIntvl = (pTask->nIntvlTcks > 0) ? pTask->nIntvlTcks : 1;
+    uint32_t nSpan = 1;
+    uint32_t nBest = nIntvl;
+    uint32_t nBestLoad;
+    uint32_t nCost;
+    uint32_t nDefault = 1;
+    uint32_t nOffset;
+    uint32_t nGcd;
+    uint64_t nLcm;
+    uint8_t prty;
+    uint8_t idx;
+#ifndef FCS_TASK_SCHDLR_PROFILE_DISABLE
+    uint32_t nMeasured = 0;
+    uint64_t nSum = 0;
+
+    // Tasks that have not run yet count with the average measured runtime.
+    for(prty = FCS_TASKPRIORITY_Low; prty < TASK_PRTY_LVLS; prty++)
+    {
+        for(idx = m_aPrtyHead[prty]; idx != TASK_NULL_IDX; idx = m_pTaskLst[idx].nPrtyNext)
+        {
+            if((idx != pTask->id) && (m_aProf[idx].nRunCnt > 0))
+            {
+                nSum += m_aProf[idx].nTotalCyc / m_aProf[idx].nRunCnt;
+                nMeasured++;
+            }
+        }
+    }
+
+    if(nMeasured > 0)
+    {
+        nDefault = (uint32_t) (nSum / nMeasured) + 1;
+    }
+#endif
+
+    for(nOffset = 0; nOffset < FCS_TASK_SCHDLR_STAGGER_SPAN; nOffset++)
+    {
+        m_aStaggerLoad[nOffset] = 0;
+    }
+
+    for(prty = FCS_TASKPRIORITY_Low; prty < TASK_PRTY_LVLS; prty++)
+    {
+        for(idx = m_aPrtyHead[prty]; idx != TASK_NULL_IDX; idx = m_pTaskLst[idx].nPrtyNext)
+        {
+            if(idx == pTask->id)
+            {
+                continue;
+            }
+
+            nGcd = _FCS_TASK_SCHDLR_gcd(nIntvl,
+                    (m_pTaskLst[idx].nIntvlTcks > 0) ? m_pTaskLst[idx].nIntvlTcks : 1);
+
+            if(nGcd == 1)
+            {
+                // Shares ticks at every offset alike.
+                continue;
+            }
+
+            // The pattern of shared ticks repeats every lcm of the gcd's.
+            nLcm = (uint64_t) (nSpan / _FCS_TASK_SCHDLR_gcd(nSpan, nGcd)) * nGcd;
+            nSpan = (nLcm < FCS_TASK_SCHDLR_STAGGER_SPAN) ? (uint32_t) nLcm : FCS_TASK_SCHDLR_STAGGER_SPAN;
+
+#ifndef FCS_TASK_SCHDLR_PROFILE_DISABLE
+            nCost = (m_aProf[idx].nRunCnt > 0)
+                    ? (uint32_t) (m_aProf[idx].nTotalCyc / m_aProf[idx].nRunCnt) + 1 : nDefault;
+#else
+            nCost = nDefault;
+#endif
+
+            // Charge the offsets congruent to the task's next release.
+            for(nOffset = _FCS_TASK_SCHDLR_releaseIn(idx) % nGcd;
+                    nOffset < FCS_TASK_SCHDLR_STAGGER_SPAN; nOffset += nGcd)
+            {
+                m_aStaggerLoad[nOffset] += nCost;
+
+                if(nGcd >= FCS_TASK_SCHDLR_STAGGER_SPAN)
+                {
+                    break;
+                }
+            }
+        }
+    }
+
+    // Offsets 1 to nSpan from the last tick taken, with offset 0 standing for the full
+    // interval. The full interval wins ties, then the later offsets.
+    nBestLoad = m_aStaggerLoad[0];
+
+    for(nOffset = nSpan - 1; nOffset > 0; nOffset--)
+    {
+        if(m_aStaggerLoad[nOffset] < nBestLoad)
+        {
+            nBestLoad = m_aStaggerLoad[nOffset];
+            nBest = nOffset;
+        }
+    }
+
+    _FCS_TASK_SCHDLR_setReleaseIn(pTask, nBest);
+}
+#endif
+
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_sigSet
+// Returns:         void
+// Param1:          idx - ID of a task at a level that can be signaled.
+// Description:     Marks a task as signaled at its priority level. Safe to call
+// from interrupts.
+//***************************************************************************
+static void _FCS_TASK_SCHDLR_sigSet(uint8_t idx)
+{
+    uint32_t nState = FCS_TASK_SCHDLR_PORT_enterCritical();
+
+    m_aSigMask[m_pTaskLst[idx].priority][idx >> 5] |= (1UL << (idx & 31));
+    m_nSigLvls |= (1UL << m_pTaskLst[idx].priority);
+
+    FCS_TASK_SCHDLR_PORT_exitCritical(nState);
+}
+
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_sigRefile
+// Returns:         void
+// Param1:          idx - ID of the task.
+// Param2:          bKeep - Keep a pending signal at the task's current level.
+// Description:     Clears a task's signal from every level, as it may have been
+// set at the level the task was at before. A kept signal is set again if the task's
+// level can be signaled.
+//***************************************************************************
+static void _FCS_TASK_SCHDLR_sigRefile(uint8_t idx, bool bKeep)
+{
+    uint32_t nBit = 1UL << (idx & 31);
+    bool bPend = false;
+    uint32_t nState;
+    uint8_t prty;
+
+    nState = FCS_TASK_SCHDLR_PORT_enterCritical();
+
+    for(prty = 0; prty < TASK_PRTY_LVLS; prty++)
+    {
+        if((m_aSigMask[prty][idx >> 5] & nBit) != 0)
+        {
+            m_aSigMask[prty][idx >> 5] &= ~nBit;
+            bPend = true;
+        }
+    }
+
+    if(bKeep && bPend && SIG_LEVEL(m_pTaskLst[idx].priority))
+    {
+        m_aSigMask[m_pTaskLst[idx].priority][idx >> 5] |= nBit;
+        m_nSigLvls |= (1UL << m_pTaskLst[idx].priority);
+    }
+
+    FCS_TASK_SCHDLR_PORT_exitCritical(nState);
+}
+
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_sigTake
+// Returns:         ID of the signaled task to run next, TASK_NULL_IDX if none.
+// Param1:          void
+// Description:     Takes the signal of the highest priority signaled task. CLZ on
+// the level bits finds the level; tasks of the same level are taken in order of
+// task ID.
+//***************************************************************************
+static uint8_t _FCS_TASK_SCHDLR_sigTake(void)
+{
+    uint8_t idx = TASK_NULL_IDX;
+    uint32_t nState;
+    uint32_t nPend;
+    uint8_t prty;
+    uint8_t word;
+
+    nState = FCS_TASK_SCHDLR_PORT_enterCritical();
+
+    while((m_nSigLvls != 0) && (idx == TASK_NULL_IDX))
+    {
+        prty = (uint8_t) FCS_TASK_SCHDLR_PORT_LOG2(m_nSigLvls);
+
+        for(word = 0; (word < TASK_MASK_WORDS) && (idx == TASK_NULL_IDX); word++)
+        {
+            nPend = m_aSigMask[prty][word];
+
+            if(nPend != 0)
+            {
+                idx = (uint8_t) ((word << 5) + __builtin_ctz(nPend));
+                m_aSigMask[prty][word] = nPend & (nPend - 1);
+            }
+        }
+
+        if(idx == TASK_NULL_IDX)
+        {
+            // The level's signals were cleared since it was marked.
+            m_nSigLvls &= ~(1UL << prty);
+        }
+    }
+
+    FCS_TASK_SCHDLR_PORT_exitCritical(nState);
+
+    return idx;
+}
+
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_runTask
+// Returns:         void
+// Param1:          *pTask - Priority task to run.
+// Param2:          nLateTcks - Ticks between the release being run and the last tick
+//                  taken by the dispatcher.
+// Description:     Runs a priority task whose interval has expired, then checks the
+// run for timing faults.
+//***************************************************************************
+static void _FCS_TASK_SCHDLR_runTask(FCS_Task_t *pTask, uint32_t nLateTcks)
+{
+    uint8_t nGen = m_aTaskGen[pTask->id];
+    uint32_t nIntvl = (TASK_INTVL(pTask->id) > 0) ? TASK_INTVL(pTask->id) : 1;
+    uint32_t nStartTck = m_nTickCnt;
+#ifndef FCS_TASK_SCHDLR_PROFILE_DISABLE
+    uint32_t nStartCyc;
+#endif
+
+    // Ticks not yet taken by the dispatcher delayed the start as well.
+    nLateTcks += nStartTck - m_nTickSeen;
+
+#ifdef _DEBUG_ENABLE
+    if(m_pfnTimingStart != NULL)
+    {
+        m_pfnTimingStart();
+    }
+#endif
+
+#ifndef FCS_TASK_SCHDLR_PROFILE_DISABLE
+    nStartCyc = _FCS_TASK_SCHDLR_profStart(pTask->id);
+#endif
+
+#ifdef FCS_TASK_SCHDLR_WATCHDOG_ENABLE
+    m_nRunTck = nStartTck;
+    m_nRunIdx = pTask->id;
+#endif
+
+    // Interval has expired. Run the task.
+    if(TASK_ARG(pTask->id) != NULL)
+    {
+        // Pass the stored argument.
+        TASK_CODE(pTask->id).pfnHasArg(TASK_ARG(pTask->id));
+    }
+    else
+    {
+        // Pass pointer to the elapsed time value.
+        TASK_CODE(pTask->id).pfnHasArg(&TASK_ELAPS(pTask->id));
+    }
+
+#ifndef FCS_TASK_SCHDLR_PROFILE_DISABLE
+    _FCS_TASK_SCHDLR_profStop(pTask->id, nGen, nStartCyc);
+#endif
+
+#ifdef FCS_TASK_SCHDLR_WATCHDOG_ENABLE
+    m_nRunIdx = TASK_NULL_IDX;
+
+    // A completed run checks in, unless the task removed itself.
+    if((m_aTaskGen[pTask->id] == nGen) && !pTask->bHbManual)
+    {
+        pTask->nHbTck = m_nTickCnt;
+    }
+#endif
+
+#ifdef _DEBUG_ENABLE
+    if(m_pfnTimingStop != NULL)
+    {
+        m_pfnTimingStop();
+    }
+#endif
+
+    _FCS_TASK_SCHDLR_checkFaults(pTask, nGen, nLateTcks, m_nTickCnt - nStartTck, nIntvl);
+}
+
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_checkFaults
+// Returns:         void
+// Param1:          *pTask - Priority task that ran.
+// Param2:          nGen - Handle generation of the task when it started.
+// Param3:          nLateTcks - Ticks the run started after its release.
+// Param4:          nRunTcks - Ticks counted while the task ran.
+// Param5:          nIntvl - Interval of the task when it started, at least 1.
+// Description:     Counts the timing faults of a run and passes them to the policy.
+//***************************************************************************
+static void _FCS_TASK_SCHDLR_checkFaults(FCS_Task_t *pTask, uint8_t nGen, uint32_t nLateTcks,
+        uint32_t nRunTcks, uint32_t nIntvl)
+{
+    if(m_aTaskGen[pTask->id] != nGen)
+    {
+        // The task removed itself.
+        return;
+    }
+
+    if(nLateTcks > pTask->nLateLimTcks)
+    {
+        pTask->nLateCnt++;
+        _FCS_TASK_SCHDLR_faultPolicy(pTask, FCS_TASKFAULT_Late, nLateTcks);
+    }
+
+    // The policy may have removed the task.
+    if((m_aTaskGen[pTask->id] == nGen) && (nRunTcks > nIntvl))
+    {
+        pTask->nOvrnCnt++;
+        _FCS_TASK_SCHDLR_faultPolicy(pTask, FCS_TASKFAULT_Overrun, nRunTcks);
+    }
+}
+
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_faultPolicy
+// Returns:         void
+// Param1:          *pTask - Faulty task.
+// Param2:          fault - Fault detected.
+// Param3:          nTicks - Lateness or run time of the faulty run.
+// Description:     Passes a timing fault to the registered policy and applies the
+// action it returns.
+//***************************************************************************
+static void _FCS_TASK_SCHDLR_faultPolicy(FCS_Task_t *pTask, FCS_TaskFault_e fault, uint32_t nTicks)
+{
+    uint8_t nGen = m_aTaskGen[pTask->id];
+    FCS_TaskFaultAction_e action;
+
+    if(m_pfnFaultPolicy == NULL)
+    {
+        // Faults are only counted.
+        return;
+    }
+
+    action = m_pfnFaultPolicy((FCS_TaskHandle_t) (((FCS_TaskHandle_t) nGen << 8) | pTask->id),
+            fault, nTicks);
+
+    if(m_aTaskGen[pTask->id] != nGen)
+    {
+        // The policy removed the task itself.
+        return;
+    }
+
+    switch(action)
+    {
+        case FCS_TASKFAULTACTION_Demote:
+            if(pTask->priority > FCS_TASKPRIORITY_Low)
+            {
+                (void) _FCS_TASK_SCHDLR_updateTask(pTask, pTask->nIntvlTcks,
+                        (FCS_TaskPriority_e) (pTask->priority - 1));
+            }
+            else
+            {
+                (void) 0;
+            }
+            break;
+
+        case FCS_TASKFAULTACTION_Remove:
+            (void) _FCS_TASK_SCHDLR_removeTask(pTask);
+            break;
+
+        default:
+            (void) 0;
+            break;
+    }
+}
+
+#ifndef FCS_TASK_SCHDLR_PROFILE_DISABLE
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_profClear
+// Returns:         void
+// Param1:          idx - ID of the task whose profile to reset.
+// Description:     Resets a task's execution time profile.
+//***************************************************************************
+static void _FCS_TASK_SCHDLR_profClear(uint8_t idx)
+{
+    FCS_TaskProfile_t *pProf = &m_aProf[idx];
+    uint8_t bin;
+
+    pProf->nRunCnt = 0;
+    pProf->nMinCyc = UINT32_MAX;
+    pProf->nMaxCyc = 0;
+    pProf->nMeanCyc = 0;
+    pProf->nTotalCyc = 0;
+    pProf->nLastStartTck = 0;
+
+    for(bin = 0; bin < FCS_TASK_SCHDLR_PROFILE_BINS; bin++)
+    {
+        pProf->aHist[bin] = 0;
+    }
+}
+
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_profStart
+// Returns:         Cycle count the run starts at.
+// Param1:          idx - ID of the task about to run.
+// Description:     Records the start of a task run.
+//***************************************************************************
+static uint32_t _FCS_TASK_SCHDLR_profStart(uint8_t idx)
+{
+    m_aProf[idx].nLastStartTck = m_nTickCnt;
+
+    return FCS_TASK_SCHDLR_PORT_CYCLES();
+}
+
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_profStop
+// Returns:         void
+// Param1:          idx - ID of the task that ran.
+// Param2:          nGen - Handle generation of the task when it started.
+// Param3:          nStartCyc - Cycle count returned by _FCS_TASK_SCHDLR_profStart.
+// Description:     Adds a finished task run to the task's profile. Takes the same
+// few cycles for every run.
+//***************************************************************************
+static void _FCS_TASK_SCHDLR_profStop(uint8_t idx, uint8_t nGen, uint32_t nStartCyc)
+{
+    uint32_t nCyc = FCS_TASK_SCHDLR_PORT_CYCLES() - nStartCyc;
+    FCS_TaskProfile_t *pProf = &m_aProf[idx];
+    uint16_t *pBin;
+
+    if(m_aTaskGen[idx] != nGen)
+    {
+        // The task removed itself. Its ID may already belong to a new task.
+        return;
+    }
+
+    pProf->nRunCnt++;
+    pProf->nTotalCyc += nCyc;
+
+    if(nCyc < pProf->nMinCyc)
+    {
+        pProf->nMinCyc = nCyc;
+    }
+
+    if(nCyc > pProf->nMaxCyc)
+    {
+        pProf->nMaxCyc = nCyc;
+    }
+
+    pBin = &pProf->aHist[FCS_TASK_SCHDLR_PORT_LOG2(nCyc)];
+
+    if(*pBin < UINT16_MAX)
+    {
+        (*pBin)++;
+    }
+}
+#endif
+
+#ifdef FCS_TASK_SCHDLR_WATCHDOG_ENABLE
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_wdogRecChk
+// Returns:         Check word of the reset cause record.
+// Param1:          void
+// Description:     Combines the record's fields with a constant, so RAM left random
+// by a power-on is not taken for a record.
+//***************************************************************************
+static uint32_t _FCS_TASK_SCHDLR_wdogRecChk(void)
+{
+    return 0x5AFEC0DEUL ^ ((uint32_t) m_wdogRec.cause << 24) ^ ((uint32_t) m_wdogRec.id << 16)
+            ^ m_wdogRec.hTask ^ (uint32_t) (uintptr_t) m_wdogRec.code.pfnNoArg
+            ^ m_wdogRec.nTicks ^ (m_wdogRec.nTick << 1);
+}
+
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_wdogRecord
+// Returns:         void
+// Param1:          cause - Why the watchdog is left to expire.
+// Param2:          idx - Slot of the task responsible, TASK_NULL_IDX for none.
+// Param3:          nTicks - Ticks since the task checked in or started running.
+// Description:     Writes the reset cause record and its check word.
+//***************************************************************************
+static void _FCS_TASK_SCHDLR_wdogRecord(FCS_TaskWdogCause_e cause, uint8_t idx, uint32_t nTicks)
+{
+    m_wdogRec.cause = cause;
+    m_wdogRec.id = idx;
+    m_wdogRec.nTicks = nTicks;
+    m_wdogRec.nTick = m_nTickCnt;
+
+    if(idx != TASK_NULL_IDX)
+    {
+        m_wdogRec.hTask = (FCS_TaskHandle_t) (((FCS_TaskHandle_t) m_aTaskGen[idx] << 8) | idx);
+        m_wdogRec.code = TASK_CODE(idx);
+    }
+    else
+    {
+        m_wdogRec.hTask = FCS_TASK_SCHDLR_INVALID_HANDLE;
+        m_wdogRec.code.pfnNoArg = NULL;
+    }
+
+    m_nWdogRecChk = _FCS_TASK_SCHDLR_wdogRecChk();
+}
+
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_wdogSupervise
+// Returns:         void
+// Param1:          void
+// Description:     Refreshes the watchdog if every supervised task checked in within
+// its window. Otherwise records the first lapsed task and stops refreshing, so the
+// watchdog resets the processor.
+//***************************************************************************
+static void _FCS_TASK_SCHDLR_wdogSupervise(void)
+{
+    uint32_t nNow = m_nTickCnt;
+    uint32_t nSince;
+    uint8_t idx;
+
+    m_nWdogTck = nNow;
+
+    if(m_bWdogLapsed)
+    {
+        return;
+    }
+
+    for(idx = 0; idx < m_nMaxTasks; idx++)
+    {
+        if(m_pTaskLst[idx].nHbWinTcks > 0)
+        {
+            nSince = nNow - m_pTaskLst[idx].nHbTck;
+
+            if(nSince > m_pTaskLst[idx].nHbWinTcks)
+            {
+                m_bWdogLapsed = true;
+                _FCS_TASK_SCHDLR_wdogRecord(FCS_TASKWDOG_Starved, idx, nSince);
+                return;
+            }
+        }
+    }
+
+    m_pfnWdogRefresh();
+}
+#endif
+
+#ifdef FCS_TASK_SCHDLR_LOAD_ENABLE
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_loadTick
+// Returns:         void
+// Param1:          nTicks - Ticks taken by the dispatcher.
+// Description:     Charges the busy cycles counted since the previous ticks were taken
+// to the ticks now taken, and opens a busy span for processing them.
+//***************************************************************************
+static void _FCS_TASK_SCHDLR_loadTick(uint32_t nTicks)
+{
+    uint32_t nNow = FCS_TASK_SCHDLR_PORT_CYCLES();
+    uint32_t nBusy = m_nLoadSpanCyc;
+    uint32_t nTickCyc;
+
+    if(m_bLoadBusy)
+    {
+        nBusy += nNow - m_nLoadStartCyc;
+    }
+
+    m_nLoadStartCyc = nNow;
+    m_bLoadBusy = true;
+    m_nLoadSpanCyc = 0;
+
+    // Ticks taken together count with their mean.
+    nTickCyc = (nTicks == 1) ? nBusy : (nBusy / nTicks);
+
+    if(nTickCyc > m_nLoadPeakCyc)
+    {
+        m_nLoadPeakCyc = nTickCyc;
+    }
+
+    m_nLoadSecCyc += nBusy;
+    m_nLoadSecIdleCyc += m_nLoadIdleCyc;
+    m_nLoadIdleCyc = 0;
+    m_nLoadSecTcks += nTicks;
+
+    if(m_nLoadSecTcks >= FCS_TASK_SCHDLR_TICK_HZ)
+    {
+        _FCS_TASK_SCHDLR_loadSecond();
+    }
+}
+
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_loadSecond
+// Returns:         void
+// Param1:          void
+// Description:     Stores the load and idle task load of the seconds just counted.
+// Ticks taken together may complete several seconds at once, which all get their mean
+// load. The ticks past the last whole second and their share of the cycles count
+// towards the next second.
+//***************************************************************************
+static void _FCS_TASK_SCHDLR_loadSecond(void)
+{
+    uint32_t nSecs = m_nLoadSecTcks / FCS_TASK_SCHDLR_TICK_HZ;
+    uint32_t nLoad = _FCS_TASK_SCHDLR_loadShare(&m_nLoadSecCyc, nSecs);
+    uint32_t nIdleLoad = _FCS_TASK_SCHDLR_loadShare(&m_nLoadSecIdleCyc, nSecs);
+
+    if(nSecs > FCS_TASK_SCHDLR_LOAD_SECS)
+    {
+        nSecs = FCS_TASK_SCHDLR_LOAD_SECS;
+    }
+
+    while(nSecs-- > 0)
+    {
+        m_aLoadSecs[m_nLoadSecNext] = (uint16_t) nLoad;
+        m_aLoadIdleSecs[m_nLoadSecNext] = (uint16_t) nIdleLoad;
+        m_nLoadSecNext = (m_nLoadSecNext + 1) % FCS_TASK_SCHDLR_LOAD_SECS;
+
+        if(m_nLoadSecCnt < FCS_TASK_SCHDLR_LOAD_SECS)
+        {
+            m_nLoadSecCnt++;
+        }
+    }
+
+    m_nLoadSecTcks %= FCS_TASK_SCHDLR_TICK_HZ;
+}
+
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_loadShare
+// Returns:         Load of the whole seconds in hundredths of a percent.
+// Param1:          *pnCyc - Cycles of the ticks counted. Returns the share of the
+//                  ticks past the whole seconds, at the mean of all the ticks.
+// Param2:          nSecs - Whole seconds in the ticks counted.
+// Description:     Splits cycles counted over m_nLoadSecTcks ticks into the load of
+// the whole seconds and the cycles carried to the next second.
+//***************************************************************************
+static uint32_t _FCS_TASK_SCHDLR_loadShare(uint32_t *pnCyc, uint32_t nSecs)
+{
+    uint32_t nTicks = nSecs * FCS_TASK_SCHDLR_TICK_HZ;
+    uint32_t nCarryCyc;
+    uint32_t nCap;
+    uint32_t nLoad;
+
+    nCarryCyc = (uint32_t) (((uint64_t) *pnCyc * (m_nLoadSecTcks - nTicks)) / m_nLoadSecTcks);
+
+    if(nTicks > (UINT32_MAX / FCS_TASK_SCHDLR_TICK_CYCLES))
+    {
+        nTicks = UINT32_MAX / FCS_TASK_SCHDLR_TICK_CYCLES;
+    }
+
+    // Cycles per hundredth of a percent of the whole seconds.
+    nCap = (nTicks * FCS_TASK_SCHDLR_TICK_CYCLES) / 10000;
+    nLoad = (*pnCyc - nCarryCyc) / ((nCap > 0) ? nCap : 1);
+    *pnCyc = nCarryCyc;
+
+    return (nLoad < 10000) ? nLoad : 10000;
+}
+#endif
+
+#ifdef FCS_TASK_SCHDLR_SLEEP_ENABLE
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_sleep
+// Returns:         void
+// Param1:          void
+// Description:     Sleeps in the deepest mode that wakes up before the next deadline,
+// or returns at once if none does. Interrupts stay masked from the last check for
+// work until the mode is entered, so a tick or signal arriving in between ends the
+// sleep instead of being slept through.
+//***************************************************************************
+static void _FCS_TASK_SCHDLR_sleep(void)
+{
+    uint32_t nState;
+    uint32_t nIdle;
+    uint32_t nLatTcks;
+    uint32_t nSleep = 0;
+    uint32_t nMeasUs;
+    uint8_t nMode;
+
+    nState = FCS_TASK_SCHDLR_PORT_enterCritical();
+    nIdle = FCS_TASK_SCHDLR_getIdleTicks();
+
+    if(nIdle == 0)
+    {
+        // Work came in.
+        FCS_TASK_SCHDLR_PORT_exitCritical(nState);
+        return;
+    }
+
+    // Deeper modes have to wake up by themselves, early enough for their latency and
+    // the part of a tick already gone.
+    for(nMode = m_nSleepModes - 1; nMode > 0; nMode--)
+    {
+        nLatTcks = (m_aSleepStats[nMode].nLatencyUs + FCS_TASK_SCHDLR_TICK_US - 1)
+                / FCS_TASK_SCHDLR_TICK_US;
+
+        if(nIdle == FCS_TASK_SCHDLR_IDLE_FOREVER)
+        {
+            nSleep = FCS_TASK_SCHDLR_IDLE_FOREVER;
+            break;
+        }
+
+        if(nIdle > (nLatTcks + 1))
+        {
+            nSleep = nIdle - nLatTcks - 1;
+            break;
+        }
+    }
+
+    if(nMode == 0)
+    {
+        if(m_aSleepStats[0].nLatencyUs >= FCS_TASK_SCHDLR_TICK_US)
+        {
+            // No mode wakes up in time.
+            FCS_TASK_SCHDLR_PORT_exitCritical(nState);
+            return;
+        }
+
+        // The tick timer wakes it up.
+        nSleep = nIdle;
+    }
+
+    m_aSleepStats[nMode].nEntries++;
+    nMeasUs = m_pfnSleep(nMode, nSleep);
+    FCS_TASK_SCHDLR_PORT_exitCritical(nState);
+
+    if(nMeasUs == FCS_TASK_SCHDLR_SLEEP_EARLY)
+    {
+        m_aSleepStats[nMode].nEarly++;
+    }
+    else
+    {
+        m_aSleepStats[nMode].nLastUs = nMeasUs;
+
+        if(nMeasUs > m_aSleepStats[nMode].nWorstUs)
+        {
+            m_aSleepStats[nMode].nWorstUs = nMeasUs;
+        }
+
+        if(nMeasUs > m_aSleepStats[nMode].nLatencyUs)
+        {
+            // Slower than expected. Only pick the mode when it wakes up in time.
+            m_aSleepStats[nMode].nLatencyUs = nMeasUs;
+        }
+    }
+}
+#endif
+
+#if !defined(FCS_TASK_SCHDLR_WHEEL_ENABLE) && !defined(FCS_TASK_SCHDLR_CYCLIC_ENABLE)
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_dispatchTask
+// Returns:         void
+// Param1:          idx - Slot of a priority task whose interval has expired.
+// Description:     Runs an expired task according to its release mode. Every full
+// interval contained in the elapsed ticks is one pending activation. Relative tasks
+// restart their interval after running. Absolute tasks only consume the intervals
+// they were released for, so their phase is kept however late they run.
+//***************************************************************************
+static void _FCS_TASK_SCHDLR_dispatchTask(uint8_t idx)
+{
+    FCS_Task_t *pTask = &m_pTaskLst[idx];
+    uint32_t nIntvl;
+    uint32_t nPending;
+    uint32_t nMissed;
+    uint8_t gen;
+
+    // Intervals of 0 and 1 both release the task on every tick.
+    nIntvl = (TASK_INTVL(idx) > 0) ? TASK_INTVL(idx) : 1;
+    nPending = TASK_ELAPS(idx) / nIntvl;
+    nMissed = (nPending > 1) ? (nPending - 1) : 0;
+
+    switch(pTask->release)
+    {
+        case FCS_TASKRELEASE_AbsSkip:
+            // Drop every pending activation if any of them is late.
+            TASK_ELAPS(idx) -= nPending * nIntvl;
+
+            if(nMissed > 0)
+            {
+                pTask->nMissCnt += nPending;
+            }
+            else
+            {
+                _FCS_TASK_SCHDLR_runTask(pTask, TASK_ELAPS(idx));
+            }
+            break;
+
+        case FCS_TASKRELEASE_AbsRunOnce:
+            // Run the latest activation only and flag the ones dropped.
+            TASK_ELAPS(idx) -= nPending * nIntvl;
+
+            if(nMissed > 0)
+            {
+                pTask->nMissCnt += nMissed;
+                pTask->bOverrun = true;
+            }
+            else
+            {
+                (void) 0;
+            }
+
+            _FCS_TASK_SCHDLR_runTask(pTask, TASK_ELAPS(idx));
+            break;
+
+        case FCS_TASKRELEASE_AbsCatchUp:
+            // Run every pending activation back to back. Stop if the task is removed
+            // or updated, which resets its elapsed ticks.
+            pTask->nMissCnt += nMissed;
+            gen = m_aTaskGen[idx];
+
+            while((m_aTaskGen[idx] == gen) && (pTask->release == FCS_TASKRELEASE_AbsCatchUp)
+                    && (TASK_ELAPS(idx) >= nIntvl))
+            {
+                TASK_ELAPS(idx) -= nIntvl;
+                _FCS_TASK_SCHDLR_runTask(pTask, TASK_ELAPS(idx));
+            }
+            break;
+
+        default:
+            // Restart the interval once the task has run.
+            pTask->nMissCnt += nMissed;
+            _FCS_TASK_SCHDLR_runTask(pTask, TASK_ELAPS(idx) - nIntvl);
+
+            // Reset ticks elapsed.
+            TASK_ELAPS(idx) = 0;
+            break;
+    }
+}
+#endif
+
+#ifdef RDY_QUEUE
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_rdyClear
+// Returns:         void
+// Param1:          idx - ID of the task.
+// Description:     Removes a task from the ready bitmap of its priority level.
+//***************************************************************************
+static void _FCS_TASK_SCHDLR_rdyClear(uint8_t idx)
+{
+    FCS_TaskPriority_e priority = m_pTaskLst[idx].priority;
+    uint8_t word;
+
+    m_aRdyMask[priority][idx >> 5] &= ~(1UL << (idx & 31));
+
+    for(word = 0; word < TASK_MASK_WORDS; word++)
+    {
+        if(m_aRdyMask[priority][word] != 0)
+        {
+            // The level still has ready tasks.
+            return;
+        }
+    }
+
+    m_nRdyLvls &= ~(1UL << priority);
+}
+
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_rdyTake
+// Returns:         ID of the ready task to run next.
+// Param1:          void
+// Description:     Takes the highest priority ready task off the ready bitmaps.
+// CLZ on the level bits finds the level; tasks of the same level are taken in order
+// of task ID. At least one task must be ready.
+//***************************************************************************
+static uint8_t _FCS_TASK_SCHDLR_rdyTake(void)
+{
+    uint8_t prty = (uint8_t) FCS_TASK_SCHDLR_PORT_LOG2(m_nRdyLvls);
+    uint8_t word = 0;
+    uint8_t idx;
+
+    while(m_aRdyMask[prty][word] == 0)
+    {
+        word++;
+    }
+
+    idx = (uint8_t) ((word << 5) + __builtin_ctz(m_aRdyMask[prty][word]));
+    _FCS_TASK_SCHDLR_rdyClear(idx);
+
+    return idx;
+}
+#endif
+
+#ifdef FCS_TASK_SCHDLR_SOA_ENABLE
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_soaAdvance
+// Returns:         void
+// Param1:          ticks - Clock ticks to add to every task.
+// Description:     Adds the ticks to the elapsed time array and queues the expired
+// tasks in one pass over the timing arrays, up to the highest task ID assigned so
+// far. Words of 32 IDs without a priority task are skipped, so their idle task
+// slots do not count elapsed ticks, as in the linear scan. The comparisons are
+// turned into mask bits without branching, in an inner loop the compiler can unroll
+// or vectorize. Idle and unused slots in a word also get bits, which the priority
+// level masks filter out.
+//***************************************************************************
+static void _FCS_TASK_SCHDLR_soaAdvance(uint32_t ticks)
+{
+    uint32_t *pElaps;
+    const uint32_t *pIntvl;
+    uint32_t nDue;
+    uint32_t nRdy;
+    uint32_t nUsed;
+    uint8_t nBits;
+    uint8_t word;
+    uint8_t bit;
+    uint8_t prty;
+
+    for(word = 0; word < ((m_nSoaSlots + 31) >> 5); word++)
+    {
+        nUsed = 0;
+
+        for(prty = FCS_TASKPRIORITY_Low; prty <= FCS_TASKPRIORITY_Critical; prty++)
+        {
+            nUsed |= m_aPrtyMask[prty][word];
+        }
+
+        if(nUsed == 0)
+        {
+            continue;
+        }
+
+        // The last word ends at the highest ID assigned.
+        nBits = ((m_nSoaSlots - (word << 5)) < 32) ? (uint8_t) (m_nSoaSlots - (word << 5)) : 32;
+        pElaps = &m_aElapsTcks[word << 5];
+        pIntvl = &m_aIntvlTcks[word << 5];
+        nDue = 0;
+
+        for(bit = 0; bit < nBits; bit++)
+        {
+            pElaps[bit] += ticks;
+            nDue |= (uint32_t) (pElaps[bit] >= pIntvl[bit]) << bit;
+        }
+
+        for(prty = FCS_TASKPRIORITY_Low; prty <= FCS_TASKPRIORITY_Critical; prty++)
+        {
+            nRdy = nDue & m_aPrtyMask[prty][word];
+
+            if(nRdy != 0)
+            {
+                m_aRdyMask[prty][word] |= nRdy;
+                m_nRdyLvls |= (1UL << prty);
+            }
+        }
+    }
+}
+#elif defined(RDY_QUEUE)
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_rdyAdvance
+// Returns:         void
+// Param1:          ticks - Clock ticks to add to every priority task.
+// Description:     Adds the ticks to each priority task's elapsed ticks and queues
+// the expired tasks in the ready bitmap of their level.
+//***************************************************************************
+static void _FCS_TASK_SCHDLR_rdyAdvance(uint32_t ticks)
+{
+    uint8_t prty;
+    uint8_t idx;
+
+    for(prty = FCS_TASKPRIORITY_Low; prty <= FCS_TASKPRIORITY_Critical; prty++)
+    {
+        for(idx = m_aPrtyHead[prty]; idx != TASK_NULL_IDX; idx = m_pTaskLst[idx].nPrtyNext)
+        {
+            m_pTaskLst[idx].nElapsTcks += ticks;
+
+            if(m_pTaskLst[idx].nElapsTcks >= m_pTaskLst[idx].nIntvlTcks)
+            {
+                m_aRdyMask[prty][idx >> 5] |= (1UL << (idx & 31));
+                m_nRdyLvls |= (1UL << prty);
+            }
+        }
+    }
+}
+#endif
+
+#ifdef FCS_TASK_SCHDLR_WHEEL_ENABLE
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_wheelIntvl
+// Returns:         Effective dispatch interval in ticks.
+// Param1:          *pTask - Task to get the interval of.
+// Description:     Intervals of 0 and 1 both dispatch the task on every tick.
+//***************************************************************************
+static uint32_t _FCS_TASK_SCHDLR_wheelIntvl(const FCS_Task_t *pTask)
+{
+    return (pTask->nIntvlTcks > 0) ? pTask->nIntvlTcks : 1;
+}
+
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_wheelInsert
+// Returns:         void
+// Param1:          idx - Slot of the task to insert.
+// Description:     Files a task in the wheel slot matching its release tick. The
+// lowest level whose span covers the remaining ticks is used. Releases beyond the
+// wheel horizon are parked in the top level and refiled as the wheel turns.
+//***************************************************************************
+static void _FCS_TASK_SCHDLR_wheelInsert(uint8_t idx)
+{
+    FCS_Task_t *pTask = &m_pTaskLst[idx];
+    uint32_t nDelta;
+    uint32_t nSlotTck;
+    uint8_t lvl;
+    uint8_t slot;
+
+    nDelta = pTask->nRlsTck - m_nWheelTck;
+    nSlotTck = pTask->nRlsTck;
+
+    if(nDelta > WHEEL_MAX_DELTA)
+    {
+        // Beyond the horizon. Park in the furthest top level slot.
+        nDelta = WHEEL_MAX_DELTA;
+        nSlotTck = m_nWheelTck + WHEEL_MAX_DELTA;
+    }
+
+    // Find the lowest level spanning the remaining ticks.
+    for(lvl = 0; (lvl < (WHEEL_LVLS - 1)) && ((nDelta >> (WHEEL_LVL_BITS * (lvl + 1))) != 0); lvl++)
+    {
+        (void) 0;
+    }
+
+    slot = (uint8_t) ((nSlotTck >> (WHEEL_LVL_BITS * lvl)) & WHEEL_SLOT_MASK);
+
+    pTask->pWheelList = &m_aWheel[lvl][slot];
+    pTask->nWheelPrev = TASK_NULL_IDX;
+    pTask->nWheelNext = m_aWheel[lvl][slot];
+
+    if(pTask->nWheelNext != TASK_NULL_IDX)
+    {
+        m_pTaskLst[pTask->nWheelNext].nWheelPrev = idx;
+    }
+
+    m_aWheel[lvl][slot] = idx;
+}
+
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_wheelUnlink
+// Returns:         void
+// Param1:          idx - Slot of the task to unlink.
+// Description:     Takes a task out of the wheel slot or ready list it is filed on.
+//***************************************************************************
+static void _FCS_TASK_SCHDLR_wheelUnlink(uint8_t idx)
+{
+    FCS_Task_t *pTask = &m_pTaskLst[idx];
+
+    if(pTask->pWheelList == NULL)
+    {
+        // Not filed.
+        return;
+    }
+
+    if(pTask->nWheelPrev == TASK_NULL_IDX)
+    {
+        *pTask->pWheelList = pTask->nWheelNext;
+    }
+    else
+    {
+        m_pTaskLst[pTask->nWheelPrev].nWheelNext = pTask->nWheelNext;
+    }
+
+    if(pTask->nWheelNext != TASK_NULL_IDX)
+    {
+        m_pTaskLst[pTask->nWheelNext].nWheelPrev = pTask->nWheelPrev;
+    }
+    else if((pTask->pWheelList >= &m_aRdyHead[0])
+            && (pTask->pWheelList < &m_aRdyHead[TASK_PRTY_LVLS]))
+    {
+        // Last task of a ready list.
+        m_aRdyTail[pTask->pWheelList - &m_aRdyHead[0]] = pTask->nWheelPrev;
+    }
+    else
+    {
+        (void) 0;
+    }
+
+    pTask->nWheelNext = TASK_NULL_IDX;
+    pTask->nWheelPrev = TASK_NULL_IDX;
+    pTask->pWheelList = NULL;
+}
+
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_wheelQueueReady
+// Returns:         void
+// Param1:          idx - Slot of the released task.
+// Description:     Appends a released task to the ready list of its priority level.
+//***************************************************************************
+static void _FCS_TASK_SCHDLR_wheelQueueReady(uint8_t idx)
+{
+    FCS_Task_t *pTask = &m_pTaskLst[idx];
+
+    pTask->pWheelList = &m_aRdyHead[pTask->priority];
+    pTask->nWheelNext = TASK_NULL_IDX;
+    pTask->nWheelPrev = m_aRdyTail[pTask->priority];
+
+    if(m_aRdyHead[pTask->priority] == TASK_NULL_IDX)
+    {
+        m_aRdyHead[pTask->priority] = idx;
+    }
+    else
+    {
+        m_pTaskLst[m_aRdyTail[pTask->priority]].nWheelNext = idx;
+    }
+
+    m_aRdyTail[pTask->priority] = idx;
+}
+
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_wheelInit
+// Returns:         void
+// Param1:          void
+// Description:     Empties every wheel slot and ready list.
+//***************************************************************************
+static void _FCS_TASK_SCHDLR_wheelInit(void)
+{
+    uint8_t lvl;
+    uint8_t slot;
+
+    m_nWheelTck = 0;
+
+    for(lvl = 0; lvl < WHEEL_LVLS; lvl++)
+    {
+        for(slot = 0; slot < WHEEL_LVL_SLOTS; slot++)
+        {
+            m_aWheel[lvl][slot] = TASK_NULL_IDX;
+        }
+    }
+
+    for(lvl = 0; lvl < TASK_PRTY_LVLS; lvl++)
+    {
+        m_aRdyHead[lvl] = TASK_NULL_IDX;
+        m_aRdyTail[lvl] = TASK_NULL_IDX;
+    }
+}
+
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_wheelAdvance
+// Returns:         void
+// Param1:          ticks - Clock ticks to advance the wheel by.
+// Description:     Turns the wheel one tick at a time. Higher level slots are
+// cascaded down when the levels below them wrap, and tasks in the expiring level 0
+// slot are moved to the ready lists.
+//***************************************************************************
+static void _FCS_TASK_SCHDLR_wheelAdvance(uint32_t ticks)
+{
+    uint8_t lvl;
+    uint8_t idx;
+    uint8_t next;
+
+    while(ticks > 0)
+    {
+        ticks--;
+        m_nWheelTck++;
+
+        // Find the highest level due for a cascade.
+        for(lvl = 0; (lvl < (WHEEL_LVLS - 1))
+                && ((m_nWheelTck & ((1UL << (WHEEL_LVL_BITS * (lvl + 1))) - 1)) == 0); lvl++)
+        {
+            (void) 0;
+        }
+
+        // Cascade from the top down so tasks settle in their final slot in one pass.
+        for((void) 0; lvl > 0; lvl--)
+        {
+            next = (uint8_t) ((m_nWheelTck >> (WHEEL_LVL_BITS * lvl)) & WHEEL_SLOT_MASK);
+            idx = m_aWheel[lvl][next];
+            m_aWheel[lvl][next] = TASK_NULL_IDX;
+
+            while(idx != TASK_NULL_IDX)
+            {
+                next = m_pTaskLst[idx].nWheelNext;
+                _FCS_TASK_SCHDLR_wheelInsert(idx);
+                idx = next;
+            }
+        }
+
+        // Release tasks in the expiring slot.
+        idx = m_aWheel[0][m_nWheelTck & WHEEL_SLOT_MASK];
+        m_aWheel[0][m_nWheelTck & WHEEL_SLOT_MASK] = TASK_NULL_IDX;
+
+        while(idx != TASK_NULL_IDX)
+        {
+            next = m_pTaskLst[idx].nWheelNext;
+
+            if(m_pTaskLst[idx].nRlsTck == m_nWheelTck)
+            {
+                _FCS_TASK_SCHDLR_wheelQueueReady(idx);
+            }
+            else
+            {
+                // Parked beyond the horizon. Refile.
+                _FCS_TASK_SCHDLR_wheelInsert(idx);
+            }
+
+            idx = next;
+        }
+    }
+}
+
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_wheelDispatch
+// Returns:         void
+// Param1:          idx - Slot of a released task at the head of its ready list.
+// Description:     Reschedules a released task according to its release mode, then
+// runs it. Rescheduling comes first since the task may update or remove itself.
+// Releases that passed while the task waited in the ready list are missed
+// activations. Catch-up tasks with releases still pending go back on the ready list.
+//***************************************************************************
+static void _FCS_TASK_SCHDLR_wheelDispatch(uint8_t idx)
+{
+    FCS_Task_t *pTask = &m_pTaskLst[idx];
+    uint32_t nIntvl = _FCS_TASK_SCHDLR_wheelIntvl(pTask);
+    uint32_t nMissed = (m_nWheelTck - pTask->nRlsTck) / nIntvl;
+    uint32_t nLate = m_nWheelTck - pTask->nRlsTck;
+    bool bRun = true;
+
+    _FCS_TASK_SCHDLR_wheelUnlink(idx);
+
+    switch(pTask->release)
+    {
+        case FCS_TASKRELEASE_AbsSkip:
+            if(nMissed > 0)
+            {
+                // Drop every pending activation.
+                pTask->nMissCnt += nMissed + 1;
+                pTask->nRlsTck += (nMissed + 1) * nIntvl;
+                bRun = false;
+            }
+            else
+            {
+                pTask->nElapsTcks = m_nWheelTck - pTask->nRlsTck;
+                pTask->nRlsTck += nIntvl;
+            }
+            break;
+
+        case FCS_TASKRELEASE_AbsRunOnce:
+            if(nMissed > 0)
+            {
+                pTask->nMissCnt += nMissed;
+                pTask->bOverrun = true;
+            }
+            else
+            {
+                (void) 0;
+            }
+
+            pTask->nElapsTcks = m_nWheelTck - (pTask->nRlsTck + (nMissed * nIntvl));
+            pTask->nRlsTck += (nMissed + 1) * nIntvl;
+            nLate = pTask->nElapsTcks;
+            break;
+
+        case FCS_TASKRELEASE_AbsCatchUp:
+            if(nMissed > 0)
+            {
+                // Run late, a newer release already passed.
+                pTask->nMissCnt++;
+            }
+            else
+            {
+                (void) 0;
+            }
+
+            pTask->nElapsTcks = m_nWheelTck - pTask->nRlsTck;
+            pTask->nRlsTck += nIntvl;
+            break;
+
+        default:
+            // Restart the interval from the current tick.
+            pTask->nMissCnt += nMissed;
+            pTask->nElapsTcks = m_nWheelTck - (pTask->nRlsTck - nIntvl);
+            pTask->nRlsTck = m_nWheelTck + nIntvl;
+            break;
+    }
+
+    if((int32_t) (m_nWheelTck - pTask->nRlsTck) >= 0)
+    {
+        // Next release already passed.
+        _FCS_TASK_SCHDLR_wheelQueueReady(idx);
+    }
+    else
+    {
+        _FCS_TASK_SCHDLR_wheelInsert(idx);
+    }
+
+    if(bRun)
+    {
+        _FCS_TASK_SCHDLR_runTask(pTask, nLate);
+    }
+    else
+    {
+        (void) 0;
+    }
+}
+
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_wheelHasReady
+// Returns:         True if released tasks are waiting to be dispatched.
+// Param1:          void
+// Description:     Checks the ready list of each priority level.
+//***************************************************************************
+static bool _FCS_TASK_SCHDLR_wheelHasReady(void)
+{
+    uint8_t prty;
+
+    for(prty = FCS_TASKPRIORITY_Low; prty < TASK_PRTY_LVLS; prty++)
+    {
+        if(m_aRdyHead[prty] != TASK_NULL_IDX)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_wheelRunNext
+// Returns:         void
+// Param1:          void
+// Description:     Runs the first released task of the highest priority level that
+// has one. One task at a time, so ticks are taken between tasks and newer releases of
+// a higher level go ahead of the rest of a lower level.
+//***************************************************************************
+static void _FCS_TASK_SCHDLR_wheelRunNext(void)
+{
+    uint8_t prty;
+
+    for(prty = FCS_TASKPRIORITY_Critical; prty > FCS_TASKPRIORITY_Idle; prty--)
+    {
+        if(m_aRdyHead[prty] != TASK_NULL_IDX)
+        {
+            _FCS_TASK_SCHDLR_wheelDispatch(m_aRdyHead[prty]);
+            return;
+        }
+    }
+}
+
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_wheelIdleTicks
+// Returns:         Ticks until the wheel next has work to do.
+// Param1:          void
+// Description:     Finds the first occupied slot ahead of the current tick on each
+// level. A level 0 slot gives the exact release tick. A higher level slot gives the
+// tick it is cascaded at, which is never later than the releases filed in it.
+//***************************************************************************
+static uint32_t _FCS_TASK_SCHDLR_wheelIdleTicks(void)
+{
+    uint32_t nIdle = FCS_TASK_SCHDLR_IDLE_FOREVER;
+    uint32_t nBase;
+    uint32_t nDelta;
+    uint32_t step;
+    uint8_t lvl;
+
+    if(_FCS_TASK_SCHDLR_wheelHasReady())
+    {
+        // Released tasks are waiting to be dispatched.
+        return 0;
+    }
+
+    for(lvl = 0; lvl < WHEEL_LVLS; lvl++)
+    {
+        nBase = m_nWheelTck >> (WHEEL_LVL_BITS * lvl);
+
+        for(step = 1; step <= WHEEL_LVL_SLOTS; step++)
+        {
+            if(m_aWheel[lvl][(nBase + step) & WHEEL_SLOT_MASK] != TASK_NULL_IDX)
+            {
+                // Ticks until the slot is reached.
+                nDelta = ((nBase + step) << (WHEEL_LVL_BITS * lvl)) - m_nWheelTck;
+
+                if(nDelta < nIdle)
+                {
+                    nIdle = nDelta;
+                }
+
+                break;
+            }
+        }
+    }
+
+    return nIdle;
+}
+#endif
+
+#ifdef FCS_TASK_SCHDLR_EDF_ENABLE
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_edfBefore
+// Returns:         True if task A is dispatched before task B.
+// Param1:          idxA - Slot of a released task.
+// Param2:          idxB - Slot of another released task.
+// Description:     Orders released tasks by absolute deadline. Equal deadlines
+// are broken by priority level, then by task ID.
+//***************************************************************************
+static bool _FCS_TASK_SCHDLR_edfBefore(uint8_t idxA, uint8_t idxB)
+{
+    const FCS_Task_t *pA = &m_pTaskLst[idxA];
+    const FCS_Task_t *pB = &m_pTaskLst[idxB];
+    int32_t nDiff = (int32_t) (pA->nAbsDlTck - pB->nAbsDlTck);
+
+    if(nDiff != 0)
+    {
+        // Deadlines are compared across the tick counter wrap.
+        return (nDiff < 0);
+    }
+
+    if(pA->priority != pB->priority)
+    {
+        return (pA->priority > pB->priority);
+    }
+
+    return (idxA < idxB);
+}
+
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_edfPlace
+// Returns:         void
+// Param1:          pos - Heap position.
+// Param2:          idx - Slot of the task to store there.
+// Description:     Stores a task in the heap and records its position.
+//***************************************************************************
+static void _FCS_TASK_SCHDLR_edfPlace(uint8_t pos, uint8_t idx)
+{
+    m_aEdfHeap[pos] = idx;
+    m_pTaskLst[idx].nHeapPos = pos;
+}
+
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_edfSift
+// Returns:         void
+// Param1:          pos - Heap position whose task may be out of order.
+// Description:     Restores the heap order by moving the task at a position up
+// towards the root or down towards the leaves.
+//***************************************************************************
+static void _FCS_TASK_SCHDLR_edfSift(uint8_t pos)
+{
+    uint8_t idx = m_aEdfHeap[pos];
+    uint8_t nChild;
+
+    // Move up while the parent is due later.
+    while((pos > 0) && _FCS_TASK_SCHDLR_edfBefore(idx, m_aEdfHeap[(pos - 1) / 2]))
+    {
+        _FCS_TASK_SCHDLR_edfPlace(pos, m_aEdfHeap[(pos - 1) / 2]);
+        pos = (pos - 1) / 2;
+    }
+
+    // Move down while a child is due earlier.
+    while(((2 * pos) + 1) < m_nEdfCnt)
+    {
+        nChild = (2 * pos) + 1;
+
+        if(((nChild + 1) < m_nEdfCnt)
+                && _FCS_TASK_SCHDLR_edfBefore(m_aEdfHeap[nChild + 1], m_aEdfHeap[nChild]))
+        {
+            nChild++;
+        }
+
+        if(!_FCS_TASK_SCHDLR_edfBefore(m_aEdfHeap[nChild], idx))
+        {
+            break;
+        }
+
+        _FCS_TASK_SCHDLR_edfPlace(pos, m_aEdfHeap[nChild]);
+        pos = nChild;
+    }
+
+    _FCS_TASK_SCHDLR_edfPlace(pos, idx);
+}
+
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_edfPush
+// Returns:         void
+// Param1:          idx - Slot of a task whose interval has expired.
+// Description:     Queues a released task. Its absolute deadline is the tick of
+// its earliest pending release plus its relative deadline.
+//***************************************************************************
+static void _FCS_TASK_SCHDLR_edfPush(uint8_t idx)
+{
+    FCS_Task_t *pTask = &m_pTaskLst[idx];
+    uint32_t nIntvl = (pTask->nIntvlTcks > 0) ? pTask->nIntvlTcks : 1;
+
+    pTask->nAbsDlTck = (m_nTickSeen - (pTask->nElapsTcks - nIntvl))
+            + ((pTask->nDlTcks > 0) ? pTask->nDlTcks : nIntvl);
+
+    _FCS_TASK_SCHDLR_edfPlace(m_nEdfCnt, idx);
+    m_nEdfCnt++;
+    _FCS_TASK_SCHDLR_edfSift(m_nEdfCnt - 1);
+}
+
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_edfUnlink
+// Returns:         void
+// Param1:          idx - Slot of the task to unlink.
+// Description:     Removes a task from the heap if it is queued.
+//***************************************************************************
+static void _FCS_TASK_SCHDLR_edfUnlink(uint8_t idx)
+{
+    uint8_t pos = m_pTaskLst[idx].nHeapPos;
+
+    if(pos == TASK_NULL_IDX)
+    {
+        // Not released.
+        return;
+    }
+
+    m_pTaskLst[idx].nHeapPos = TASK_NULL_IDX;
+    m_nEdfCnt--;
+
+    if(pos < m_nEdfCnt)
+    {
+        // Fill the gap with the last task.
+        _FCS_TASK_SCHDLR_edfPlace(pos, m_aEdfHeap[m_nEdfCnt]);
+        _FCS_TASK_SCHDLR_edfSift(pos);
+    }
+}
+
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_edfAdvance
+// Returns:         void
+// Param1:          ticks - Clock ticks to add.
+// Description:     Adds the ticks to every priority task and queues the tasks
+// whose interval expired. Queued tasks keep counting, so a late dispatch still sees
+// its missed activations.
+//***************************************************************************
+static void _FCS_TASK_SCHDLR_edfAdvance(uint32_t ticks)
+{
+    FCS_Task_t *pTask;
+    uint8_t prty;
+    uint8_t idx;
+
+    for(prty = FCS_TASKPRIORITY_Low; prty <= FCS_TASKPRIORITY_Critical; prty++)
+    {
+        for(idx = m_aPrtyHead[prty]; idx != TASK_NULL_IDX; idx = pTask->nPrtyNext)
+        {
+            pTask = &m_pTaskLst[idx];
+            pTask->nElapsTcks += ticks;
+
+            if((pTask->nElapsTcks >= pTask->nIntvlTcks) && (pTask->nHeapPos == TASK_NULL_IDX))
+            {
+                _FCS_TASK_SCHDLR_edfPush(idx);
+            }
+        }
+    }
+}
+
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_edfDispatch
+// Returns:         void
+// Param1:          void
+// Description:     Runs the released tasks earliest deadline first. Stops once
+// further ticks arrive, since they may release a task with an earlier deadline.
+// Tasks left queued run after the next tick pass.
+//***************************************************************************
+static void _FCS_TASK_SCHDLR_edfDispatch(void)
+{
+    uint8_t idx;
+
+    while((m_nEdfCnt > 0) && (m_nTickCnt == m_nTickSeen))
+    {
+        // Dequeue first, the task may update or remove itself.
+        idx = m_aEdfHeap[0];
+        _FCS_TASK_SCHDLR_edfUnlink(idx);
+        _FCS_TASK_SCHDLR_dispatchTask(idx);
+    }
+}
+#endif
+
+#ifdef FCS_TASK_SCHDLR_CYCLIC_ENABLE
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_cycAdvance
+// Returns:         void
+// Param1:          ticks - Clock ticks taken by the dispatcher.
+// Description:     Advances the cyclic executive and runs every frame started within
+// the ticks, oldest first, so a late frame still runs all of its tasks.
+//***************************************************************************
+static void _FCS_TASK_SCHDLR_cycAdvance(uint32_t ticks)
+{
+    m_nFrmElaps += ticks;
+
+    while(m_nFrmElaps >= FCS_TASK_SCHDLR_FRAME_TCKS)
+    {
+        m_nFrmElaps -= FCS_TASK_SCHDLR_FRAME_TCKS;
+        m_nFrmIdx = ((m_nFrmIdx + 1) < FCS_TASK_SCHDLR_FRAMES) ? (m_nFrmIdx + 1) : 0;
+
+        // The frame started m_nFrmElaps ticks before the last tick taken.
+        _FCS_TASK_SCHDLR_cycDispatch(m_nFrmElaps);
+    }
+}
+
+//***************************************************************************
+// Function Name:   _FCS_TASK_SCHDLR_cycDispatch
+// Returns:         void
+// Param1:          nLateTcks - Ticks between the frame's start and the last tick
+//                  taken by the dispatcher.
+// Description:     Runs the tasks of the current frame in table order. The frame's
+// start counts as the release of each run.
+//***************************************************************************
+static void _FCS_TASK_SCHDLR_cycDispatch(uint32_t nLateTcks)
+{
+    FCS_Task_t *pTask;
+    uint16_t slot;
+
+    m_nFrmTck = m_nTickSeen - nLateTcks;
+
+    for(slot = m_aFrmStart[m_nFrmIdx]; slot < m_aFrmStart[m_nFrmIdx + 1]; slot++)
+    {
+        pTask = &m_pTaskLst[m_aFrmTasks[slot]];
+
+        if((pTask->priority != FCS_TASKPRIORITY_Idle)
+                && (pTask->priority != FCS_TASKPRIORITY_Immediate))
+        {
+            // Tasks without an argument get the ticks since their previous frame.
+            pTask->nElapsTcks = m_nFrmTck - pTask->nFrmTck;
+            pTask->nFrmTck = m_nFrmTck;
+            _FCS_TASK_SCHDLR_runTask(pTask, m_nTickSeen - m_nFrmTck);
+        }
+        else
+        {
+            // Removed or moved out of the frame table's reach.
+            (void) 0;
+        }
+    }
+}
+#endif
+
+//**************
+// Global Functions
+//**************
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_init
+// Returns:         void
+// Param1:          *pTaskLst - Task list (array) to operate on.
+// Param2:          maxTaskCnt - Max amount of tasks supported by task list.
+// Description:     Initializes the scheduler and task list.
+//***************************************************************************
+void FCS_TASK_SCHDLR_init(FCS_Task_t *pTaskLst, uint8_t nMaxTasks)
+{
+    uint8_t idx;
+
+    // Initialize scheduler. The task list may not exceed the handle tables, which
+    // cover any uint8_t count at the maximum size. The static table's count is an
+    // enum constant, which the preprocessor reads as 0, so it keeps the check.
+#if FCS_TASK_SCHDLR_MAX_TASKS < 255
+    if(nMaxTasks > FCS_TASK_SCHDLR_MAX_TASKS)
+    {
+        nMaxTasks = FCS_TASK_SCHDLR_MAX_TASKS;
+    }
+#endif
+
+    m_nTickSeen = m_nTickCnt;
+    m_nTickOvrs = 0;
+#if defined(FCS_TASK_SCHDLR_IDLE_BUDGET_ENABLE) || !defined(FCS_TASK_SCHDLR_PROFILE_DISABLE) \
+        || defined(FCS_TASK_SCHDLR_LOAD_ENABLE)
+    FCS_TASK_SCHDLR_PORT_CYCLES_INIT();
+#endif
+#ifdef FCS_TASK_SCHDLR_LOAD_ENABLE
+    m_bLoadBusy = false;
+    m_nLoadSpanCyc = 0;
+    m_nLoadIdleCyc = 0;
+    m_nLoadSecCyc = 0;
+    m_nLoadSecIdleCyc = 0;
+    m_nLoadSecTcks = 0;
+    m_nLoadPeakCyc = 0;
+    m_nLoadSecNext = 0;
+    m_nLoadSecCnt = 0;
+#endif
+#ifdef FCS_TASK_SCHDLR_IMMEDIATE_ENABLE
+    m_nImmTickSeen = m_nTickCnt;
+    FCS_TASK_SCHDLR_PORT_SET_IMMEDIATE_PRIO(FCS_TASK_SCHDLR_IMMEDIATE_PRIO);
+#endif
+    m_nMaxTasks = nMaxTasks;
+    m_nPrtyTasks = 0;
+    m_nIdleTasks = 0;
+    m_nIdleNext = TASK_NULL_IDX;
+    m_pTaskLst = pTaskLst;
+
+    for(idx = 0; idx < TASK_PRTY_LVLS; idx++)
+    {
+        m_aPrtyHead[idx] = TASK_NULL_IDX;
+        m_aPrtyTail[idx] = TASK_NULL_IDX;
+    }
+
+    // Initialize task list. Each slot's ID is fixed, lowest IDs are assigned first.
+    m_nFreeIds = 0;
+
+    for(idx = m_nMaxTasks; idx > 0; idx--)
+    {
+        _FCS_TASK_SCHDLR_initTask(&m_pTaskLst[idx - 1]);
+        m_pTaskLst[idx - 1].id = idx - 1;
+        m_aTaskGen[idx - 1] = 1;
+        m_aFreeIds[m_nFreeIds++] = idx - 1;
+    }
+
+    // Clear the signals.
+    m_nSigLvls = 0;
+
+    for(idx = 0; idx < (TASK_PRTY_LVLS * TASK_MASK_WORDS); idx++)
+    {
+        m_aSigMask[idx / TASK_MASK_WORDS][idx % TASK_MASK_WORDS] = 0;
+    }
+
+#ifdef RDY_QUEUE
+    // Empty the ready queue.
+    m_nRdyLvls = 0;
+
+    for(idx = 0; idx < (TASK_PRTY_LVLS * TASK_MASK_WORDS); idx++)
+    {
+        m_aRdyMask[idx / TASK_MASK_WORDS][idx % TASK_MASK_WORDS] = 0;
+    }
+#endif
+
+#ifdef FCS_TASK_SCHDLR_SOA_ENABLE
+    // Initialize the timing arrays. Slots past the task list are never linked.
+    m_nSoaSlots = 0;
+
+    for(idx = 0; idx < (TASK_PRTY_LVLS * SOA_WORDS); idx++)
+    {
+        m_aPrtyMask[idx / SOA_WORDS][idx % SOA_WORDS] = 0;
+    }
+#endif
+
+#ifdef FCS_TASK_SCHDLR_WHEEL_ENABLE
+    // Initialize the timing wheel.
+    _FCS_TASK_SCHDLR_wheelInit();
+#endif
+
+#ifdef FCS_TASK_SCHDLR_EDF_ENABLE
+    m_nEdfCnt = 0;
+#endif
+
+#ifdef FCS_TASK_SCHDLR_CYCLIC_ENABLE
+    // The first tick taken by the dispatcher starts frame 0.
+    m_nFrmIdx = FCS_TASK_SCHDLR_FRAMES - 1;
+    m_nFrmElaps = FCS_TASK_SCHDLR_FRAME_TCKS - 1;
+#endif
+
+    m_pfnFaultPolicy = NULL;
+
+#ifndef FCS_TASK_SCHDLR_STATIC_ENABLE
+    m_bAutoStagger = false;
+#endif
+
+#ifdef _DEBUG_ENABLE
+    m_pfnTimingStart = NULL;
+    m_pfnTimingStop = NULL;
+#endif
+
+#ifdef FCS_TASK_SCHDLR_STATIC_ENABLE
+    // Add every task of the static table. IDs are the table positions, so none are
+    // left to assign.
+    m_nFreeIds = 0;
+
+    for(idx = 0; idx < m_nMaxTasks; idx++)
+    {
+        _FCS_TASK_SCHDLR_linkTask(idx, m_aTaskDesc[idx].nIntvlTcks, m_aTaskDesc[idx].priority);
+    }
+#endif
+}
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_clockTick
+// Returns:         void
+// Param1:          void
+// Description:     Increments the scheduler's clock tick counter. A hardware
+// timer is required to call this function at the desired tick frequency.
+// Ticks may only be added from one context at a time, normally the timer's ISR.
+//***************************************************************************
+void FCS_TASK_SCHDLR_clockTick(void)
+{
+    if(m_nTickCnt != m_nTickSeen)
+    {
+        // The dispatcher has not caught up with the previous tick.
+        m_nTickOvrs++;
+    }
+
+    // Increment the clock tick counter.
+    m_nTickCnt++;
+
+#ifdef FCS_TASK_SCHDLR_IMMEDIATE_ENABLE
+    if(m_aPrtyHead[FCS_TASKPRIORITY_Immediate] != TASK_NULL_IDX)
+    {
+        // Preempt the dispatcher for the Immediate tasks.
+        FCS_TASK_SCHDLR_PORT_PEND_IMMEDIATE();
+    }
+#endif
+}
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_clockTicks
+// Returns:         void
+// Param1:          nTicks - Clock ticks to add.
+// Description:     Adds several clock ticks at once. Used by timers that are
+// reprogrammed to interrupt less often than once per tick.
+// Ticks may only be added from one context at a time, normally the timer's ISR.
+//***************************************************************************
+void FCS_TASK_SCHDLR_clockTicks(uint32_t nTicks)
+{
+    if(m_nTickCnt != m_nTickSeen)
+    {
+        // The dispatcher has not caught up with the previous ticks.
+        m_nTickOvrs++;
+    }
+
+    // Add to the clock tick counter.
+    m_nTickCnt += nTicks;
+
+#ifdef FCS_TASK_SCHDLR_IMMEDIATE_ENABLE
+    if(m_aPrtyHead[FCS_TASKPRIORITY_Immediate] != TASK_NULL_IDX)
+    {
+        // Preempt the dispatcher for the Immediate tasks.
+        FCS_TASK_SCHDLR_PORT_PEND_IMMEDIATE();
+    }
+#endif
+}
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_now
+// Returns:         Clock ticks counted since the scheduler was first initialized.
+// Param1:          void
+// Description:     Reads the free-running tick counter. The count wraps after 2^32
+// ticks, so intervals should be measured by unsigned subtraction of two readings.
+//***************************************************************************
+uint32_t FCS_TASK_SCHDLR_now(void)
+{
+    return m_nTickCnt;
+}
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_getTickOverruns
+// Returns:         Number of tick overruns.
+// Param1:          void
+// Description:     Counts the clock ticks that arrived while the dispatcher had not
+// yet taken the previous ones, i.e. while a task kept it busy for longer than a tick.
+// In tickless mode a late timer span is counted the same way.
+//***************************************************************************
+uint32_t FCS_TASK_SCHDLR_getTickOverruns(void)
+{
+    return m_nTickOvrs;
+}
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_getIdleTicks
+// Returns:         Ticks until the earliest priority task is due, 0 if ticks or
+//                  signaled tasks are waiting to be processed or
+//                  FCS_TASK_SCHDLR_IDLE_FOREVER if there are no priority tasks.
+// Param1:          void
+// Description:     Computes the number of clock ticks the scheduler can go without
+// dispatching a priority task. The timing wheel may report an earlier tick at which
+// its higher levels need cascading.
+//***************************************************************************
+uint32_t FCS_TASK_SCHDLR_getIdleTicks(void)
+{
+    uint32_t nIdle = FCS_TASK_SCHDLR_IDLE_FOREVER;
+    uint32_t nDue;
+#if (!defined(FCS_TASK_SCHDLR_WHEEL_ENABLE) && !defined(FCS_TASK_SCHDLR_CYCLIC_ENABLE)) \
+        || defined(FCS_TASK_SCHDLR_IMMEDIATE_ENABLE)
+    uint8_t idx;
+#endif
+#if !defined(FCS_TASK_SCHDLR_WHEEL_ENABLE) && !defined(FCS_TASK_SCHDLR_CYCLIC_ENABLE)
+    uint8_t prty;
+#endif
+
+    if((m_nTickCnt != m_nTickSeen) || (m_nSigLvls != 0))
+    {
+        // Ticks or signaled tasks are waiting to be processed.
+        return 0;
+    }
+
+#ifdef RDY_QUEUE
+    if(m_nRdyLvls != 0)
+    {
+        // Released tasks are waiting to run.
+        return 0;
+    }
+#endif
+
+#ifdef FCS_TASK_SCHDLR_WATCHDOG_ENABLE
+    if(m_pfnWdogRefresh != NULL)
+    {
+        // Wake up for the next heartbeat check, or the watchdog would expire.
+        nDue = m_nTickCnt - m_nWdogTck;
+        nIdle = (nDue < m_nWdogPeriodTcks) ? (m_nWdogPeriodTcks - nDue) : 1;
+    }
+#endif
+
+#ifdef FCS_TASK_SCHDLR_IMMEDIATE_ENABLE
+    // Immediate tasks are released from the tick interrupt, so the timer has to wake
+    // up for them as well.
+    for(idx = m_aPrtyHead[FCS_TASKPRIORITY_Immediate]; idx != TASK_NULL_IDX;
+            idx = m_pTaskLst[idx].nPrtyNext)
+    {
+        if(m_pTaskLst[idx].nElapsTcks >= m_pTaskLst[idx].nIntvlTcks)
+        {
+            nDue = 1;
+        }
+        else
+        {
+            nDue = m_pTaskLst[idx].nIntvlTcks - m_pTaskLst[idx].nElapsTcks;
+        }
+
+        if(nDue < nIdle)
+        {
+            nIdle = nDue;
+        }
+    }
+#endif
+
+#ifdef FCS_TASK_SCHDLR_WHEEL_ENABLE
+    nDue = _FCS_TASK_SCHDLR_wheelIdleTicks();
+
+    if(nDue < nIdle)
+    {
+        nIdle = nDue;
+    }
+
+    return nIdle;
+#elif defined(FCS_TASK_SCHDLR_CYCLIC_ENABLE)
+    // The next frame starts on a fixed tick, whether or not it runs a task.
+    nDue = FCS_TASK_SCHDLR_FRAME_TCKS - m_nFrmElaps;
+
+    if(nDue < nIdle)
+    {
+        nIdle = nDue;
+    }
+
+    return nIdle;
+#else
+    for(prty = FCS_TASKPRIORITY_Low; prty <= FCS_TASKPRIORITY_Critical; prty++)
+    {
+        for(idx = m_aPrtyHead[prty]; idx != TASK_NULL_IDX; idx = m_pTaskLst[idx].nPrtyNext)
+        {
+            // A task is only dispatched on a tick, even if its interval already expired.
+            if(TASK_ELAPS(idx) >= TASK_INTVL(idx))
+            {
+                nDue = 1;
+            }
+            else
+            {
+                nDue = TASK_INTVL(idx) - TASK_ELAPS(idx);
+            }
+
+            if(nDue < nIdle)
+            {
+                nIdle = nDue;
+            }
+        }
+    }
+
+    return nIdle;
+#endif
+}
+
+#ifndef FCS_TASK_SCHDLR_STATIC_ENABLE
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_addTask
+// Returns:         Handle of the new task or FCS_TASK_SCHDLR_INVALID_HANDLE if the
+//                  task could not be added.
+// Param1:          taskCode - Points to task's executable code.
+// Param2:          *pTaskArg - Optional argument passed to task's code.
+// Param3:          intvlTicks - Dispatch interval.
+// Param4:          priority - Priority level.
+// Description:     Adds a new task to the task list. The function call
+// representing the task's executable code will be called with the optional
+// argument if one is provided.
+//***************************************************************************
+FCS_TaskHandle_t FCS_TASK_SCHDLR_addTask(FCS_TaskCode_t taskCode, void *pTaskArg,
+        uint32_t intvlTicks, FCS_TaskPriority_e priority)
+{
+    FCS_Task_t *pTask;
+    uint32_t nTempTicks;
+    FCS_TaskID_t id;
+
+    if(!_FCS_TASK_SCHDLR_validateArguments(taskCode, pTaskArg))
+    {
+        // Invalid arguments.
+        return FCS_TASK_SCHDLR_INVALID_HANDLE;
+    }
+
+    if((unsigned int) priority > TASK_PRTY_MAX)
+    {
+        // Unexpected priority assignment.
+        return FCS_TASK_SCHDLR_INVALID_HANDLE;
+    }
+
+    // Search for existing task with same code and argument.
+    if(_FCS_TASK_SCHDLR_getTask(taskCode, pTaskArg) != NULL)
+    {
+        // Task already exists.
+        return FCS_TASK_SCHDLR_INVALID_HANDLE;
+    }
+
+    // Check if task list is already full.
+    if(m_nFreeIds == 0)
+    {
+        // Task list is full. Failed to add new task.
+        return FCS_TASK_SCHDLR_INVALID_HANDLE;
+    }
+
+    // Update existing priority tasks' elapsed times before adding the new task.
+    nTempTicks = _FCS_TASK_SCHDLR_takeTicks();
+
+    if(nTempTicks > 0)
+    {
+#ifdef FCS_TASK_SCHDLR_WHEEL_ENABLE
+        // Released tasks are queued for the dispatcher's next pass.
+        _FCS_TASK_SCHDLR_wheelAdvance(nTempTicks);
+#elif defined(FCS_TASK_SCHDLR_SOA_ENABLE)
+        // Expired tasks are queued for the dispatcher.
+        _FCS_TASK_SCHDLR_soaAdvance(nTempTicks);
+#elif defined(FCS_TASK_SCHDLR_EDF_ENABLE)
+        // Released tasks are queued on the deadline heap for the dispatcher.
+        _FCS_TASK_SCHDLR_edfAdvance(nTempTicks);
+#elif defined(RDY_QUEUE)
+        _FCS_TASK_SCHDLR_rdyAdvance(nTempTicks);
+#endif
+    }
+
+    // Take the most recently freed slot, or the lowest one never used if none was
+    // freed. Its ID is the slot index.
+    id = m_aFreeIds[--m_nFreeIds];
+    pTask = &m_pTaskLst[id];
+
+    pTask->code = taskCode;
+    pTask->pArg = pTaskArg;
+
+    _FCS_TASK_SCHDLR_linkTask(id, intvlTicks, priority);
+
+    if(m_bAutoStagger && (priority != FCS_TASKPRIORITY_Idle))
+    {
+        // Release the task on the least loaded ticks instead of with the tasks added
+        // before it.
+        _FCS_TASK_SCHDLR_stagger(pTask);
+    }
+
+    // Task successfully added.
+    return (FCS_TaskHandle_t) (((FCS_TaskHandle_t) m_aTaskGen[id] << 8) | id);
+}
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_removeTask
+// Returns:         Success status of task removal.
+// Param1:          task - Task to remove.
+// Description:     Removes a task from the task list.
+//***************************************************************************
+bool FCS_TASK_SCHDLR_removeTask(FCS_Task_t task)
+{
+    FCS_Task_t *pTask;
+
+    // Search for task in the task list.
+    pTask = _FCS_TASK_SCHDLR_getTask(task.code, task.pArg);
+
+    if(pTask == NULL)
+    {
+        // Task not found.
+        return false;
+    }
+
+    return _FCS_TASK_SCHDLR_removeTask(pTask);
+}
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_updateTask
+// Returns:         Success status of task update.
+// Param1:          task - Copy of original task structure.
+// Param2:          intvlTicks - Dispatch interval.
+// Param3:          priority - Priority level.
+// Description:     Updates an existing task's dispatch interval and priority level.
+//***************************************************************************
+bool FCS_TASK_SCHDLR_updateTask(FCS_Task_t task, uint32_t intvlTicks, FCS_TaskPriority_e priority)
+{
+    FCS_Task_t *pTask;
+
+    // Search for task in the task list.
+    pTask = _FCS_TASK_SCHDLR_getTask(task.code, task.pArg);
+
+    if(pTask != NULL)
+    {
+        // Task found. Update the priority and interval ticks.
+        return _FCS_TASK_SCHDLR_updateTask(pTask, intvlTicks, priority);
+    }
+    else
+    {
+        // Task not found.
+        return false;
+    }
+}
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_getTask
+// Returns:         Copy of task structure.
+// Param1:          taskCode - Points to code associated with the task.
+// Param2:          *pTaskArg - Optional argument passed to task's code.
+// Description:     Retrieves a copy of the task structure associated with the code
+// and optional argument.
+//***************************************************************************
+FCS_Task_t FCS_TASK_SCHDLR_getTask(FCS_TaskCode_t taskCode, void *pTaskArg)
+{
+    FCS_Task_t *pTask = _FCS_TASK_SCHDLR_getTask(taskCode, pTaskArg);
+
+#ifdef FCS_TASK_SCHDLR_SOA_ENABLE
+    if(pTask->priority != FCS_TASKPRIORITY_Immediate)
+    {
+        // Copy the elapsed ticks out of the timing array.
+        pTask->nElapsTcks = m_aElapsTcks[pTask->id];
+    }
+#endif
+
+    return *pTask;
+}
+#endif
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_removeTaskHndl
+// Returns:         Success status of task removal.
+// Param1:          hTask - Handle of task to remove.
+// Description:     Removes a task from the task list. The handle is resolved in
+// constant time and is invalid afterwards.
+//***************************************************************************
+bool FCS_TASK_SCHDLR_removeTaskHndl(FCS_TaskHandle_t hTask)
+{
+    FCS_Task_t *pTask;
+
+    pTask = _FCS_TASK_SCHDLR_getTaskHndl(hTask);
+
+    if(pTask == NULL)
+    {
+        // Stale or invalid handle.
+        return false;
+    }
+
+    return _FCS_TASK_SCHDLR_removeTask(pTask);
+}
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_updateTaskHndl
+// Returns:         Success status of task update.
+// Param1:          hTask - Handle of task to update.
+// Param2:          intvlTicks - Dispatch interval.
+// Param3:          priority - Priority level.
+// Description:     Updates an existing task's dispatch interval and priority level.
+// The handle is resolved in constant time.
+//***************************************************************************
+bool FCS_TASK_SCHDLR_updateTaskHndl(FCS_TaskHandle_t hTask, uint32_t intvlTicks,
+        FCS_TaskPriority_e priority)
+{
+    FCS_Task_t *pTask;
+
+    pTask = _FCS_TASK_SCHDLR_getTaskHndl(hTask);
+
+    if(pTask == NULL)
+    {
+        // Stale or invalid handle.
+        return false;
+    }
+
+    return _FCS_TASK_SCHDLR_updateTask(pTask, intvlTicks, priority);
+}
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_getTaskHndl
+// Returns:         Pointer to the task structure or NULL if the handle is stale.
+// Param1:          hTask - Handle of task to retrieve.
+// Description:     Retrieves the task structure associated with a handle without
+// copying it. The pointer stays valid until the task is removed.
+//***************************************************************************
+const FCS_Task_t *FCS_TASK_SCHDLR_getTaskHndl(FCS_TaskHandle_t hTask)
+{
+    FCS_Task_t *pTask = _FCS_TASK_SCHDLR_getTaskHndl(hTask);
+
+#ifdef FCS_TASK_SCHDLR_SOA_ENABLE
+    if((pTask != NULL) && (pTask->priority != FCS_TASKPRIORITY_Immediate))
+    {
+        // Copy the elapsed ticks out of the timing array.
+        pTask->nElapsTcks = m_aElapsTcks[pTask->id];
+    }
+#endif
+
+    return pTask;
+}
+
+#ifdef FCS_TASK_SCHDLR_IMMEDIATE_ENABLE
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_immediateIsr
+// Returns:         void
+// Param1:          void
+// Description:     Dispatches the Immediate tasks. Pended by the clock tick and run
+// at FCS_TASK_SCHDLR_IMMEDIATE_PRIO, preempting whichever cooperative task is
+// running. Immediate tasks always use relative release timing.
+//***************************************************************************
+void FCS_TASK_SCHDLR_immediateIsr(void)
+{
+    FCS_Task_t *pTask;
+    uint32_t nSnap = m_nTickCnt;
+    uint32_t ticks = nSnap - m_nImmTickSeen;
+    uint32_t nIntvl;
+    uint8_t idx;
+#ifndef FCS_TASK_SCHDLR_PROFILE_DISABLE
+    uint32_t nStartCyc;
+#endif
+
+    m_nImmTickSeen = nSnap;
+
+    if(ticks == 0)
+    {
+        // Pended without a new tick.
+        return;
+    }
+
+    for(idx = m_aPrtyHead[FCS_TASKPRIORITY_Immediate]; idx != TASK_NULL_IDX; idx = pTask->nPrtyNext)
+    {
+        pTask = &m_pTaskLst[idx];
+        pTask->nElapsTcks += ticks;
+
+        if(pTask->nElapsTcks >= pTask->nIntvlTcks)
+        {
+            // Releases passed beyond the one being run are missed.
+            nIntvl = (pTask->nIntvlTcks > 0) ? pTask->nIntvlTcks : 1;
+
+            if(pTask->nElapsTcks >= (2 * nIntvl))
+            {
+                pTask->nMissCnt += (pTask->nElapsTcks / nIntvl) - 1;
+            }
+
+            // Interval has expired. Run the task. Immediate tasks cannot remove
+            // themselves, so their generation is not checked.
+#ifndef FCS_TASK_SCHDLR_PROFILE_DISABLE
+            nStartCyc = _FCS_TASK_SCHDLR_profStart(idx);
+#endif
+
+            if(TASK_ARG(idx) != NULL)
+            {
+                TASK_CODE(idx).pfnHasArg(TASK_ARG(idx));
+            }
+            else
+            {
+                TASK_CODE(idx).pfnHasArg(&pTask->nElapsTcks);
+            }
+
+#ifndef FCS_TASK_SCHDLR_PROFILE_DISABLE
+            _FCS_TASK_SCHDLR_profStop(idx, m_aTaskGen[idx], nStartCyc);
+#endif
+
+#ifdef FCS_TASK_SCHDLR_WATCHDOG_ENABLE
+            if(!pTask->bHbManual)
+            {
+                pTask->nHbTck = nSnap;
+            }
+#endif
+
+            // Reset ticks elapsed.
+            pTask->nElapsTcks = 0;
+        }
+    }
+}
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_lockImmediate
+// Returns:         Lock state to pass to FCS_TASK_SCHDLR_unlockImmediate.
+// Param1:          void
+// Description:     Raises the interrupt masking ceiling to the Immediate dispatch
+// priority, keeping Immediate tasks from running until unlocked. Nests.
+//***************************************************************************
+uint32_t FCS_TASK_SCHDLR_lockImmediate(void)
+{
+    return FCS_TASK_SCHDLR_PORT_raiseBasePri(FCS_TASK_SCHDLR_IMMEDIATE_PRIO);
+}
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_unlockImmediate
+// Returns:         void
+// Param1:          nLock - State returned by the matching FCS_TASK_SCHDLR_lockImmediate.
+// Description:     Restores the interrupt masking ceiling. A tick that arrived while
+// locked dispatches the Immediate tasks on return.
+//***************************************************************************
+void FCS_TASK_SCHDLR_unlockImmediate(uint32_t nLock)
+{
+    FCS_TASK_SCHDLR_PORT_restoreBasePri(nLock);
+}
+#endif
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_idleYield
+// Returns:         True if the running idle task should return to the dispatcher.
+// Param1:          void
+// Description:     Lets long idle tasks split their work. Returns true once clock
+// ticks are waiting to be processed or the task's cycle budget is used up.
+//***************************************************************************
+bool FCS_TASK_SCHDLR_idleYield(void)
+{
+    if(m_nTickCnt != m_nTickSeen)
+    {
+        // Priority tasks may be due.
+        return true;
+    }
+
+#ifdef FCS_TASK_SCHDLR_IDLE_BUDGET_ENABLE
+    if((m_nIdleBudgetCyc > 0)
+            && ((FCS_TASK_SCHDLR_PORT_CYCLES() - m_nIdleStartCyc) >= m_nIdleBudgetCyc))
+    {
+        // Budget used up.
+        return true;
+    }
+#endif
+
+    return false;
+}
+
+#ifdef FCS_TASK_SCHDLR_IDLE_BUDGET_ENABLE
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_setIdleBudgetHndl
+// Returns:         Success status of the change.
+// Param1:          hTask - Handle of the idle task to change.
+// Param2:          nCycles - Core cycles the task may run per call, 0 for no budget.
+// Description:     Sets an idle task's cycle budget. FCS_TASK_SCHDLR_idleYield
+// reports when it is used up, and each call that runs past it is counted in the
+// task's nMissCnt.
+//***************************************************************************
+bool FCS_TASK_SCHDLR_setIdleBudgetHndl(FCS_TaskHandle_t hTask, uint32_t nCycles)
+{
+    FCS_Task_t *pTask;
+
+    pTask = _FCS_TASK_SCHDLR_getTaskHndl(hTask);
+
+    if((pTask == NULL) || (pTask->priority != FCS_TASKPRIORITY_Idle))
+    {
+        // Stale handle or not an idle task.
+        return false;
+    }
+
+    pTask->nBudgetCyc = nCycles;
+
+    return true;
+}
+#endif
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_setReleaseHndl
+// Returns:         Success status of the change.
+// Param1:          hTask - Handle of task to change.
+// Param2:          release - Release mode and overrun policy.
+// Description:     Selects how a task's releases are timed and how activations it
+// could not run on time are handled. The task's phase is not changed.
+//***************************************************************************
+bool FCS_TASK_SCHDLR_setReleaseHndl(FCS_TaskHandle_t hTask, FCS_TaskRelease_e release)
+{
+    FCS_Task_t *pTask;
+
+    pTask = _FCS_TASK_SCHDLR_getTaskHndl(hTask);
+
+    if((pTask == NULL) || ((unsigned int) release > FCS_TASKRELEASE_AbsRunOnce))
+    {
+        // Stale handle or unexpected release mode.
+        return false;
+    }
+
+    pTask->release = release;
+
+    return true;
+}
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_clearMissedHndl
+// Returns:         Success status of the change.
+// Param1:          hTask - Handle of task to change.
+// Description:     Resets a task's missed activation counter and overrun flag.
+//***************************************************************************
+bool FCS_TASK_SCHDLR_clearMissedHndl(FCS_TaskHandle_t hTask)
+{
+    FCS_Task_t *pTask;
+
+    pTask = _FCS_TASK_SCHDLR_getTaskHndl(hTask);
+
+    if(pTask == NULL)
+    {
+        // Stale or invalid handle.
+        return false;
+    }
+
+    pTask->nMissCnt = 0;
+    pTask->bOverrun = false;
+    pTask->nLateCnt = 0;
+    pTask->nOvrnCnt = 0;
+
+    return true;
+}
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_signalHndl
+// Returns:         Success status of the signal.
+// Param1:          hTask - Handle of task to signal.
+// Description:     Marks a task to run on the dispatcher's next loop iteration,
+// without waiting for its interval. Safe to call from interrupts.
+//***************************************************************************
+bool FCS_TASK_SCHDLR_signalHndl(FCS_TaskHandle_t hTask)
+{
+    FCS_Task_t *pTask;
+
+    pTask = _FCS_TASK_SCHDLR_getTaskHndl(hTask);
+
+    if(pTask == NULL)
+    {
+        // Stale or invalid handle.
+        return false;
+    }
+
+    if(!SIG_LEVEL(pTask->priority))
+    {
+        // Idle and Immediate tasks are not signaled.
+        return false;
+    }
+
+    _FCS_TASK_SCHDLR_sigSet(pTask->id);
+
+    return true;
+}
+
+#ifdef FCS_TASK_SCHDLR_EDF_ENABLE
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_setDeadlineHndl
+// Returns:         Success status of the change.
+// Param1:          hTask - Handle of task to change.
+// Param2:          nTicks - Ticks from a release until the run is due, 0 for the
+//                  task's interval.
+// Description:     Sets a task's relative deadline.
+//***************************************************************************
+bool FCS_TASK_SCHDLR_setDeadlineHndl(FCS_TaskHandle_t hTask, uint32_t nTicks)
+{
+    FCS_Task_t *pTask;
+
+    pTask = _FCS_TASK_SCHDLR_getTaskHndl(hTask);
+
+    if(pTask == NULL)
+    {
+        // Stale or invalid handle.
+        return false;
+    }
+
+    pTask->nDlTcks = nTicks;
+
+    return true;
+}
+#endif
+
+#ifndef FCS_TASK_SCHDLR_CYCLIC_ENABLE
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_setPhaseHndl
+// Returns:         Success status of the change.
+// Param1:          hTask - Handle of task to change.
+// Param2:          nPhase - Release phase in ticks, reduced modulo the interval.
+// Description:     Moves a task's releases to the ticks whose count, as returned
+// by FCS_TASK_SCHDLR_now, equals the phase modulo the task's interval. A release
+// already pending is dropped.
+//***************************************************************************
+bool FCS_TASK_SCHDLR_setPhaseHndl(FCS_TaskHandle_t hTask, uint32_t nPhase)
+{
+    FCS_Task_t *pTask;
+    uint32_t nIntvl;
+    uint32_t nNow = m_nTickSeen;
+    uint32_t nTicks;
+
+    pTask = _FCS_TASK_SCHDLR_getTaskHndl(hTask);
+
+    if((pTask == NULL) || (pTask->priority == FCS_TASKPRIORITY_Idle))
+    {
+        // Stale or invalid handle, or a task without an interval.
+        return false;
+    }
+
+#ifdef FCS_TASK_SCHDLR_IMMEDIATE_ENABLE
+    if(pTask->priority == FCS_TASKPRIORITY_Immediate)
+    {
+        // Immediate tasks count the ticks taken by their own dispatch.
+        nNow = m_nImmTickSeen;
+    }
+#endif
+
+    // Ticks until the next tick on the phase, a full interval if on it now.
+    nIntvl = (pTask->nIntvlTcks > 0) ? pTask->nIntvlTcks : 1;
+    nTicks = ((nPhase % nIntvl) + nIntvl - (nNow % nIntvl)) % nIntvl;
+
+    _FCS_TASK_SCHDLR_setReleaseIn(pTask, (nTicks > 0) ? nTicks : nIntvl);
+
+    return true;
+}
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_staggerHndl
+// Returns:         Success status of the change.
+// Param1:          hTask - Handle of task to change.
+// Description:     Moves a task's releases to the ticks least loaded by the other
+// tasks with an interval, weighted by their measured runtimes. A release already
+// pending is dropped.
+//***************************************************************************
+bool FCS_TASK_SCHDLR_staggerHndl(FCS_TaskHandle_t hTask)
+{
+    FCS_Task_t *pTask;
+
+    pTask = _FCS_TASK_SCHDLR_getTaskHndl(hTask);
+
+    if((pTask == NULL) || (pTask->priority == FCS_TASKPRIORITY_Idle))
+    {
+        // Stale or invalid handle, or a task without an interval.
+        return false;
+    }
+
+    _FCS_TASK_SCHDLR_stagger(pTask);
+
+    return true;
+}
+#endif
+
+#ifndef FCS_TASK_SCHDLR_STATIC_ENABLE
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_setAutoStagger
+// Returns:         void
+// Param1:          bEnable - Stagger each task added from now on.
+// Description:     Selects whether FCS_TASK_SCHDLR_addTask places new tasks with
+// FCS_TASK_SCHDLR_staggerHndl instead of releasing them one full interval later.
+//***************************************************************************
+void FCS_TASK_SCHDLR_setAutoStagger(bool bEnable)
+{
+    m_bAutoStagger = bEnable;
+}
+#endif
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_setLateLimitHndl
+// Returns:         Success status of the change.
+// Param1:          hTask - Handle of task to change.
+// Param2:          nTicks - Ticks the task may start after its release.
+// Description:     Sets how late a priority task may start before the run counts as
+// a fault.
+//***************************************************************************
+bool FCS_TASK_SCHDLR_setLateLimitHndl(FCS_TaskHandle_t hTask, uint32_t nTicks)
+{
+    FCS_Task_t *pTask;
+
+    pTask = _FCS_TASK_SCHDLR_getTaskHndl(hTask);
+
+    if(pTask == NULL)
+    {
+        // Stale or invalid handle.
+        return false;
+    }
+
+    pTask->nLateLimTcks = nTicks;
+
     return true;
 }
 
 //***************************************************************************
-// Function Name:   FCS_TASK_SCHDLR_updateTask
-// Returns:         Success status of task update.
-// Param1:          task - Copy of original task structure.
-// Param2:          intvlTicks - Dispatch interval.
-// Param3:          priority - Priority level.
-// Description:     Updates an existing task's dispatch interval and priority level.
+// Function Name:   FCS_TASK_SCHDLR_registerFaultCb
+// Returns:         void
+// Param1:          pfnFaultPolicy - Decides how a faulty task is handled, or NULL to
+//                  only count faults.
+// Description:     Registers the timing fault policy.
 //***************************************************************************
-bool FCS_TASK_SCHDLR_updateTask(FCS_Task_t task, uint32_t intvlTicks, FCS_TaskPriority_e priority)
+void FCS_TASK_SCHDLR_registerFaultCb(FCS_TaskFaultAction_e (*pfnFaultPolicy)(
+        FCS_TaskHandle_t hTask, FCS_TaskFault_e fault, uint32_t nTicks))
+{
+    m_pfnFaultPolicy = pfnFaultPolicy;
+}
+
+#ifndef FCS_TASK_SCHDLR_PROFILE_DISABLE
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_getProfileHndl
+// Returns:         Success status of the retrieval.
+// Param1:          hTask - Handle of task to retrieve the profile of.
+// Param2:          *pProfile - Receives a copy of the profile.
+// Description:     Retrieves a task's execution time profile.
+//***************************************************************************
+bool FCS_TASK_SCHDLR_getProfileHndl(FCS_TaskHandle_t hTask, FCS_TaskProfile_t *pProfile)
 {
     FCS_Task_t *pTask;
+#ifdef FCS_TASK_SCHDLR_IMMEDIATE_ENABLE
+    uint32_t nLock;
+#endif
 
-    // Search for task in the task list.
-    pTask = _FCS_TASK_SCHDLR_getTask(task.code, task.pArg);
+    pTask = _FCS_TASK_SCHDLR_getTaskHndl(hTask);
 
-    if(pTask != NULL)
+    if((pTask == NULL) || (pProfile == NULL))
     {
-        // Task found. Update the priority and interval ticks.
-        pTask->priority = priority;
-        pTask->nIntvlTcks = intvlTicks;
-        pTask->nElapsTcks = 0;
+        // Stale handle or nowhere to copy to.
+        return false;
+    }
 
-        // Task successfully updated.
-        return true;
+    // Immediate tasks update their profile from the interrupt.
+#ifdef FCS_TASK_SCHDLR_IMMEDIATE_ENABLE
+    nLock = FCS_TASK_SCHDLR_lockImmediate();
+    *pProfile = m_aProf[pTask->id];
+    FCS_TASK_SCHDLR_unlockImmediate(nLock);
+#else
+    *pProfile = m_aProf[pTask->id];
+#endif
+
+    if(pProfile->nRunCnt > 0)
+    {
+        pProfile->nMeanCyc = (uint32_t) (pProfile->nTotalCyc / pProfile->nRunCnt);
     }
     else
     {
-        // Task not found.
+        pProfile->nMinCyc = 0;
+    }
+
+    return true;
+}
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_clearProfileHndl
+// Returns:         Success status of the change.
+// Param1:          hTask - Handle of task to change.
+// Description:     Resets a task's execution time profile.
+//***************************************************************************
+bool FCS_TASK_SCHDLR_clearProfileHndl(FCS_TaskHandle_t hTask)
+{
+    FCS_Task_t *pTask;
+#ifdef FCS_TASK_SCHDLR_IMMEDIATE_ENABLE
+    uint32_t nLock;
+#endif
+
+    pTask = _FCS_TASK_SCHDLR_getTaskHndl(hTask);
+
+    if(pTask == NULL)
+    {
+        // Stale or invalid handle.
         return false;
     }
+
+#ifdef FCS_TASK_SCHDLR_IMMEDIATE_ENABLE
+    nLock = FCS_TASK_SCHDLR_lockImmediate();
+    _FCS_TASK_SCHDLR_profClear(pTask->id);
+    FCS_TASK_SCHDLR_unlockImmediate(nLock);
+#else
+    _FCS_TASK_SCHDLR_profClear(pTask->id);
+#endif
+
+    return true;
 }
+#endif
 
+#ifdef FCS_TASK_SCHDLR_WATCHDOG_ENABLE
 //***************************************************************************
-// Function Name:   FCS_TASK_SCHDLR_getTask
-// Returns:         Copy of task structure.
-// Param1:          taskCode - Points to code associated with the task.
-// Param2:          *pTaskArg - Optional argument passed to task's code.
-// Description:     Retrieves a copy of the task structure associated with the code
-// and optional argument.
+// Function Name:   FCS_TASK_SCHDLR_setHeartbeatHndl
+// Returns:         Success status of the change.
+// Param1:          hTask - Handle of task to change.
+// Param2:          nWindowTcks - Ticks the task may go without checking in, 0 to stop
+//                  supervising it.
+// Param3:          bManual - Only FCS_TASK_SCHDLR_checkInHndl checks in.
+// Description:     Declares a task's expected check-in rate, starting from now.
 //***************************************************************************
-FCS_Task_t FCS_TASK_SCHDLR_getTask(FCS_TaskCode_t taskCode, void *pTaskArg)
+bool FCS_TASK_SCHDLR_setHeartbeatHndl(FCS_TaskHandle_t hTask, uint32_t nWindowTcks, bool bManual)
+{
+    FCS_Task_t *pTask;
+
+    pTask = _FCS_TASK_SCHDLR_getTaskHndl(hTask);
+
+    if(pTask == NULL)
+    {
+        // Stale or invalid handle.
+        return false;
+    }
+
+    // Start the window before the supervisor can see it.
+    pTask->nHbTck = m_nTickCnt;
+    pTask->bHbManual = bManual;
+    pTask->nHbWinTcks = nWindowTcks;
+
+    return true;
+}
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_checkInHndl
+// Returns:         Success status of the check-in.
+// Param1:          hTask - Handle of task checking in.
+// Description:     Restarts a task's heartbeat window.
+//***************************************************************************
+bool FCS_TASK_SCHDLR_checkInHndl(FCS_TaskHandle_t hTask)
+{
+    FCS_Task_t *pTask;
+
+    pTask = _FCS_TASK_SCHDLR_getTaskHndl(hTask);
+
+    if(pTask == NULL)
+    {
+        // Stale or invalid handle.
+        return false;
+    }
+
+    pTask->nHbTck = m_nTickCnt;
+
+    return true;
+}
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_registerWatchdogCb
+// Returns:         void
+// Param1:          pfnRefresh - Refreshes the hardware watchdog.
+// Param2:          nPeriodTcks - Ticks between heartbeat checks, at least 1.
+// Description:     Registers the watchdog refresh and starts supervising. The first
+// check is one period from now.
+//***************************************************************************
+void FCS_TASK_SCHDLR_registerWatchdogCb(void (*pfnRefresh)(void), uint32_t nPeriodTcks)
+{
+    m_nWdogPeriodTcks = (nPeriodTcks > 0) ? nPeriodTcks : 1;
+    m_nWdogTck = m_nTickCnt;
+    m_bWdogLapsed = false;
+    m_pfnWdogRefresh = pfnRefresh;
+
+#ifdef FCS_TASK_SCHDLR_TICKLESS_ENABLE
+    m_bTickSpanStale = true;
+#endif
+}
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_watchdogIsr
+// Returns:         void
+// Param1:          void
+// Description:     Records the task being run when the watchdog times out.
+//***************************************************************************
+void FCS_TASK_SCHDLR_watchdogIsr(void)
+{
+    uint8_t idx = m_nRunIdx;
+
+    if(m_bWdogLapsed)
+    {
+        // The starved task is the cause, whatever was running since.
+        return;
+    }
+
+    _FCS_TASK_SCHDLR_wdogRecord(FCS_TASKWDOG_Hung, idx,
+            (idx != TASK_NULL_IDX) ? (m_nTickCnt - m_nRunTck) : 0);
+}
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_getWatchdogRecord
+// Returns:         True if a reset cause was recorded since the record was cleared.
+// Param1:          *pRecord - Receives the record.
+// Description:     Retrieves the task that caused a watchdog reset.
+//***************************************************************************
+bool FCS_TASK_SCHDLR_getWatchdogRecord(FCS_TaskWdogRecord_t *pRecord)
+{
+    if(m_nWdogRecChk != _FCS_TASK_SCHDLR_wdogRecChk())
+    {
+        return false;
+    }
+
+    *pRecord = m_wdogRec;
+
+    return true;
+}
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_clearWatchdogRecord
+// Returns:         void
+// Param1:          void
+// Description:     Discards the reset cause record.
+//***************************************************************************
+void FCS_TASK_SCHDLR_clearWatchdogRecord(void)
+{
+    m_nWdogRecChk = ~_FCS_TASK_SCHDLR_wdogRecChk();
+}
+#endif
+
+#ifdef FCS_TASK_SCHDLR_SLEEP_ENABLE
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_registerSleepCb
+// Returns:         Success status, false for too many modes.
+// Param1:          pfnSleep - Sleeps in the given mode.
+// Param2:          *pnLatencyUs - Expected wake-up latency of each mode.
+// Param3:          nModes - Number of modes, shallowest first.
+// Description:     Registers the sleep callback and restarts the mode statistics.
+//***************************************************************************
+bool FCS_TASK_SCHDLR_registerSleepCb(uint32_t (*pfnSleep)(uint8_t nMode, uint32_t nTicks),
+        const uint32_t *pnLatencyUs, uint8_t nModes)
+{
+    uint8_t nMode;
+
+    if(nModes > FCS_TASK_SCHDLR_SLEEP_MODES)
+    {
+        return false;
+    }
+
+    // Stop sleeping while the modes change.
+    m_pfnSleep = NULL;
+    m_nSleepModes = nModes;
+
+    for(nMode = 0; nMode < nModes; nMode++)
+    {
+        m_aSleepStats[nMode].nEntries = 0;
+        m_aSleepStats[nMode].nEarly = 0;
+        m_aSleepStats[nMode].nLastUs = 0;
+        m_aSleepStats[nMode].nWorstUs = 0;
+        m_aSleepStats[nMode].nLatencyUs = pnLatencyUs[nMode];
+    }
+
+    if(nModes > 0)
+    {
+        m_pfnSleep = pfnSleep;
+    }
+
+    return true;
+}
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_getSleepStats
+// Returns:         Success status, false for an unregistered mode.
+// Param1:          nMode - Sleep mode.
+// Param2:          *pStats - Receives the mode's statistics.
+// Description:     Copies a sleep mode's statistics.
+//***************************************************************************
+bool FCS_TASK_SCHDLR_getSleepStats(uint8_t nMode, FCS_TaskSleepStats_t *pStats)
+{
+    if(nMode >= m_nSleepModes)
+    {
+        return false;
+    }
+
+    *pStats = m_aSleepStats[nMode];
+
+    return true;
+}
+#endif
+
+#ifdef FCS_TASK_SCHDLR_LOAD_ENABLE
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_getLoad
+// Returns:         void
+// Param1:          *pLoad - Receives the CPU load.
+// Description:     Averages the stored seconds over each window, newest first.
+//***************************************************************************
+void FCS_TASK_SCHDLR_getLoad(FCS_TaskLoad_t *pLoad)
+{
+    uint32_t nSum = 0;
+    uint32_t nIdleSum = 0;
+    uint32_t nPeak;
+    uint8_t nSec;
+    uint8_t idx = m_nLoadSecNext;
+
+    pLoad->nLoad1s = 0;
+    pLoad->nLoad10s = 0;
+    pLoad->nLoad60s = 0;
+    pLoad->nIdleTask1s = 0;
+    pLoad->nIdleTask10s = 0;
+    pLoad->nIdleTask60s = 0;
+
+    for(nSec = 1; nSec <= m_nLoadSecCnt; nSec++)
+    {
+        idx = (idx > 0) ? (idx - 1) : (FCS_TASK_SCHDLR_LOAD_SECS - 1);
+        nSum += m_aLoadSecs[idx];
+        nIdleSum += m_aLoadIdleSecs[idx];
+
+        if(nSec == 1)
+        {
+            pLoad->nLoad1s = (uint16_t) nSum;
+            pLoad->nIdleTask1s = (uint16_t) nIdleSum;
+        }
+
+        if(nSec <= 10)
+        {
+            pLoad->nLoad10s = (uint16_t) (nSum / nSec);
+            pLoad->nIdleTask10s = (uint16_t) (nIdleSum / nSec);
+        }
+
+        pLoad->nLoad60s = (uint16_t) (nSum / nSec);
+        pLoad->nIdleTask60s = (uint16_t) (nIdleSum / nSec);
+    }
+
+    nPeak = (m_nLoadPeakCyc < FCS_TASK_SCHDLR_TICK_CYCLES) ? m_nLoadPeakCyc : FCS_TASK_SCHDLR_TICK_CYCLES;
+    pLoad->nPeakTick = (uint16_t) ((nPeak * 10000) / FCS_TASK_SCHDLR_TICK_CYCLES);
+}
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_clearLoadPeak
+// Returns:         void
+// Param1:          void
+// Description:     Clears the busiest tick.
+//***************************************************************************
+void FCS_TASK_SCHDLR_clearLoadPeak(void)
 {
-    return *_FCS_TASK_SCHDLR_getTask(taskCode, pTaskArg);
+    m_nLoadPeakCyc = 0;
 }
+#endif
 
 //***************************************************************************
 // Function Name:   FCS_TASK_SCHDLR_dispatcher
@@ -454,90 +3812,248 @@ FCS_Task_t FCS_TASK_SCHDLR_getTask(FCS_TaskCode_t taskCode, void *pTaskArg)
 // Param1:          void
 // Description:     Main loop to process the task list. The scheduler's clock tick
 // counter is monitored and tasks are dispatched at their defined intervals in order
-// of priority level.
+// of priority level. Signaled tasks run between tick passes, ahead of idle tasks.
+// The linear and SoA dispatchers queue due tasks in one ready bitmap per priority
+// level, the wheel in one ready list per level, and run them one at a time, checking
+// for ticks after each task.
 //***************************************************************************
 #pragma TASK(FCS_TASK_SCHDLR_dispatcher);
 void FCS_TASK_SCHDLR_dispatcher(void)
 {
     static uint8_t idx;
     static uint32_t ticks;
-
-#ifdef _DEBUG_ENABLE
-    if((m_pfnTimingStart == NULL) || (m_pfnTimingStop == NULL))
-    {
-        // Hang the dispatcher.
-        while(true) {(void) 0;}
-    }
+#if !defined(FCS_TASK_SCHDLR_PROFILE_DISABLE) || defined(FCS_TASK_SCHDLR_IDLE_BUDGET_ENABLE) \
+        || defined(FCS_TASK_SCHDLR_WATCHDOG_ENABLE)
+    static uint8_t nGen;
+#endif
+#ifndef FCS_TASK_SCHDLR_PROFILE_DISABLE
+    static uint32_t nStartCyc;
+#endif
+#ifdef FCS_TASK_SCHDLR_LOAD_ENABLE
+    static uint32_t nIdleCyc;
 #endif
 
-    // Initialize main clock tick counter.
-    m_nClkTcks = 0;
+    // Discard ticks counted before the dispatcher started.
+    (void) _FCS_TASK_SCHDLR_takeTicks();
 
     // Run scheduler loop indefinitely.
     while(true)
     {
-        if(m_nClkTcks > 0)
+#ifdef FCS_TASK_SCHDLR_WATCHDOG_ENABLE
+        if((m_pfnWdogRefresh != NULL) && ((m_nTickCnt - m_nWdogTck) >= m_nWdogPeriodTcks))
         {
-            // Save current tick count so each task is processed the same.
-            ticks = m_nClkTcks;
-            m_nClkTcks -= ticks;
+            // Refresh the watchdog if every supervised task is alive.
+            _FCS_TASK_SCHDLR_wdogSupervise();
+        }
+#endif
 
-            // Update all priority tasks.
-            for(idx = 0; idx < m_nPrtyTasks; idx++)
-            {
-                m_pTaskLst[idx].nElapsTcks += ticks;
+        // Save current tick count so each task is processed the same.
+        ticks = _FCS_TASK_SCHDLR_takeTicks();
 
-                if(m_pTaskLst[idx].nElapsTcks >= m_pTaskLst[idx].nIntvlTcks)
-                {
-#ifdef _DEBUG_ENABLE
-                    m_pfnTimingStart();
+        if(ticks > 0)
+        {
+#ifdef FCS_TASK_SCHDLR_LOAD_ENABLE
+            _FCS_TASK_SCHDLR_loadTick(ticks);
 #endif
 
-                    // Interval has expired. Run the task.
-                    if(m_pTaskLst[idx].pArg != NULL)
-                    {
-                        // Pass the stored argument.
-                        m_pTaskLst[idx].code.pfnHasArg(m_pTaskLst[idx].pArg);
-                    }
-                    else
-                    {
-                        // Pass pointer to the elapsed time value.
-                        m_pTaskLst[idx].code.pfnHasArg(&m_pTaskLst[idx].nElapsTcks);
-                    }
+#ifdef FCS_TASK_SCHDLR_TICKLESS_ENABLE
+            // Deadlines moved relative to the timer's last credited tick.
+            m_bTickSpanStale = true;
+#endif
 
-#ifdef _DEBUG_ENABLE
-                    m_pfnTimingStop();
+#ifdef FCS_TASK_SCHDLR_WHEEL_ENABLE
+            // Turn the wheel. Only tasks expiring in the passed slots are touched.
+            _FCS_TASK_SCHDLR_wheelAdvance(ticks);
+#elif defined(FCS_TASK_SCHDLR_SOA_ENABLE)
+            // Add the ticks to every task at once and queue the due tasks.
+            _FCS_TASK_SCHDLR_soaAdvance(ticks);
+#elif defined(FCS_TASK_SCHDLR_EDF_ENABLE)
+            // Queue the released tasks by deadline and run them earliest first.
+            _FCS_TASK_SCHDLR_edfAdvance(ticks);
+            _FCS_TASK_SCHDLR_edfDispatch();
+#elif defined(FCS_TASK_SCHDLR_CYCLIC_ENABLE)
+            // Run the frames started within the ticks from the frame table.
+            _FCS_TASK_SCHDLR_cycAdvance(ticks);
+#else
+            // Update all priority tasks and queue the due ones.
+            _FCS_TASK_SCHDLR_rdyAdvance(ticks);
+#endif
+        }
+#ifdef RDY_QUEUE
+        else if((m_nRdyLvls != 0)
+                && (FCS_TASK_SCHDLR_PORT_LOG2(m_nRdyLvls) >= FCS_TASK_SCHDLR_PORT_LOG2(m_nSigLvls)))
+        {
+            // Run the highest priority due task, then check for ticks again. Tasks
+            // released by a newer tick or signaled at a higher level go first.
+            _FCS_TASK_SCHDLR_dispatchTask(_FCS_TASK_SCHDLR_rdyTake());
+        }
+#endif
+#ifdef FCS_TASK_SCHDLR_WHEEL_ENABLE
+        else if(_FCS_TASK_SCHDLR_wheelHasReady())
+        {
+            // Run the highest priority released task, then check for ticks again.
+            _FCS_TASK_SCHDLR_wheelRunNext();
+        }
+#endif
+#ifdef FCS_TASK_SCHDLR_EDF_ENABLE
+        else if(m_nEdfCnt > 0)
+        {
+            // Run the tasks released by ticks that addTask took.
+            _FCS_TASK_SCHDLR_edfDispatch();
+        }
+#endif
+        else if(m_nSigLvls != 0)
+        {
+#ifdef FCS_TASK_SCHDLR_LOAD_ENABLE
+            if(!m_bLoadBusy)
+            {
+                // Signaled while idle.
+                m_nLoadStartCyc = FCS_TASK_SCHDLR_PORT_CYCLES();
+                m_bLoadBusy = true;
+            }
 #endif
 
-                    // Reset ticks elapsed.
-                    m_pTaskLst[idx].nElapsTcks = 0;
-                }
+            // Run the highest priority signaled task, then check for ticks again.
+            idx = _FCS_TASK_SCHDLR_sigTake();
+
+            if(idx != TASK_NULL_IDX)
+            {
+                _FCS_TASK_SCHDLR_runTask(&m_pTaskLst[idx], 0);
             }
         }
         else
         {
-            // Process idle tasks while priority tasks are waiting.
-            for(idx = m_nPrtyTasks; idx < (m_nPrtyTasks + m_nIdleTasks); idx++)
+#ifdef FCS_TASK_SCHDLR_LOAD_ENABLE
+            if(m_bLoadBusy)
+            {
+                // Out of work.
+                m_nLoadSpanCyc += FCS_TASK_SCHDLR_PORT_CYCLES() - m_nLoadStartCyc;
+                m_bLoadBusy = false;
+            }
+#endif
+
+#ifdef FCS_TASK_SCHDLR_TICKLESS_ENABLE
+            if(m_bTickSpanStale && (m_pfnSetTickSpan != NULL))
+            {
+                // Have the timer sleep through the ticks until the next deadline.
+                m_bTickSpanStale = false;
+                m_pfnSetTickSpan(FCS_TASK_SCHDLR_getIdleTicks());
+            }
+#endif
+
+            // Process one idle task while priority tasks are waiting, then check for
+            // ticks again. The next pass resumes with the following idle task.
+            idx = m_nIdleNext;
+
+            if(idx == TASK_NULL_IDX)
+            {
+                idx = m_aPrtyHead[FCS_TASKPRIORITY_Idle];
+            }
+
+            if(idx != TASK_NULL_IDX)
             {
+                m_nIdleNext = m_pTaskLst[idx].nPrtyNext;
+
+#if !defined(FCS_TASK_SCHDLR_PROFILE_DISABLE) || defined(FCS_TASK_SCHDLR_IDLE_BUDGET_ENABLE) \
+        || defined(FCS_TASK_SCHDLR_WATCHDOG_ENABLE)
+                // Changes if the task removes itself.
+                nGen = m_aTaskGen[idx];
+#endif
+
+#ifdef FCS_TASK_SCHDLR_IDLE_BUDGET_ENABLE
+                m_nIdleBudgetCyc = m_pTaskLst[idx].nBudgetCyc;
+                m_nIdleStartCyc = FCS_TASK_SCHDLR_PORT_CYCLES();
+#endif
+
+#ifndef FCS_TASK_SCHDLR_PROFILE_DISABLE
+                nStartCyc = _FCS_TASK_SCHDLR_profStart(idx);
+#endif
+
+#ifdef FCS_TASK_SCHDLR_WATCHDOG_ENABLE
+                m_nRunTck = m_nTickCnt;
+                m_nRunIdx = idx;
+#endif
+
+#ifdef FCS_TASK_SCHDLR_LOAD_ENABLE
+                nIdleCyc = FCS_TASK_SCHDLR_PORT_CYCLES();
+#endif
+
                 // Run the idle task.
-                if(m_pTaskLst[idx].pArg != NULL)
+                if(TASK_ARG(idx) != NULL)
                 {
-                    m_pTaskLst[idx].code.pfnHasArg(m_pTaskLst[idx].pArg);
+                    TASK_CODE(idx).pfnHasArg(TASK_ARG(idx));
                 }
                 else
                 {
-                    m_pTaskLst[idx].code.pfnNoArg();
+                    TASK_CODE(idx).pfnNoArg();
+                }
+
+#ifdef FCS_TASK_SCHDLR_LOAD_ENABLE
+                m_nLoadIdleCyc += FCS_TASK_SCHDLR_PORT_CYCLES() - nIdleCyc;
+#endif
+
+#ifndef FCS_TASK_SCHDLR_PROFILE_DISABLE
+                _FCS_TASK_SCHDLR_profStop(idx, nGen, nStartCyc);
+#endif
+
+#ifdef FCS_TASK_SCHDLR_WATCHDOG_ENABLE
+                m_nRunIdx = TASK_NULL_IDX;
+
+                // A completed run checks in, unless the task removed itself.
+                if((m_aTaskGen[idx] == nGen) && !m_pTaskLst[idx].bHbManual)
+                {
+                    m_pTaskLst[idx].nHbTck = m_nTickCnt;
+                }
+#endif
+
+#ifdef FCS_TASK_SCHDLR_IDLE_BUDGET_ENABLE
+                if((m_nIdleBudgetCyc > 0)
+                        && ((FCS_TASK_SCHDLR_PORT_CYCLES() - m_nIdleStartCyc) > m_nIdleBudgetCyc))
+                {
+                    // Ran past its budget. Counted unless the task removed itself.
+                    if(m_aTaskGen[idx] == nGen)
+                    {
+                        m_pTaskLst[idx].nMissCnt++;
+                    }
                 }
+
+                m_nIdleBudgetCyc = 0;
+#endif
             }
+#ifdef FCS_TASK_SCHDLR_SLEEP_ENABLE
+            else if(m_pfnSleep != NULL)
+            {
+                // Nothing to run until the next tick or interrupt.
+                _FCS_TASK_SCHDLR_sleep();
+            }
+#endif
         }
     }
 }
 
+#ifdef FCS_TASK_SCHDLR_TICKLESS_ENABLE
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_registerTicklessCb
+// Returns:         void
+// Param1:          pfnSetTickSpan - Programs the tick timer to interrupt once after
+//                  the given number of ticks, counted from the last tick it credited.
+// Description:     Registers the timer callback used to suppress idle clock ticks.
+// The callback is invoked from the dispatcher each time the tick count or the task
+// list changed and no ticks are waiting to be processed.
+//***************************************************************************
+void FCS_TASK_SCHDLR_registerTicklessCb(void (*pfnSetTickSpan)(uint32_t nTicks))
+{
+    m_pfnSetTickSpan = pfnSetTickSpan;
+    m_bTickSpanStale = true;
+}
+#endif
+
 //***************************************************************************
 // Function Name:   FCS_TASK_SCHDLR_registerTimingCbs
 // Returns:         void
-// Param1:          void
-// Description:
+// Param1:          pfnTimingStart - Called before each priority task runs, or NULL.
+// Param2:          pfnTimingStop - Called after each priority task ran, or NULL.
+// Description:     Registers hooks around priority task runs.
 //***************************************************************************
 #ifdef _DEBUG_ENABLE
 extern void FCS_TASK_SCHDLR_registerTimingCbs(void (*pfnTimingStart)(void),
@@ -35,10 +35,163 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#ifdef FCS_TASK_SCHDLR_STATIC_ENABLE
+// Application's static task table
+#include "task_schdlr_tasks.h"
+#endif
+
 //**************
 // Defines
 //**************
 
+// Build options (define in the compiler settings):
+// FCS_TASK_SCHDLR_WHEEL_ENABLE - Dispatch priority tasks from a hierarchical timing wheel.
+//     A tick then only touches the tasks expiring in that tick's slot instead of every
+//     priority task in the list. Adding, removing or updating a task only refiles that task.
+//     Tasks of the same priority level released on the same tick may run in a different
+//     order than they were added.
+// FCS_TASK_SCHDLR_SOA_ENABLE - Keep the interval and elapsed ticks of the linear dispatcher
+//     in arrays of their own, apart from the rest of the task structure. A tick then
+//     updates every task in one pass over the arrays and queues the expired tasks a
+//     word of the ready bitmaps at a time (see FCS_TASK_SCHDLR_dispatcher). The
+//     nElapsTcks field of a task structure is only updated when the task is retrieved.
+//     The pass covers every slot up to the highest task ID in each word of 32 IDs that
+//     holds a priority task, so it only pays off for large lists: on the host
+//     (Tools/fcs_bench) it overtakes the linear scan at about 128 tasks and is slower
+//     below that. Cannot be combined with FCS_TASK_SCHDLR_WHEEL_ENABLE.
+// FCS_TASK_SCHDLR_EDF_ENABLE - Dispatch released Low to Critical priority tasks earliest
+//     deadline first instead of by priority level. Each task has a relative deadline,
+//     its interval unless set with FCS_TASK_SCHDLR_setDeadlineHndl. Released tasks are
+//     queued in a binary heap on their absolute deadline, and the dispatcher checks for
+//     new releases after each task. Priority levels only order tasks with equal
+//     deadlines. Cannot be combined with FCS_TASK_SCHDLR_WHEEL_ENABLE or
+//     FCS_TASK_SCHDLR_SOA_ENABLE.
+// FCS_TASK_SCHDLR_IMMEDIATE_ENABLE - Accept FCS_TASKPRIORITY_Immediate tasks. These are
+//     dispatched preemptively from the PendSV exception, which the clock tick pends, so
+//     their response time is interrupt latency rather than the longest cooperative
+//     task. Route the CPU component's ivINT_PendableSrvReq vector to
+//     FCS_TASK_SCHDLR_immediateIsr. See FCS_TASK_SCHDLR_immediateIsr for the rules
+//     Immediate tasks have to follow.
+// FCS_TASK_SCHDLR_IDLE_BUDGET_ENABLE - Give idle tasks a cycle budget, measured with the
+//     core's DWT cycle counter. See FCS_TASK_SCHDLR_setIdleBudgetHndl.
+// FCS_TASK_SCHDLR_TICKLESS_ENABLE - Suppress clock ticks while no priority task is due.
+//     When the dispatcher runs out of ticks to process it passes the number of ticks
+//     until the earliest deadline to the callback registered with
+//     FCS_TASK_SCHDLR_registerTicklessCb. The timer is then expected to interrupt once
+//     after that span and credit the elapsed ticks with FCS_TASK_SCHDLR_clockTicks.
+// FCS_TASK_SCHDLR_PROFILE_DISABLE - Leave out the per-task execution time profiler
+//     (see FCS_TASK_SCHDLR_getProfileHndl) to save its RAM and dispatch overhead.
+// FCS_TASK_SCHDLR_STATIC_ENABLE - Declare the task set at compile time instead of adding
+//     tasks at run time. The application's task_schdlr_tasks.h defines the table as
+//     FCS_TASK_SCHDLR_TASKS(TASK), expanding TASK(name, code, pArg, intvlTicks, priority)
+//     once per task, e.g. TASK(ledBlink, Task_led_blink, NULL, 1000, FCS_TASKPRIORITY_Normal).
+//     The code, argument and initial settings of each task are kept in a const table in
+//     flash and only the timing state stays in RAM. The scheduler's tables are sized to
+//     the number of tasks, and FCS_TASK_SCHDLR_init links every task in table order.
+//     Task IDs and handles are compile-time constants, see FCS_TASK_SCHDLR_HANDLE.
+//     FCS_TASK_SCHDLR_addTask and the functions locating a task by its code are left
+//     out. A removed task stays removed.
+// FCS_TASK_SCHDLR_CYCLIC_ENABLE - Run Low to Critical priority tasks from a precomputed
+//     cyclic executive frame table instead of their interval counters. Each minor frame
+//     of FCS_TASK_SCHDLR_FRAME_TCKS ticks runs a fixed list of tasks, and the frames
+//     repeat every major cycle (hyperperiod). The table is generated into
+//     task_schdlr_frames.h by Tools/fcs_cyc from the task periods, so the tick pass
+//     costs the same every frame. Requires FCS_TASK_SCHDLR_STATIC_ENABLE, the table
+//     refers to its task names. Intervals and priority levels of Low to Critical tasks
+//     no longer time them, except that a removed task or one moved to Idle is skipped.
+// FCS_TASK_SCHDLR_WATCHDOG_ENABLE - Feed the hardware watchdog only while every supervised
+//     task is alive. A task given a heartbeat window with FCS_TASK_SCHDLR_setHeartbeatHndl
+//     has to check in at least once per window, by completing a run or by calling
+//     FCS_TASK_SCHDLR_checkInHndl. Every period registered with
+//     FCS_TASK_SCHDLR_registerWatchdogCb the dispatcher checks the windows and calls the
+//     refresh callback only if none has lapsed. The first task found lapsed is recorded
+//     in RAM kept over the reset (see FCS_TASK_SCHDLR_getWatchdogRecord) and the
+//     watchdog is not refreshed again.
+// FCS_TASK_SCHDLR_SLEEP_ENABLE - Sleep instead of spinning while there is nothing to run
+//     and no idle tasks. The callback registered with FCS_TASK_SCHDLR_registerSleepCb
+//     offers a list of sleep modes, shallowest first, each with a wake-up latency. The
+//     dispatcher picks the deepest mode that can wake up before the next deadline and
+//     keeps the worst latency the callback measures for each mode, so a mode found to
+//     wake up slower than registered is only used for longer idle spans from then on.
+// FCS_TASK_SCHDLR_LOAD_ENABLE - Measure the CPU load (see FCS_TASK_SCHDLR_getLoad). The
+//     dispatcher counts the core cycles from finding work until it runs out of work,
+//     with the DWT cycle counter, and sets them against the cycles the elapsed ticks
+//     hold. The cycles spent in idle tasks are measured as a load of their own, apart
+//     from the load, and sleep counts as idle time. Interrupts count with whatever they
+//     interrupt.
+
+// Returned by FCS_TASK_SCHDLR_getIdleTicks when no priority task is waiting.
+#define FCS_TASK_SCHDLR_IDLE_FOREVER    UINT32_MAX
+
+#ifdef FCS_TASK_SCHDLR_SLEEP_ENABLE
+// Length of a clock tick in microseconds.
+#ifndef FCS_TASK_SCHDLR_TICK_US
+#define FCS_TASK_SCHDLR_TICK_US         1000
+#endif
+
+// Most sleep modes the callback can offer.
+#define FCS_TASK_SCHDLR_SLEEP_MODES     4
+
+// Returned by the sleep callback when it woke up before its wake-up time.
+#define FCS_TASK_SCHDLR_SLEEP_EARLY     UINT32_MAX
+#endif
+
+#ifdef FCS_TASK_SCHDLR_STATIC_ENABLE
+// Task IDs of the static task table, FCS_TASKID_<name>, in table order
+#define FCS_TASK_SCHDLR_TASK_ID(name, code, pArg, intvlTicks, priority)   FCS_TASKID_##name,
+enum {
+    FCS_TASK_SCHDLR_TASKS(FCS_TASK_SCHDLR_TASK_ID)
+    FCS_TASK_SCHDLR_STATIC_TASKS    // Number of tasks in the table
+};
+
+// Handle of a task of the static table. Valid until the task is removed.
+#define FCS_TASK_SCHDLR_HANDLE(name)    ((FCS_TaskHandle_t) (0x100 | FCS_TASKID_##name))
+
+// The handle tables hold the static tasks exactly.
+#undef FCS_TASK_SCHDLR_MAX_TASKS
+#define FCS_TASK_SCHDLR_MAX_TASKS       FCS_TASK_SCHDLR_STATIC_TASKS
+#endif
+
+// Largest task list supported. Sizes the scheduler's handle tables (at most 255).
+#ifndef FCS_TASK_SCHDLR_MAX_TASKS
+#define FCS_TASK_SCHDLR_MAX_TASKS       64
+#endif
+
+// Handle value never assigned to a task. Returned when a task could not be added.
+#define FCS_TASK_SCHDLR_INVALID_HANDLE  0
+
+// Interrupt priority level of the Immediate task dispatch (0 = highest). Should be
+// lower (numerically higher) than the clock tick timer's interrupt.
+#ifndef FCS_TASK_SCHDLR_IMMEDIATE_PRIO
+#define FCS_TASK_SCHDLR_IMMEDIATE_PRIO  15
+#endif
+
+#ifdef FCS_TASK_SCHDLR_LOAD_ENABLE
+// Clock ticks per second.
+#ifndef FCS_TASK_SCHDLR_TICK_HZ
+#define FCS_TASK_SCHDLR_TICK_HZ         1000
+#endif
+
+// Core cycles per clock tick, by default of the 20.97152 MHz FEI core clock. At most
+// 429496.
+#ifndef FCS_TASK_SCHDLR_TICK_CYCLES
+#define FCS_TASK_SCHDLR_TICK_CYCLES     (20971520UL / FCS_TASK_SCHDLR_TICK_HZ)
+#endif
+
+// Longest load average in seconds.
+#define FCS_TASK_SCHDLR_LOAD_SECS       60
+#endif
+
+// Most release offsets FCS_TASK_SCHDLR_staggerHndl compares, and the entries of its
+// load table. Tasks whose shared ticks repeat over a longer span are placed within
+// its first offsets.
+#ifndef FCS_TASK_SCHDLR_STAGGER_SPAN
+#define FCS_TASK_SCHDLR_STAGGER_SPAN    128
+#endif
+
+// Execution time histogram bins. Bin n counts runs of 2^n to 2^(n+1)-1 core cycles,
+// runs of 0 cycles are counted in bin 0.
+#define FCS_TASK_SCHDLR_PROFILE_BINS    32
 
 //**************
 // Global Typedefs
@@ -47,6 +200,10 @@
 // Unique numeric identifier assigned to each task
 typedef uint8_t FCS_TaskID_t;
 
+// Task handle. Task ID in the low byte and the ID's generation in the high byte, so a
+// handle to a removed task is rejected even after its ID has been reassigned.
+typedef uint16_t FCS_TaskHandle_t;
+
 /*** Enumerations ***/
 
 // Assignable priorities levels for tasks
@@ -56,9 +213,36 @@ typedef enum _FCS_TaskPriority_e {
     FCS_TASKPRIORITY_Normal,    // Normal priority
     FCS_TASKPRIORITY_High,      // High priority
     FCS_TASKPRIORITY_Critical,  // Critical priority
-//    FCS_TASKPRIORITY_Immediate  // Serviced immediately through ISR
+    FCS_TASKPRIORITY_Immediate  // Serviced immediately through ISR (FCS_TASK_SCHDLR_IMMEDIATE_ENABLE)
 } FCS_TaskPriority_e;
 
+// Release modes and overrun policies for priority tasks
+typedef enum _FCS_TaskRelease_e {
+    FCS_TASKRELEASE_Relative,   // Interval restarts once the task has run, lateness shifts the phase
+    FCS_TASKRELEASE_AbsSkip,    // Fixed release grid, late activations are dropped without running
+    FCS_TASKRELEASE_AbsCatchUp, // Fixed release grid, late activations all run back to back
+    FCS_TASKRELEASE_AbsRunOnce  // Fixed release grid, late activations run once and set bOverrun
+} FCS_TaskRelease_e;
+
+// Timing faults detected on priority tasks
+typedef enum _FCS_TaskFault_e {
+    FCS_TASKFAULT_Late,         // Started more than its lateness limit after its release
+    FCS_TASKFAULT_Overrun       // Ran for more ticks than its interval
+} FCS_TaskFault_e;
+
+// Responses of the fault policy callback
+typedef enum _FCS_TaskFaultAction_e {
+    FCS_TASKFAULTACTION_None,   // Keep the task as it is
+    FCS_TASKFAULTACTION_Demote, // Lower the task by one priority level, Low is kept
+    FCS_TASKFAULTACTION_Remove  // Remove the task
+} FCS_TaskFaultAction_e;
+
+// Causes of a watchdog reset recorded by the supervisor (FCS_TASK_SCHDLR_WATCHDOG_ENABLE)
+typedef enum _FCS_TaskWdogCause_e {
+    FCS_TASKWDOG_Starved,       // A supervised task did not check in within its window
+    FCS_TASKWDOG_Hung           // The watchdog timed out, e.g. while a task was stuck running
+} FCS_TaskWdogCause_e;
+
 /*** Unions ***/
 
 // Points to task's executable code
@@ -71,14 +255,99 @@ typedef union _FCS_TaskCode_t {
 
 // Scheduler task
 typedef struct _FCS_Task_t {
-    FCS_TaskID_t        id;
+    FCS_TaskID_t        id;             // Task ID, equal to the task's slot in the task list
+#ifndef FCS_TASK_SCHDLR_STATIC_ENABLE
     FCS_TaskCode_t      code;           // Task's executable code
     void                *pArg;          // Optional pointer argument passed to task's code
+#endif
     FCS_TaskPriority_e  priority;       // Scheduling priority level
     uint32_t            nIntvlTcks;     // Interval in ticks to dispatch task for processing
     uint32_t            nElapsTcks;     // Ticks elapsed since task was last processed
+    FCS_TaskRelease_e   release;        // Release mode and overrun policy
+    uint32_t            nMissCnt;       // Activations dropped or run after a newer release,
+                                        // idle tasks: calls that ran past their cycle budget
+    bool                bOverrun;       // Activations were dropped under FCS_TASKRELEASE_AbsRunOnce
+    uint32_t            nLateLimTcks;   // Ticks a release may wait before the task counts as late
+    uint32_t            nLateCnt;       // Runs started past the lateness limit
+    uint32_t            nOvrnCnt;       // Runs that took more ticks than the interval
+#ifdef FCS_TASK_SCHDLR_IDLE_BUDGET_ENABLE
+    uint32_t            nBudgetCyc;     // Idle tasks: cycle budget per call, 0 for none
+#endif
+    uint8_t             nPrtyNext;      // ID of next task of the same priority level
+    uint8_t             nPrtyPrev;      // ID of previous task of the same priority level
+#ifdef FCS_TASK_SCHDLR_WHEEL_ENABLE
+    uint32_t            nRlsTck;        // Absolute tick the task is next released at
+    uint8_t             nWheelNext;     // ID of next task in the same wheel slot/ready list
+    uint8_t             nWheelPrev;     // ID of previous task in the same wheel slot/ready list
+    uint8_t             *pWheelList;    // Head of the wheel slot/ready list the task is filed on
+#endif
+#ifdef FCS_TASK_SCHDLR_EDF_ENABLE
+    uint32_t            nDlTcks;        // Relative deadline in ticks, 0 for the interval
+    uint32_t            nAbsDlTck;      // Tick the released activation is due by
+    uint8_t             nHeapPos;       // Position in the released task heap, 0xFF if not released
+#endif
+#ifdef FCS_TASK_SCHDLR_CYCLIC_ENABLE
+    uint32_t            nFrmTck;        // Tick the frame the task last ran in started at
+#endif
+#ifdef FCS_TASK_SCHDLR_WATCHDOG_ENABLE
+    uint32_t            nHbWinTcks;     // Ticks allowed between check-ins, 0 if not supervised
+    volatile uint32_t   nHbTck;         // Tick count at the last check-in
+    bool                bHbManual;      // Only FCS_TASK_SCHDLR_checkInHndl checks in
+#endif
 } FCS_Task_t;
 
+// Static task table entry, kept in flash (FCS_TASK_SCHDLR_STATIC_ENABLE)
+typedef struct _FCS_TaskDesc_t {
+    FCS_TaskCode_t      code;           // Task's executable code
+    void                *pArg;          // Optional pointer argument passed to task's code
+    uint32_t            nIntvlTcks;     // Initial dispatch interval in ticks
+    FCS_TaskPriority_e  priority;       // Initial priority level
+} FCS_TaskDesc_t;
+
+// Execution time profile of a task. Cycles are read from the core's DWT cycle counter
+// and include the time spent in interrupts that preempted the task.
+typedef struct _FCS_TaskProfile_t {
+    uint32_t            nRunCnt;        // Completed runs
+    uint32_t            nMinCyc;        // Shortest run in core cycles
+    uint32_t            nMaxCyc;        // Longest run in core cycles
+    uint32_t            nMeanCyc;       // Mean run in core cycles
+    uint64_t            nTotalCyc;      // Core cycles of all runs
+    uint32_t            nLastStartTck;  // Clock tick (FCS_TASK_SCHDLR_now) the last run started at
+    uint16_t            aHist[FCS_TASK_SCHDLR_PROFILE_BINS];    // Runs per log2 cycle bin, saturating
+} FCS_TaskProfile_t;
+
+// Task that caused a watchdog reset (FCS_TASK_SCHDLR_WATCHDOG_ENABLE)
+typedef struct _FCS_TaskWdogRecord_t {
+    FCS_TaskWdogCause_e cause;          // Why the watchdog was left to expire
+    FCS_TaskID_t        id;             // ID of the task, 0xFF if no task was running
+    FCS_TaskHandle_t    hTask;          // Handle of the task
+    FCS_TaskCode_t      code;           // Code of the task, identifies it across resets
+    uint32_t            nTicks;         // Starved: ticks since the task checked in,
+                                        // hung: ticks the task had been running
+    uint32_t            nTick;          // Scheduler tick count when recorded
+} FCS_TaskWdogRecord_t;
+
+// Sleep mode statistics (FCS_TASK_SCHDLR_SLEEP_ENABLE)
+typedef struct _FCS_TaskSleepStats_t {
+    uint32_t            nEntries;       // Times the mode was entered
+    uint32_t            nEarly;         // Wake-ups before the wake-up time, not measured
+    uint32_t            nLastUs;        // Last measured wake-up latency
+    uint32_t            nWorstUs;       // Worst measured wake-up latency
+    uint32_t            nLatencyUs;     // Latency the mode is picked by, the larger of the
+                                        // registered and the worst measured latency
+} FCS_TaskSleepStats_t;
+
+// CPU load in hundredths of a percent (FCS_TASK_SCHDLR_LOAD_ENABLE)
+typedef struct _FCS_TaskLoad_t {
+    uint16_t            nLoad1s;        // Over the last second
+    uint16_t            nLoad10s;       // Over the last 10 seconds
+    uint16_t            nLoad60s;       // Over the last 60 seconds
+    uint16_t            nPeakTick;      // Busiest tick since the peak was cleared
+    uint16_t            nIdleTask1s;    // Idle task load over the last second
+    uint16_t            nIdleTask10s;   // Idle task load over the last 10 seconds
+    uint16_t            nIdleTask60s;   // Idle task load over the last 60 seconds
+} FCS_TaskLoad_t;
+
 //**************
 // Global Variables
 //**************
@@ -102,12 +371,56 @@ extern void FCS_TASK_SCHDLR_init(FCS_Task_t *pTaskLst, uint8_t nMaxTasks);
 // Param1:          void
 // Description:     Increments the scheduler's clock tick counter. A hardware
 // timer is required to call this function at the desired tick frequency.
+// Ticks may only be added from one context at a time, normally the timer's ISR.
 //***************************************************************************
 extern void FCS_TASK_SCHDLR_clockTick(void);
 
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_clockTicks
+// Returns:         void
+// Param1:          nTicks - Clock ticks to add.
+// Description:     Adds several clock ticks at once. Used by timers that are
+// reprogrammed to interrupt less often than once per tick.
+// Ticks may only be added from one context at a time, normally the timer's ISR.
+//***************************************************************************
+extern void FCS_TASK_SCHDLR_clockTicks(uint32_t nTicks);
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_now
+// Returns:         Clock ticks counted since the scheduler was first initialized.
+// Param1:          void
+// Description:     Reads the free-running tick counter. The count wraps after 2^32
+// ticks, so intervals should be measured by unsigned subtraction of two readings.
+//***************************************************************************
+extern uint32_t FCS_TASK_SCHDLR_now(void);
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_getTickOverruns
+// Returns:         Number of tick overruns.
+// Param1:          void
+// Description:     Counts the clock ticks that arrived while the dispatcher had not
+// yet taken the previous ones, i.e. while a task kept it busy for longer than a tick.
+// In tickless mode a late timer span is counted the same way.
+//***************************************************************************
+extern uint32_t FCS_TASK_SCHDLR_getTickOverruns(void);
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_getIdleTicks
+// Returns:         Ticks until the earliest priority task is due, 0 if ticks are
+//                  waiting to be processed or FCS_TASK_SCHDLR_IDLE_FOREVER if
+//                  there are no priority tasks.
+// Param1:          void
+// Description:     Computes the number of clock ticks the scheduler can go without
+// dispatching a priority task. The timing wheel may report an earlier tick at which
+// its higher levels need cascading.
+//***************************************************************************
+extern uint32_t FCS_TASK_SCHDLR_getIdleTicks(void);
+
+#ifndef FCS_TASK_SCHDLR_STATIC_ENABLE
 //***************************************************************************
 // Function Name:   FCS_TASK_SCHDLR_addTask
-// Returns:         Success status of task addition.
+// Returns:         Handle of the new task or FCS_TASK_SCHDLR_INVALID_HANDLE if the
+//                  task could not be added.
 // Param1:          taskCode - Points to task's executable code.
 // Param2:          *pTaskArg - Optional argument passed to task's code.
 // Param3:          intvlTicks - Dispatch interval.
@@ -116,7 +429,7 @@ extern void FCS_TASK_SCHDLR_clockTick(void);
 // representing the task's executable code will be called with the optional
 // argument if one is provided.
 //***************************************************************************
-extern bool FCS_TASK_SCHDLR_addTask(FCS_TaskCode_t taskCode, void *pTaskArg,
+extern FCS_TaskHandle_t FCS_TASK_SCHDLR_addTask(FCS_TaskCode_t taskCode, void *pTaskArg,
         uint32_t intvlTicks, FCS_TaskPriority_e priority);
 
 //***************************************************************************
@@ -147,6 +460,381 @@ extern bool FCS_TASK_SCHDLR_updateTask(FCS_Task_t task, uint32_t intvlTicks,
 // and optional argument.
 //***************************************************************************
 extern FCS_Task_t FCS_TASK_SCHDLR_getTask(FCS_TaskCode_t taskCode, void *pTaskArg);
+#endif
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_removeTaskHndl
+// Returns:         Success status of task removal.
+// Param1:          hTask - Handle of task to remove.
+// Description:     Removes a task from the task list. The handle is resolved in
+// constant time and is invalid afterwards.
+//***************************************************************************
+extern bool FCS_TASK_SCHDLR_removeTaskHndl(FCS_TaskHandle_t hTask);
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_updateTaskHndl
+// Returns:         Success status of task update.
+// Param1:          hTask - Handle of task to update.
+// Param2:          intvlTicks - Dispatch interval.
+// Param3:          priority - Priority level.
+// Description:     Updates an existing task's dispatch interval and priority level.
+// The handle is resolved in constant time.
+//***************************************************************************
+extern bool FCS_TASK_SCHDLR_updateTaskHndl(FCS_TaskHandle_t hTask, uint32_t intvlTicks,
+        FCS_TaskPriority_e priority);
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_getTaskHndl
+// Returns:         Pointer to the task structure or NULL if the handle is stale.
+// Param1:          hTask - Handle of task to retrieve.
+// Description:     Retrieves the task structure associated with a handle without
+// copying it. The pointer stays valid until the task is removed.
+//***************************************************************************
+extern const FCS_Task_t *FCS_TASK_SCHDLR_getTaskHndl(FCS_TaskHandle_t hTask);
+
+#ifdef FCS_TASK_SCHDLR_IMMEDIATE_ENABLE
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_immediateIsr
+// Returns:         void
+// Param1:          void
+// Description:     Dispatches the Immediate tasks. Pended by the clock tick and run
+// at FCS_TASK_SCHDLR_IMMEDIATE_PRIO, preempting whichever cooperative task is
+// running. Immediate tasks always use relative release timing.
+//
+// Immediate tasks follow the stack resource policy:
+// - All Immediate tasks share one preemption level. They never preempt each other
+//   and run to completion on the main stack, so they must not block or wait.
+// - Immediate tasks must not add, remove or update tasks.
+// - Data shared between an Immediate task and cooperative tasks or the scheduler's
+//   callers has its ceiling at the Immediate level. Cooperative code accesses it
+//   between FCS_TASK_SCHDLR_lockImmediate and FCS_TASK_SCHDLR_unlockImmediate.
+//   Data shared with interrupts above that level needs those interrupts masked.
+//***************************************************************************
+extern void FCS_TASK_SCHDLR_immediateIsr(void);
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_lockImmediate
+// Returns:         Lock state to pass to FCS_TASK_SCHDLR_unlockImmediate.
+// Param1:          void
+// Description:     Raises the interrupt masking ceiling to the Immediate dispatch
+// priority, keeping Immediate tasks from running until unlocked. Nests.
+//***************************************************************************
+extern uint32_t FCS_TASK_SCHDLR_lockImmediate(void);
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_unlockImmediate
+// Returns:         void
+// Param1:          nLock - State returned by the matching FCS_TASK_SCHDLR_lockImmediate.
+// Description:     Restores the interrupt masking ceiling. A tick that arrived while
+// locked dispatches the Immediate tasks on return.
+//***************************************************************************
+extern void FCS_TASK_SCHDLR_unlockImmediate(uint32_t nLock);
+#endif
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_idleYield
+// Returns:         True if the running idle task should return to the dispatcher.
+// Param1:          void
+// Description:     Lets long idle tasks split their work. Returns true once clock
+// ticks are waiting to be processed or the task's cycle budget is used up.
+//
+// The dispatcher runs one idle task at a time and checks for ticks in between,
+// resuming with the next idle task round-robin. A priority task is therefore only
+// delayed by the idle task running when it becomes due, and idle tasks that poll
+// this function bound that delay to their polling period.
+//***************************************************************************
+extern bool FCS_TASK_SCHDLR_idleYield(void);
+
+#ifdef FCS_TASK_SCHDLR_IDLE_BUDGET_ENABLE
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_setIdleBudgetHndl
+// Returns:         Success status of the change.
+// Param1:          hTask - Handle of the idle task to change.
+// Param2:          nCycles - Core cycles the task may run per call, 0 for no budget.
+// Description:     Sets an idle task's cycle budget. FCS_TASK_SCHDLR_idleYield
+// reports when it is used up, and each call that runs past it is counted in the
+// task's nMissCnt.
+//***************************************************************************
+extern bool FCS_TASK_SCHDLR_setIdleBudgetHndl(FCS_TaskHandle_t hTask, uint32_t nCycles);
+#endif
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_setReleaseHndl
+// Returns:         Success status of the change.
+// Param1:          hTask - Handle of task to change.
+// Param2:          release - Release mode and overrun policy.
+// Description:     Selects how a task's releases are timed and how activations it
+// could not run on time are handled. The task's phase is not changed.
+//
+// Tasks are added in FCS_TASKRELEASE_Relative mode, where the interval restarts
+// once the task has run. In the absolute modes each release is the previous release
+// plus the interval, so the task does not drift however late it runs. An activation
+// counts as missed when the next release also passed before it was dispatched, for
+// example when several ticks piled up. In the absolute modes the elapsed ticks passed
+// to tasks without an argument count the ticks since the release being run.
+//***************************************************************************
+extern bool FCS_TASK_SCHDLR_setReleaseHndl(FCS_TaskHandle_t hTask, FCS_TaskRelease_e release);
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_clearMissedHndl
+// Returns:         Success status of the change.
+// Param1:          hTask - Handle of task to change.
+// Description:     Resets a task's missed activation, lateness and overrun counters
+// and its overrun flag.
+//***************************************************************************
+extern bool FCS_TASK_SCHDLR_clearMissedHndl(FCS_TaskHandle_t hTask);
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_signalHndl
+// Returns:         Success status of the signal, false for Idle and Immediate tasks.
+// Param1:          hTask - Handle of task to signal.
+// Description:     Marks a task to run on the dispatcher's next loop iteration,
+// without waiting for its interval. Safe to call from interrupts, so an ISR with
+// data ready does not leave its consumer waiting up to a full interval.
+//
+// Signaled tasks run one per loop iteration, after any waiting ticks are processed
+// and ahead of idle tasks, highest priority level first and in order of task ID
+// within a level. Signaling a task several times before it runs runs it once. A
+// signaled run is an extra run: the task's interval, phase and release timing are
+// not changed, and tasks without an argument get their elapsed ticks as usual. The
+// run is checked for overruns like a released one.
+//***************************************************************************
+extern bool FCS_TASK_SCHDLR_signalHndl(FCS_TaskHandle_t hTask);
+
+#ifdef FCS_TASK_SCHDLR_EDF_ENABLE
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_setDeadlineHndl
+// Returns:         Success status of the change.
+// Param1:          hTask - Handle of task to change.
+// Param2:          nTicks - Ticks from a release until the run is due, 0 for the
+//                  task's interval.
+// Description:     Sets a task's relative deadline. An activation already released
+// keeps the deadline it was queued with.
+//***************************************************************************
+extern bool FCS_TASK_SCHDLR_setDeadlineHndl(FCS_TaskHandle_t hTask, uint32_t nTicks);
+#endif
+
+#ifndef FCS_TASK_SCHDLR_CYCLIC_ENABLE
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_setPhaseHndl
+// Returns:         Success status of the change.
+// Param1:          hTask - Handle of task to change.
+// Param2:          nPhase - Release phase in ticks, reduced modulo the interval.
+// Description:     Sets a task's phase offset. The task is released on the ticks
+// whose count, as returned by FCS_TASK_SCHDLR_now, equals the phase modulo its
+// interval, e.g. phases 0, 1 and 2 keep three 10 tick tasks off each other's ticks.
+// A release already pending is dropped. Tasks are added with their first release a
+// full interval after being added. Relative release tasks keep the phase only while
+// they run on time.
+//***************************************************************************
+extern bool FCS_TASK_SCHDLR_setPhaseHndl(FCS_TaskHandle_t hTask, uint32_t nPhase);
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_staggerHndl
+// Returns:         Success status of the change.
+// Param1:          hTask - Handle of task to change.
+// Description:     Sets a task's phase to the ticks least loaded by the other tasks
+// with an interval, so fewer tasks are released on the same tick. Each task shared
+// with counts with its mean measured runtime (see FCS_TASK_SCHDLR_getProfileHndl),
+// or the average of the measured tasks if it has not run yet. Compares up to
+// FCS_TASK_SCHDLR_STAGGER_SPAN offsets and walks the task list once, so it is meant
+// for setting up the task set rather than for every tick.
+//***************************************************************************
+extern bool FCS_TASK_SCHDLR_staggerHndl(FCS_TaskHandle_t hTask);
+#endif
+
+#ifndef FCS_TASK_SCHDLR_STATIC_ENABLE
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_setAutoStagger
+// Returns:         void
+// Param1:          bEnable - Stagger each task added from now on.
+// Description:     Selects whether FCS_TASK_SCHDLR_addTask places each new task
+// with FCS_TASK_SCHDLR_staggerHndl. Off after FCS_TASK_SCHDLR_init. Meant for
+// adding the initial task set; turn it off before adding tasks at run time.
+//***************************************************************************
+extern void FCS_TASK_SCHDLR_setAutoStagger(bool bEnable);
+#endif
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_setLateLimitHndl
+// Returns:         Success status of the change.
+// Param1:          hTask - Handle of task to change.
+// Param2:          nTicks - Ticks the task may start after its release, 0 by default.
+// Description:     Sets how late a priority task may start before the run counts as
+// a FCS_TASKFAULT_Late fault.
+//***************************************************************************
+extern bool FCS_TASK_SCHDLR_setLateLimitHndl(FCS_TaskHandle_t hTask, uint32_t nTicks);
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_registerFaultCb
+// Returns:         void
+// Param1:          pfnFaultPolicy - Decides how a faulty task is handled, or NULL to
+//                  only count faults. Receives the task's handle, the fault and the
+//                  lateness or run time in ticks.
+// Description:     Registers the timing fault policy. Each run of a Low to Critical
+// priority task is checked once it returns:
+// - Lateness is the tick the run started at minus the tick of the release it serves.
+//   It is a fault when it exceeds the task's lateness limit.
+// - Run time is the number of ticks counted while the task ran. It is a fault when
+//   it exceeds the task's interval.
+// Faults are counted in the task's nLateCnt and nOvrnCnt, then passed to the policy
+// from the dispatcher, one call per fault. The policy's action is applied when it
+// returns. Demotion restarts the task's interval. A policy entering a safe state does
+// so itself, e.g. by removing or updating other tasks or by not returning.
+//***************************************************************************
+extern void FCS_TASK_SCHDLR_registerFaultCb(FCS_TaskFaultAction_e (*pfnFaultPolicy)(
+        FCS_TaskHandle_t hTask, FCS_TaskFault_e fault, uint32_t nTicks));
+
+#ifndef FCS_TASK_SCHDLR_PROFILE_DISABLE
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_getProfileHndl
+// Returns:         Success status of the retrieval.
+// Param1:          hTask - Handle of task to retrieve the profile of.
+// Param2:          *pProfile - Receives a copy of the profile.
+// Description:     Retrieves a task's execution time profile. Every run of a task is
+// measured, whatever its priority level, starting from when the task was added or its
+// profile was last cleared. The minimum and mean are 0 until the task has run.
+//***************************************************************************
+extern bool FCS_TASK_SCHDLR_getProfileHndl(FCS_TaskHandle_t hTask, FCS_TaskProfile_t *pProfile);
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_clearProfileHndl
+// Returns:         Success status of the change.
+// Param1:          hTask - Handle of task to change.
+// Description:     Resets a task's execution time profile.
+//***************************************************************************
+extern bool FCS_TASK_SCHDLR_clearProfileHndl(FCS_TaskHandle_t hTask);
+#endif
+
+#ifdef FCS_TASK_SCHDLR_WATCHDOG_ENABLE
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_setHeartbeatHndl
+// Returns:         Success status of the change.
+// Param1:          hTask - Handle of task to change.
+// Param2:          nWindowTcks - Ticks the task may go without checking in, 0 to stop
+//                  supervising it.
+// Param3:          bManual - Only FCS_TASK_SCHDLR_checkInHndl checks in, not completed
+//                  runs.
+// Description:     Declares a task's expected check-in rate. The window starts from
+// now. By default every completed run checks in, which catches a task starved by
+// higher priority work or left removed without changing its code. A task that should
+// confirm progress of its own work, e.g. a protocol that keeps running while stuck,
+// checks in manually instead. A window should allow for the task's interval plus its
+// lateness and run time.
+//***************************************************************************
+extern bool FCS_TASK_SCHDLR_setHeartbeatHndl(FCS_TaskHandle_t hTask, uint32_t nWindowTcks,
+        bool bManual);
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_checkInHndl
+// Returns:         Success status of the check-in.
+// Param1:          hTask - Handle of task checking in.
+// Description:     Restarts a task's heartbeat window. Safe to call from interrupts.
+//***************************************************************************
+extern bool FCS_TASK_SCHDLR_checkInHndl(FCS_TaskHandle_t hTask);
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_registerWatchdogCb
+// Returns:         void
+// Param1:          pfnRefresh - Refreshes the hardware watchdog.
+// Param2:          nPeriodTcks - Ticks between heartbeat checks, at least 1.
+// Description:     Registers the watchdog refresh and starts supervising. The
+// dispatcher checks the heartbeat windows between tasks once nPeriodTcks ticks have
+// passed since the last check, so refreshes are never closer together than the
+// period. A windowed watchdog therefore needs a window shorter than the period and a
+// timeout longer than the period plus the longest task run. In tickless mode the
+// timer wakes the dispatcher for every check.
+//***************************************************************************
+extern void FCS_TASK_SCHDLR_registerWatchdogCb(void (*pfnRefresh)(void), uint32_t nPeriodTcks);
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_watchdogIsr
+// Returns:         void
+// Param1:          void
+// Description:     Records the task being run when the watchdog times out, unless a
+// starved task was recorded already. Call from the watchdog interrupt that precedes
+// its reset. Only a few stores are made, to finish before the reset.
+//***************************************************************************
+extern void FCS_TASK_SCHDLR_watchdogIsr(void);
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_getWatchdogRecord
+// Returns:         True if a reset cause was recorded since the record was cleared.
+// Param1:          *pRecord - Receives the record.
+// Description:     Retrieves the task that caused a watchdog reset. The record is kept
+// in the .noinit section, which the startup code leaves as it was, so it survives
+// every reset but power-on. A check word rejects the random contents after power-on.
+//***************************************************************************
+extern bool FCS_TASK_SCHDLR_getWatchdogRecord(FCS_TaskWdogRecord_t *pRecord);
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_clearWatchdogRecord
+// Returns:         void
+// Param1:          void
+// Description:     Discards the reset cause record, e.g. once it has been logged.
+//***************************************************************************
+extern void FCS_TASK_SCHDLR_clearWatchdogRecord(void);
+#endif
+
+#ifdef FCS_TASK_SCHDLR_SLEEP_ENABLE
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_registerSleepCb
+// Returns:         Success status, false for more than FCS_TASK_SCHDLR_SLEEP_MODES modes.
+// Param1:          pfnSleep - Sleeps in the given mode, see the description.
+// Param2:          *pnLatencyUs - Expected wake-up latency of each mode in microseconds,
+//                  e.g. from the data sheet. Copied.
+// Param3:          nModes - Number of modes, shallowest first. 0 stops sleeping.
+// Description:     Registers the sleep callback and restarts the mode statistics.
+// The dispatcher calls pfnSleep(nMode, nTicks) with interrupts masked when it has
+// nothing to run. Mode 0 is expected to keep the tick timer running (e.g. WFI) and
+// return at the next interrupt, and is used while its latency is below a tick. Deeper
+// modes may stop the tick timer. They have to wake up by themselves after nTicks
+// ticks, FCS_TASK_SCHDLR_IDLE_FOREVER for no limit, and credit the ticks slept with
+// FCS_TASK_SCHDLR_clockTicks. nTicks leaves room for the mode's latency and one tick
+// in progress before the deadline. Any interrupt may end the sleep early.
+// The callback returns the wake-up latency it measured, from its wake-up time until
+// it returns, in microseconds, or FCS_TASK_SCHDLR_SLEEP_EARLY if something else woke
+// it up. Pending interrupts are taken after it returns.
+//***************************************************************************
+extern bool FCS_TASK_SCHDLR_registerSleepCb(uint32_t (*pfnSleep)(uint8_t nMode, uint32_t nTicks),
+        const uint32_t *pnLatencyUs, uint8_t nModes);
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_getSleepStats
+// Returns:         Success status, false for an unregistered mode.
+// Param1:          nMode - Sleep mode.
+// Param2:          *pStats - Receives the mode's statistics.
+// Description:     Reads how often a mode was entered and how fast it woke up.
+//***************************************************************************
+extern bool FCS_TASK_SCHDLR_getSleepStats(uint8_t nMode, FCS_TaskSleepStats_t *pStats);
+#endif
+
+#ifdef FCS_TASK_SCHDLR_LOAD_ENABLE
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_getLoad
+// Returns:         void
+// Param1:          *pLoad - Receives the CPU load.
+// Description:     Reads the CPU load averaged over the last 1, 10 and 60 whole
+// seconds, and the busiest tick. Until a window has filled it averages the seconds
+// seen so far. Ticks credited together, e.g. after a tickless span or a task
+// overrunning its tick, count with their mean load towards the peak. Call from a
+// task.
+// The load covers the priority and signaled tasks, the work that has deadlines, so
+// 100% less the load is the headroom left for them. Idle tasks are reported apart in
+// the nIdleTask fields, the cycles spent inside them over the same windows, and the
+// MCU is busy for the sum of both. Neither counts the dispatcher looking for work
+// between idle task runs.
+//***************************************************************************
+extern void FCS_TASK_SCHDLR_getLoad(FCS_TaskLoad_t *pLoad);
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_clearLoadPeak
+// Returns:         void
+// Param1:          void
+// Description:     Restarts the search for the busiest tick. Call from a task.
+//***************************************************************************
+extern void FCS_TASK_SCHDLR_clearLoadPeak(void);
+#endif
 
 //***************************************************************************
 // Function Name:   FCS_TASK_SCHDLR_dispatcher
@@ -154,19 +842,46 @@ extern FCS_Task_t FCS_TASK_SCHDLR_getTask(FCS_TaskCode_t taskCode, void *pTaskAr
 // Param1:          void
 // Description:     Main loop to process the task list. The scheduler's clock tick
 // counter is monitored and tasks are dispatched at their defined intervals in order
-// of priority level.
+// of priority level. Signaled tasks run between tick passes, ahead of idle tasks.
+//
+// Without FCS_TASK_SCHDLR_WHEEL_ENABLE or FCS_TASK_SCHDLR_EDF_ENABLE, a tick pass
+// only queues the due tasks in one ready bitmap per priority level. The dispatcher
+// then runs the highest ready task, found with CLZ on a word of level bits, and
+// checks for ticks again before the next one. A task released by a newer tick thus
+// runs ahead of lower priority tasks still waiting from an older one. Ready tasks of
+// the same level run in order of task ID.
+//
+// With FCS_TASK_SCHDLR_WHEEL_ENABLE released tasks wait on one ready list per level
+// instead, in order of release, and also run one at a time with a check for ticks
+// in between. A task is thus held up by at most one lower priority task in any build
+// but EDF and cyclic.
 //***************************************************************************
 extern void FCS_TASK_SCHDLR_dispatcher(void);
 
 extern void Scheduler_Init();
 
+#ifdef FCS_TASK_SCHDLR_TICKLESS_ENABLE
 //***************************************************************************
-// Function Name:   FCS_TASK_SCHDLR_dispatcher
+// Function Name:   FCS_TASK_SCHDLR_registerTicklessCb
 // Returns:         void
-// Param1:          void
-// Description:
+// Param1:          pfnSetTickSpan - Programs the tick timer to interrupt once after
+//                  the given number of ticks, counted from the last tick it credited.
+// Description:     Registers the timer callback used to suppress idle clock ticks.
+// The callback is invoked from the dispatcher each time the tick count or the task
+// list changed and no ticks are waiting to be processed.
 //***************************************************************************
+extern void FCS_TASK_SCHDLR_registerTicklessCb(void (*pfnSetTickSpan)(uint32_t nTicks));
+#endif
+
 #ifdef _DEBUG_ENABLE
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_registerTimingCbs
+// Returns:         void
+// Param1:          pfnTimingStart - Called before each priority task runs, or NULL.
+// Param2:          pfnTimingStop - Called after each priority task ran, or NULL.
+// Description:     Registers hooks around priority task runs, e.g. to toggle a pin
+// for an oscilloscope. Either hook may be left unregistered.
+//***************************************************************************
 extern void FCS_TASK_SCHDLR_registerTimingCbs(void (*pfnTimingStart)(void),
         void (*pfnTimingStop)(void));
 #endif
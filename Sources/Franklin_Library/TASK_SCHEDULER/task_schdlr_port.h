@@ -0,0 +1,160 @@
+//***********************************************************************************
+// Module Name:         task_schdlr_port.h
+// Application:
+// Platform:            Kinetis K22 (Cortex-M4F), GNU C Compiler
+// Author(s):           Derrick Simeon
+// Notes:
+// Description:
+// Processor specific primitives used by the task scheduler. The Cortex-M definitions
+// access the core's system control space directly so the scheduler does not depend on
+// generated device headers. Other targets (e.g. a host build of the scheduler) get
+// definitions without interrupt hardware: critical sections do nothing and a pended
+// Immediate dispatch runs synchronously.
+// Copyright (c) 2016, Franklin Control Systems, all rights reserved
+//***********************************************************************************
+
+#ifndef TASK_SCHDLR_PORT_H_
+#define TASK_SCHDLR_PORT_H_
+
+//**************
+// Includes
+//**************
+
+// Standard C libraries
+#include <stdint.h>
+
+//**************
+// Defines
+//**************
+
+// Implemented interrupt priority bits (4 on Kinetis K series).
+#ifndef FCS_TASK_SCHDLR_PORT_PRIO_BITS
+#define FCS_TASK_SCHDLR_PORT_PRIO_BITS  4
+#endif
+
+// Index of the highest set bit, 0 for a value of 0. A single CLZ instruction on the
+// Cortex-M4.
+#define FCS_TASK_SCHDLR_PORT_LOG2(val)  (31U - (uint32_t) __builtin_clz((uint32_t) (val) | 1U))
+
+#if defined(__arm__)
+
+#define FCS_TASK_SCHDLR_PORT_ICSR       (*(volatile uint32_t *) 0xE000ED04UL)  // Interrupt control and state
+#define FCS_TASK_SCHDLR_PORT_SHPR3      (*(volatile uint32_t *) 0xE000ED20UL)  // PendSV/SysTick priorities
+#define FCS_TASK_SCHDLR_PORT_PENDSVSET  (1UL << 28)                           // Pend PendSV
+#define FCS_TASK_SCHDLR_PORT_DEMCR      (*(volatile uint32_t *) 0xE000EDFCUL)  // Debug exception and monitor control
+#define FCS_TASK_SCHDLR_PORT_DWT_CTRL   (*(volatile uint32_t *) 0xE0001000UL)  // DWT control
+#define FCS_TASK_SCHDLR_PORT_DWT_CYCCNT (*(volatile uint32_t *) 0xE0001004UL)  // DWT cycle counter
+
+// Starts the free-running core cycle counter.
+#define FCS_TASK_SCHDLR_PORT_CYCLES_INIT() \
+        do { \
+            FCS_TASK_SCHDLR_PORT_DEMCR |= (1UL << 24); \
+            FCS_TASK_SCHDLR_PORT_DWT_CTRL |= 1UL; \
+        } while(0)
+
+// Reads the core cycle counter. Wraps every 2^32 cycles.
+#define FCS_TASK_SCHDLR_PORT_CYCLES()   FCS_TASK_SCHDLR_PORT_DWT_CYCCNT
+
+// Encodes a priority level (0 = highest) as the core's priority byte.
+#define FCS_TASK_SCHDLR_PORT_PRIO(prio) \
+        ((uint32_t) (prio) << (8 - FCS_TASK_SCHDLR_PORT_PRIO_BITS))
+
+// Pends the Immediate task dispatch (PendSV).
+#define FCS_TASK_SCHDLR_PORT_PEND_IMMEDIATE() \
+        (FCS_TASK_SCHDLR_PORT_ICSR = FCS_TASK_SCHDLR_PORT_PENDSVSET)
+
+// Sets the priority of the Immediate task dispatch (PendSV).
+#define FCS_TASK_SCHDLR_PORT_SET_IMMEDIATE_PRIO(prio) \
+        (FCS_TASK_SCHDLR_PORT_SHPR3 = (FCS_TASK_SCHDLR_PORT_SHPR3 & ~(0xFFUL << 16)) \
+                | (FCS_TASK_SCHDLR_PORT_PRIO(prio) << 16))
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_PORT_enterCritical
+// Returns:         Interrupt mask state to restore.
+// Param1:          void
+// Description:     Masks all maskable interrupts. Nests.
+//***************************************************************************
+static inline uint32_t FCS_TASK_SCHDLR_PORT_enterCritical(void)
+{
+    uint32_t nState;
+
+    __asm volatile ("mrs %0, primask\n\tcpsid i" : "=r" (nState) : : "memory");
+
+    return nState;
+}
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_PORT_exitCritical
+// Returns:         void
+// Param1:          nState - State returned by FCS_TASK_SCHDLR_PORT_enterCritical.
+// Description:     Restores the interrupt mask.
+//***************************************************************************
+static inline void FCS_TASK_SCHDLR_PORT_exitCritical(uint32_t nState)
+{
+    __asm volatile ("msr primask, %0" : : "r" (nState) : "memory");
+}
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_PORT_raiseBasePri
+// Returns:         BASEPRI value to restore.
+// Param1:          prio - Priority level to mask, along with all lower levels.
+// Description:     Raises the interrupt masking ceiling. Never lowers it, so nests.
+//***************************************************************************
+static inline uint32_t FCS_TASK_SCHDLR_PORT_raiseBasePri(uint32_t prio)
+{
+    uint32_t nState;
+
+    __asm volatile ("mrs %0, basepri" : "=r" (nState) : : "memory");
+    __asm volatile ("msr basepri_max, %0" : : "r" (FCS_TASK_SCHDLR_PORT_PRIO(prio)) : "memory");
+
+    return nState;
+}
+
+//***************************************************************************
+// Function Name:   FCS_TASK_SCHDLR_PORT_restoreBasePri
+// Returns:         void
+// Param1:          nState - Value returned by FCS_TASK_SCHDLR_PORT_raiseBasePri.
+// Description:     Restores the interrupt masking ceiling.
+//***************************************************************************
+static inline void FCS_TASK_SCHDLR_PORT_restoreBasePri(uint32_t nState)
+{
+    __asm volatile ("msr basepri, %0" : : "r" (nState) : "memory");
+}
+
+#else
+
+extern void FCS_TASK_SCHDLR_immediateIsr(void);
+
+#define FCS_TASK_SCHDLR_PORT_PEND_IMMEDIATE()           FCS_TASK_SCHDLR_immediateIsr()
+#define FCS_TASK_SCHDLR_PORT_SET_IMMEDIATE_PRIO(prio)   ((void) (prio))
+#define FCS_TASK_SCHDLR_PORT_CYCLES_INIT()              ((void) 0)
+
+// No cycle counter unless the host build provides one.
+#ifndef FCS_TASK_SCHDLR_PORT_CYCLES
+#define FCS_TASK_SCHDLR_PORT_CYCLES()                   0UL
+#endif
+
+static inline uint32_t FCS_TASK_SCHDLR_PORT_enterCritical(void)
+{
+    return 0;
+}
+
+static inline void FCS_TASK_SCHDLR_PORT_exitCritical(uint32_t nState)
+{
+    (void) nState;
+}
+
+static inline uint32_t FCS_TASK_SCHDLR_PORT_raiseBasePri(uint32_t prio)
+{
+    (void) prio;
+    return 0;
+}
+
+static inline void FCS_TASK_SCHDLR_PORT_restoreBasePri(uint32_t nState)
+{
+    (void) nState;
+}
+
+#endif
+
+#endif /* TASK_SCHDLR_PORT_H_ */
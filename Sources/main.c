@@ -49,7 +49,7 @@
 
 /* User includes (#include below this line is not maintained by Processor Expert) */
 uint32_t comp = 0;
-void Task_led_blink()
+void Task_led_blink(void)
 {
   /* Write your code here ... */
   BLUE_SetVal();
@@ -67,17 +67,14 @@ void Task_led_blink()
 
 }
 
-volatile uint32_t count = 0, count1 = 0;
-
-volatile uint32_t *DWT_CONTROL1 = (uint32_t *)0xE0001000;
-volatile uint32_t *DWT_CYCCNT1 = (uint32_t *)0xE0001004;
-volatile uint32_t *DEMCR1 = (uint32_t *)0xE000EDFC;
-
 /*lint -save  -e970 Disable MISRA rule (6.3) checking. */
 int main(void)
 /*lint -restore Enable MISRA rule (6.3) checking. */
 {
   /* Write your local variable definition here */
+#ifdef FCS_TASK_SCHDLR_WATCHDOG_ENABLE
+  FCS_TaskHandle_t hLedBlink;
+#endif
 
   /*** Processor Expert internal initialization. DON'T REMOVE THIS CODE!!! ***/
   PE_low_level_init();
@@ -85,6 +82,12 @@ int main(void)
 
   /* Write your code here */
   Scheduler_Init();
+#ifdef FCS_TASK_SCHDLR_TICKLESS_ENABLE
+  TU1_TicklessInit();
+#endif
+#ifdef FCS_TASK_SCHDLR_SLEEP_ENABLE
+  SMC_SleepInit();
+#endif
   /* For example: for(;;) { } */
 
   /*** Don't write any code pass this line, or it will be deleted during code generation. ***/
@@ -96,42 +99,22 @@ int main(void)
   BLUE_SetVal();
   Green_SetVal();
 
-  /* For example: for(;;) { } */
-  while(1)
-    {
-      count = 0;
-      *DWT_CYCCNT1 = 0;
-      // enable cycle counter
-      *DWT_CONTROL1 = *DWT_CONTROL1 | 1 ;
-      RED_SetVal();
-      count1 = 0;
-      count1 = count1 +2;
-      count1 = count1 +2;
-      count1 = count1 +2;
-      count1 = count1 +2;
-      RED_ClrVal();
-      //read the counts
-      count = *DWT_CYCCNT1;
-      //Actual execution time = count * Time for One System Clock
-
-      count = 0;
-      *DWT_CYCCNT1 = 0;
-      // enable cycle counter
-      *DWT_CONTROL1 = *DWT_CONTROL1 | 1 ;
-      count1 = 0;
-      count1 = count1 +2;
-      count1 = count1 +2;
-      count1 = count1 +2;
-      count1 = count1 +2;
-      RED_SetVal();
-      //read the counts
-      count = *DWT_CYCCNT1;
-      //Actual execution time = count * Time for One System Clock
-    }
-
-  while(1);
-
+#ifndef FCS_TASK_SCHDLR_STATIC_ENABLE
+  // Tasks of a static build are listed in task_schdlr_tasks.h.
+#ifdef FCS_TASK_SCHDLR_WATCHDOG_ENABLE
+  hLedBlink = FCS_TASK_SCHDLR_addTask((FCS_TaskCode_t) &Task_led_blink, NULL, 1000, FCS_TASKPRIORITY_Normal);
+#else
   FCS_TASK_SCHDLR_addTask((FCS_TaskCode_t) &Task_led_blink, NULL, 1000, FCS_TASKPRIORITY_Normal);
+#endif
+#elif defined(FCS_TASK_SCHDLR_WATCHDOG_ENABLE)
+  hLedBlink = FCS_TASK_SCHDLR_HANDLE(ledBlink);
+#endif
+
+#ifdef FCS_TASK_SCHDLR_WATCHDOG_ENABLE
+  // Reset unless the LED task completes a run at least every 2 s.
+  FCS_TASK_SCHDLR_setHeartbeatHndl(hLedBlink, 2000, false);
+  WDOG_SupervisorInit();
+#endif
 
   // Run the dispatcher.
   FCS_TASK_SCHDLR_dispatcher();
@@ -0,0 +1,27 @@
+//***********************************************************************************
+// Module Name:         mem_pool_classes.h
+// Application:
+// Platform:            Kinetis K22 (Cortex-M4F), GNU C Compiler
+// Author(s):           Derrick Simeon
+// Notes:
+// Description:
+// Block size classes of the application's memory pools. Each POOL entry lists the
+// block size in bytes, a multiple of 8, and the number of blocks, at most 65535.
+// Entries must be in increasing order of block size. The pools are placed in the
+// .mem_pool section reserved by ProcessorExpert.ld.
+// Copyright (c) 2016, Franklin Control Systems, all rights reserved
+//***********************************************************************************
+
+#ifndef MEM_POOL_CLASSES_H_
+#define MEM_POOL_CLASSES_H_
+
+//**************
+// Defines
+//**************
+
+#define FCS_MEM_POOL_CLASSES(POOL) \
+    POOL(32, 32) \
+    POOL(128, 16) \
+    POOL(512, 4)
+
+#endif /* MEM_POOL_CLASSES_H_ */
@@ -0,0 +1,22 @@
+//***********************************************************************************
+// Module Name:         task_schdlr_frames.h
+// Description:
+// Cyclic executive frame table for FCS_TASK_SCHDLR_CYCLIC_ENABLE. Generated by
+// Tools/fcs_cyc from Tools/fcs_rta/tasks.txt, do not edit.
+//***********************************************************************************
+
+#ifndef TASK_SCHDLR_FRAMES_H_
+#define TASK_SCHDLR_FRAMES_H_
+
+#define FCS_TASK_SCHDLR_FRAME_TCKS      1000   // Minor frame in ticks
+#define FCS_TASK_SCHDLR_FRAMES          1   // Frames per major cycle of 1000 ticks
+
+// Tasks run by each frame, in order
+#define FCS_TASK_SCHDLR_FRAME_TASKS \
+    /* 0 */ FCS_TASKID_ledBlink,
+
+// First entry of each frame in FCS_TASK_SCHDLR_FRAME_TASKS, then the entry count
+#define FCS_TASK_SCHDLR_FRAME_START \
+    0, 1
+
+#endif /* TASK_SCHDLR_FRAMES_H_ */
@@ -0,0 +1,38 @@
+//***********************************************************************************
+// Module Name:         task_schdlr_tasks.h
+// Application:
+// Platform:            Kinetis K22 (Cortex-M4F), GNU C Compiler
+// Author(s):           Derrick Simeon
+// Notes:
+// Description:
+// Static task table of the application, used when the task scheduler is built with
+// FCS_TASK_SCHDLR_STATIC_ENABLE. Each TASK entry lists the task's name, code, optional
+// argument, dispatch interval in ticks and priority level. Tasks of the same priority
+// level are dispatched in table order.
+// Copyright (c) 2016, Franklin Control Systems, all rights reserved
+//***********************************************************************************
+
+#ifndef TASK_SCHDLR_TASKS_H_
+#define TASK_SCHDLR_TASKS_H_
+
+//**************
+// Includes
+//**************
+
+// Standard C libraries
+#include <stddef.h>
+
+//**************
+// Defines
+//**************
+
+#define FCS_TASK_SCHDLR_TASKS(TASK) \
+    TASK(ledBlink, Task_led_blink, NULL, 1000, FCS_TASKPRIORITY_Normal)
+
+//**************
+// Global Functions
+//**************
+
+extern void Task_led_blink(void);
+
+#endif /* TASK_SCHDLR_TASKS_H_ */
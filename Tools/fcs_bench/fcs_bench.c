@@ -0,0 +1,330 @@
+//***********************************************************************************
+// Module Name:         fcs_bench.c
+// Application:         Host tool
+// Platform:            Any host with a C99 compiler and clock_gettime, or the target
+// Author(s):           Derrick Simeon
+// Notes:
+// Description:
+// Dispatch cost benchmark for the FCS task scheduler. Runs the real dispatcher over
+// task sets of 1 to 254 priority tasks and reports the time it spends per clock tick,
+// so the timing wheel and the structure-of-arrays layout can be compared with the
+// linear scan.
+//
+// The scheduler is linked in, so each dispatch engine is its own build:
+//     S=../../Sources/Franklin_Library/TASK_SCHEDULER
+//     F="-std=c99 -O2 -I$S -DFCS_TASK_SCHDLR_MAX_TASKS=255 -DFCS_TASK_SCHDLR_PROFILE_DISABLE"
+//     gcc $F -o fcs_bench_lin fcs_bench.c $S/task_schdlr.c
+//     gcc $F -DFCS_TASK_SCHDLR_WHEEL_ENABLE -o fcs_bench_whl fcs_bench.c $S/task_schdlr.c
+//     gcc $F -DFCS_TASK_SCHDLR_SOA_ENABLE -o fcs_bench_soa fcs_bench.c $S/task_schdlr.c
+// Usage:   fcs_bench [-t ticks] [-i minInterval] [-b baselineFile]
+//
+// Compare two engines by saving one's output as the baseline of the other:
+//     fcs_bench_lin > lin.txt
+//     fcs_bench_whl -b lin.txt
+//
+// On the target (__arm__) the figures are DWT core cycles and there is no main. Add
+// this file to the firmware build with the same defines and call FCS_BENCH_run in
+// place of FCS_TASK_SCHDLR_dispatcher, declared as extern void FCS_BENCH_run(void),
+// with the TU1 interrupt disabled so only the benchmark adds ticks. Once m_bBenchDone
+// is set, read the figures from m_aCycPerTick with the debugger.
+//
+// Task set:
+// Task i has the interval minInterval + (i * 37) % 1000 ticks (default minInterval 10)
+// and priority Low to Critical in turn, so few tasks are due on any one tick. Tasks
+// return at once, so the figures are the dispatcher's own cost. An idle task adds each
+// clock tick, so a tick costs one pass of the dispatcher loop plus one idle task run.
+//
+// Exit status: 0 on success, 2 on invalid input.
+// Copyright (c) 2016, Franklin Control Systems, all rights reserved
+//***********************************************************************************
+
+//**************
+// Includes
+//**************
+
+// Standard C libraries
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <time.h>
+
+// Project-specific modules
+#include "task_schdlr.h"
+#include "task_schdlr_port.h"
+
+//**************
+// Defines
+//**************
+
+#define BENCH_MAX_TASKS     254         // Priority tasks, leaving one slot for the idle task
+#define BENCH_LINE_LEN      256         // Longest baseline line
+#define BENCH_SETS          10          // Task set sizes measured
+
+#if defined(FCS_TASK_SCHDLR_WHEEL_ENABLE)
+#define BENCH_ENGINE        "wheel"
+#elif defined(FCS_TASK_SCHDLR_SOA_ENABLE)
+#define BENCH_ENGINE        "soa"
+#else
+#define BENCH_ENGINE        "linear"
+#endif
+
+//**************
+// Local Variables
+//**************
+
+static const uint32_t m_aSetSizes[BENCH_SETS] = { 1, 2, 4, 8, 16, 32, 64, 128, 192, 254 };
+
+static FCS_Task_t m_aTaskLst[BENCH_MAX_TASKS + 1];
+static uint32_t m_aTaskIds[BENCH_MAX_TASKS];            // Task arguments, each task needs its own
+static jmp_buf m_stopJmp;                               // Leaves the dispatcher
+static uint32_t m_nTicks;                               // Ticks added so far
+static uint32_t m_nTickLim;                             // Ticks to run
+static uint32_t m_nRuns;                                // Priority task runs
+#if defined(__arm__)
+static volatile uint32_t m_aCycPerTick[BENCH_SETS];     // Results, read with the debugger
+static volatile bool m_bBenchDone = false;              // Results are complete
+#endif
+
+//**************
+// Local Functions
+//**************
+
+static void _BENCH_task(void *pArg);
+static void _BENCH_tick(void);
+static double _BENCH_run(uint32_t nTasks, uint32_t nMinIntvl);
+#if !defined(__arm__)
+static double _BENCH_baseline(FILE *pFile, uint32_t nTasks);
+#endif
+
+//***************************************************************************
+// Function Name:   _BENCH_task
+// Returns:         void
+// Param1:          *pArg - Task number.
+// Description:     Priority task. Counts its runs.
+//***************************************************************************
+static void _BENCH_task(void *pArg)
+{
+    (void) pArg;
+    m_nRuns++;
+}
+
+//***************************************************************************
+// Function Name:   _BENCH_tick
+// Returns:         void
+// Param1:          void
+// Description:     Idle task. Adds a clock tick, or leaves the dispatcher once the
+// run is complete.
+//***************************************************************************
+static void _BENCH_tick(void)
+{
+    if(m_nTicks == m_nTickLim)
+    {
+        longjmp(m_stopJmp, 1);
+    }
+
+    m_nTicks++;
+    FCS_TASK_SCHDLR_clockTick();
+}
+
+//***************************************************************************
+// Function Name:   _BENCH_run
+// Returns:         Nanoseconds per tick, core cycles per tick on the target.
+// Param1:          nTasks - Priority tasks.
+// Param2:          nMinIntvl - Shortest task interval in ticks.
+// Description:     Runs the dispatcher over a fresh task set for m_nTickLim ticks.
+//***************************************************************************
+static double _BENCH_run(uint32_t nTasks, uint32_t nMinIntvl)
+{
+#if defined(__arm__)
+    volatile uint32_t nStartCyc;
+#else
+    struct timespec start;
+    struct timespec stop;
+#endif
+    FCS_TaskCode_t taskCode;
+    uint32_t idx;
+
+    FCS_TASK_SCHDLR_init(m_aTaskLst, (uint8_t) (nTasks + 1));
+
+    for(idx = 0; idx < nTasks; idx++)
+    {
+        m_aTaskIds[idx] = idx;
+        taskCode.pfnHasArg = &_BENCH_task;
+        (void) FCS_TASK_SCHDLR_addTask(taskCode, &m_aTaskIds[idx], nMinIntvl + ((idx * 37) % 1000),
+                (FCS_TaskPriority_e) (FCS_TASKPRIORITY_Low + (idx % 4)));
+    }
+
+    taskCode.pfnNoArg = &_BENCH_tick;
+    (void) FCS_TASK_SCHDLR_addTask(taskCode, NULL, 0, FCS_TASKPRIORITY_Idle);
+
+    m_nTicks = 0;
+    m_nRuns = 0;
+
+#if defined(__arm__)
+    nStartCyc = FCS_TASK_SCHDLR_PORT_CYCLES();
+
+    if(setjmp(m_stopJmp) == 0)
+    {
+        FCS_TASK_SCHDLR_dispatcher();
+    }
+
+    return (double) (FCS_TASK_SCHDLR_PORT_CYCLES() - nStartCyc) / m_nTickLim;
+#else
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    if(setjmp(m_stopJmp) == 0)
+    {
+        FCS_TASK_SCHDLR_dispatcher();
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+
+    return (((double) (stop.tv_sec - start.tv_sec) * 1e9) + (double) (stop.tv_nsec - start.tv_nsec))
+            / m_nTickLim;
+#endif
+}
+
+#if defined(__arm__)
+//***************************************************************************
+// Function Name:   FCS_BENCH_run
+// Returns:         void, does not return.
+// Param1:          void
+// Description:     Measures each task set size for 10000 ticks, with intervals from
+// 10 ticks, and stores the core cycles per tick in m_aCycPerTick in the order of
+// m_aSetSizes. Then waits in a loop for the debugger.
+//***************************************************************************
+void FCS_BENCH_run(void)
+{
+    uint32_t nSet;
+
+    FCS_TASK_SCHDLR_PORT_CYCLES_INIT();
+    m_nTickLim = 10000;
+
+    for(nSet = 0; nSet < BENCH_SETS; nSet++)
+    {
+        m_aCycPerTick[nSet] = (uint32_t) _BENCH_run(m_aSetSizes[nSet], 10);
+    }
+
+    m_bBenchDone = true;
+
+    while(m_bBenchDone)
+    {
+        // Read m_aCycPerTick with the debugger.
+    }
+}
+#else
+
+//***************************************************************************
+// Function Name:   _BENCH_baseline
+// Returns:         Nanoseconds per tick of the baseline, or 0 if it has no figure.
+// Param1:          *pFile - Output of another build of this benchmark.
+// Param2:          nTasks - Priority tasks.
+// Description:     Looks up the baseline figure for a task set size.
+//***************************************************************************
+static double _BENCH_baseline(FILE *pFile, uint32_t nTasks)
+{
+    char line[BENCH_LINE_LEN];
+    unsigned long nLineTasks;
+    double nsPerTick;
+
+    rewind(pFile);
+
+    while(fgets(line, sizeof(line), pFile) != NULL)
+    {
+        if((line[0] != '#') && (sscanf(line, "%lu %lf", &nLineTasks, &nsPerTick) == 2)
+                && (nLineTasks == nTasks))
+        {
+            return nsPerTick;
+        }
+    }
+
+    return 0.0;
+}
+
+//***************************************************************************
+// Function Name:   main
+// Returns:         0 on success, 2 on invalid input.
+// Param1:          argc - Number of arguments.
+// Param2:          **argv - Arguments.
+// Description:     Measures each task set size and prints the cost per tick.
+//***************************************************************************
+int main(int argc, char **argv)
+{
+    FILE *pBase = NULL;
+    uint32_t nMinIntvl = 10;
+    uint32_t nSet;
+    double nsPerTick;
+    double nsBase;
+    int arg;
+
+    m_nTickLim = 100000;
+
+    for(arg = 1; arg < argc; arg++)
+    {
+        if((argv[arg][0] == '-') && (argv[arg][1] != '\0') && (argv[arg][2] == '\0') && ((arg + 1) < argc))
+        {
+            switch(argv[arg][1])
+            {
+                case 't':
+                    m_nTickLim = (uint32_t) strtoul(argv[++arg], NULL, 10);
+                    continue;
+                case 'i':
+                    nMinIntvl = (uint32_t) strtoul(argv[++arg], NULL, 10);
+                    continue;
+                case 'b':
+                    pBase = fopen(argv[++arg], "r");
+
+                    if(pBase == NULL)
+                    {
+                        fprintf(stderr, "fcs_bench: cannot open %s\n", argv[arg]);
+                        return 2;
+                    }
+                    continue;
+                default:
+                    break;
+            }
+        }
+
+        fprintf(stderr, "usage: fcs_bench [-t ticks] [-i minInterval] [-b baselineFile]\n");
+        return 2;
+    }
+
+    if((m_nTickLim == 0) || (nMinIntvl == 0))
+    {
+        fprintf(stderr, "fcs_bench: ticks and interval must be at least 1\n");
+        return 2;
+    }
+
+    printf("# fcs_bench %s, %lu ticks, intervals from %lu ticks\n", BENCH_ENGINE,
+            (unsigned long) m_nTickLim, (unsigned long) nMinIntvl);
+    printf("# tasks   ns/tick      runs%s\n", (pBase != NULL) ? "  baseline   speedup" : "");
+
+    for(nSet = 0; nSet < BENCH_SETS; nSet++)
+    {
+        nsPerTick = _BENCH_run(m_aSetSizes[nSet], nMinIntvl);
+        printf("%7lu %9.1f %9lu", (unsigned long) m_aSetSizes[nSet], nsPerTick,
+                (unsigned long) m_nRuns);
+
+        if(pBase != NULL)
+        {
+            nsBase = _BENCH_baseline(pBase, m_aSetSizes[nSet]);
+
+            if(nsBase > 0.0)
+            {
+                printf(" %9.1f %8.2fx", nsBase, nsBase / nsPerTick);
+            }
+        }
+
+        printf("\n");
+    }
+
+    if(pBase != NULL)
+    {
+        fclose(pBase);
+    }
+
+    return 0;
+}
+#endif
@@ -0,0 +1,608 @@
+//***********************************************************************************
+// Module Name:         fcs_cyc.c
+// Application:         Host tool
+// Platform:            Any host with a C99 compiler
+// Author(s):           Derrick Simeon
+// Notes:
+// Description:
+// Cyclic executive table generator for the FCS task scheduler. Computes the major
+// cycle (hyperperiod) and a minor frame for a fixed multi-rate task set, packs every
+// job of the major cycle into a frame and writes the frame table used by the
+// scheduler's FCS_TASK_SCHDLR_CYCLIC_ENABLE mode.
+//
+// Build:   gcc -std=c99 -O2 -I../fcs_taskfile -o fcs_cyc fcs_cyc.c
+//              ../fcs_taskfile/fcs_taskfile.c
+// Usage:   fcs_cyc [-c cyclesPerTick] [-f frameTicks] [-o framesHeader] taskFile
+//
+// The task file is read by Tools/fcs_taskfile, as for Tools/fcs_rta, one task per line:
+//     name  interval  priority  wcet  [deadline]
+// - name is the task's name in the static task table (task_schdlr_tasks.h).
+// - interval and deadline are in ticks. The deadline defaults to the interval and
+//   must be a whole number of ticks no larger than it.
+// - priority is Idle, Low, Normal, High, Critical or Immediate. Idle and Immediate
+//   tasks are not run from frames and are skipped.
+// - wcet is in ticks or in core cycles with a "c" suffix (e.g. 5400c). Trace WCETs
+//   ("-") are not supported.
+// Text after a '#' is ignored.
+//
+// Frame selection:
+// A frame size f is usable when it divides the hyperperiod, holds the longest task
+// (jobs are never split) and leaves a whole frame between each release and deadline,
+// i.e. 2f - gcd(f, interval) <= deadline. Usable sizes are tried from the largest
+// down, or only -f if given. Jobs are packed frame by frame, earliest deadline first,
+// into frames starting at or after their release and ending by their deadline. Within
+// a frame tasks run by priority level, then deadline. The task set is rejected when
+// no frame size packs every job.
+//
+// Exit status: 0 if the table was generated, 1 if the task set cannot be packed, 2 on
+// invalid input. Intended to be run as a build step.
+// Copyright (c) 2016, Franklin Control Systems, all rights reserved
+//***********************************************************************************
+
+//**************
+// Includes
+//**************
+
+// Standard C libraries
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+// Project-specific modules
+#include "fcs_taskfile.h"
+
+//**************
+// Defines
+//**************
+
+#define CYC_MAX_TASKS       FCS_TASKFILE_MAX_TASKS
+#define CYC_NAME_LEN        FCS_TASKFILE_NAME_LEN
+#define CYC_MAX_ENTRIES     65535       // Frame table indexes are 16 bits
+
+// Priority levels, as in FCS_TaskPriority_e
+#define CYC_PRTY_IDLE       FCS_TASKFILE_PRTY_IDLE
+#define CYC_PRTY_IMMEDIATE  FCS_TASKFILE_PRTY_IMMEDIATE
+
+//**************
+// Local Typedefs
+//**************
+
+// Periodic task
+typedef struct _CYC_Task_t {
+    char        name[CYC_NAME_LEN];     // Task name
+    uint32_t    nIntvlTcks;             // Interval in ticks, at least 1
+    int         prty;                   // Priority level
+    double      wcet;                   // Worst-case execution time in ticks
+    bool        bWcetCyc;               // WCET was given in cycles
+    uint32_t    nDlTcks;                // Relative deadline in ticks
+} CYC_Task_t;
+
+// Job of a task within the major cycle
+typedef struct _CYC_Job_t {
+    uint8_t     task;                   // Index of the task
+    uint32_t    nRlsTck;                // Release tick
+    uint32_t    nDlTck;                 // Absolute deadline tick
+    uint32_t    nFrame;                 // Frame the job runs in, UINT32_MAX if not packed
+} CYC_Job_t;
+
+//**************
+// Local Variables
+//**************
+
+static CYC_Task_t m_aTasks[CYC_MAX_TASKS];  // Periodic tasks, in order of the task file
+static int m_nTasks = 0;                    // Number of periodic tasks
+static double m_nCycPerTick = 0.0;          // Core cycles per tick, 0 if not given
+
+static CYC_Job_t *m_pJobs = NULL;           // Jobs of the major cycle
+static uint32_t m_nJobs = 0;                // Number of jobs
+static double *m_pFrmLoad = NULL;           // Packed ticks, per frame
+
+//**************
+// Local Functions
+//**************
+
+static void _CYC_usage(void);
+static bool _CYC_readTasks(const char *pPath);
+static uint32_t _CYC_gcd(uint32_t a, uint32_t b);
+static uint64_t _CYC_hyperperiod(void);
+static bool _CYC_frameUsable(uint32_t nFrmTcks, uint64_t nHyper);
+static int _CYC_jobOrder(const void *pA, const void *pB);
+static bool _CYC_pack(uint32_t nFrmTcks, uint32_t nFrames);
+static bool _CYC_write(const char *pPath, const char *pTaskFile, uint32_t nFrmTcks,
+        uint32_t nFrames);
+
+//***************************************************************************
+// Function Name:   _CYC_usage
+// Returns:         void
+// Param1:          void
+// Description:     Prints the command line usage.
+//***************************************************************************
+static void _CYC_usage(void)
+{
+    fprintf(stderr, "usage: fcs_cyc [-c cyclesPerTick] [-f frameTicks] [-o framesHeader] taskFile\n");
+}
+
+//***************************************************************************
+// Function Name:   _CYC_readTasks
+// Returns:         Success status of the parsing.
+// Param1:          *pPath - Task file to read.
+// Description:     Reads the periodic tasks of the task set.
+//***************************************************************************
+static bool _CYC_readTasks(const char *pPath)
+{
+    static FCS_TaskFileEntry_t aEntries[CYC_MAX_TASKS];
+    FCS_TaskFileEntry_t *pEntry;
+    CYC_Task_t *pTask;
+    int nEntries = FCS_TASKFILE_read(pPath, aEntries, CYC_MAX_TASKS);
+    int i;
+
+    if(nEntries < 0)
+    {
+        return false;
+    }
+
+    for(i = 0; i < nEntries; i++)
+    {
+        pEntry = &aEntries[i];
+
+        if((pEntry->prty == CYC_PRTY_IDLE) || (pEntry->prty == CYC_PRTY_IMMEDIATE))
+        {
+            // Not run from frames.
+            continue;
+        }
+
+        if(pEntry->bWcetTrace)
+        {
+            fprintf(stderr, "%s:%d: wcet from a trace is not supported\n", pPath, pEntry->nLine);
+            return false;
+        }
+
+        if((pEntry->dline != (uint32_t) pEntry->dline) || (pEntry->dline > pEntry->nIntvlTcks))
+        {
+            fprintf(stderr, "%s:%d: deadline must be whole ticks, 1 to the interval\n", pPath,
+                    pEntry->nLine);
+            return false;
+        }
+
+        if(pEntry->bWcetCyc && (m_nCycPerTick <= 0.0))
+        {
+            fprintf(stderr, "%s:%d: cycles need -c to convert to ticks\n", pPath, pEntry->nLine);
+            return false;
+        }
+
+        pTask = &m_aTasks[m_nTasks++];
+        memset(pTask, 0, sizeof(*pTask));
+        strcpy(pTask->name, pEntry->name);
+        pTask->nIntvlTcks = pEntry->nIntvlTcks;
+        pTask->prty = pEntry->prty;
+        pTask->nDlTcks = (uint32_t) pEntry->dline;
+        pTask->bWcetCyc = pEntry->bWcetCyc;
+        pTask->wcet = pEntry->bWcetCyc ? (pEntry->wcet / m_nCycPerTick) : pEntry->wcet;
+    }
+
+    if(m_nTasks == 0)
+    {
+        fprintf(stderr, "fcs_cyc: no Low to Critical priority tasks in %s\n", pPath);
+        return false;
+    }
+
+    return true;
+}
+
+//***************************************************************************
+// Function Name:   _CYC_gcd
+// Returns:         Greatest common divisor.
+// Param1:          a - First value.
+// Param2:          b - Second value.
+// Description:     Euclid's algorithm.
+//***************************************************************************
+static uint32_t _CYC_gcd(uint32_t a, uint32_t b)
+{
+    uint32_t t;
+
+    while(b != 0)
+    {
+        t = a % b;
+        a = b;
+        b = t;
+    }
+
+    return a;
+}
+
+//***************************************************************************
+// Function Name:   _CYC_hyperperiod
+// Returns:         Least common multiple of the task intervals in ticks, 0 if it
+//                  exceeds 32 bits.
+// Param1:          void
+// Description:     Computes the major cycle.
+//***************************************************************************
+static uint64_t _CYC_hyperperiod(void)
+{
+    uint64_t nLcm = 1;
+    int i;
+
+    for(i = 0; i < m_nTasks; i++)
+    {
+        nLcm = (nLcm / _CYC_gcd((uint32_t) nLcm, m_aTasks[i].nIntvlTcks)) * m_aTasks[i].nIntvlTcks;
+
+        if(nLcm > UINT32_MAX)
+        {
+            return 0;
+        }
+    }
+
+    return nLcm;
+}
+
+//***************************************************************************
+// Function Name:   _CYC_frameUsable
+// Returns:         True if the frame size meets the cyclic executive constraints.
+// Param1:          nFrmTcks - Frame size in ticks.
+// Param2:          nHyper - Major cycle in ticks.
+// Description:     Checks that the frame divides the major cycle, holds every job and
+// fits between each release and deadline.
+//***************************************************************************
+static bool _CYC_frameUsable(uint32_t nFrmTcks, uint64_t nHyper)
+{
+    int i;
+
+    if((nFrmTcks == 0) || ((nHyper % nFrmTcks) != 0))
+    {
+        return false;
+    }
+
+    for(i = 0; i < m_nTasks; i++)
+    {
+        if((m_aTasks[i].wcet > nFrmTcks)
+                || (((2ULL * nFrmTcks) - _CYC_gcd(nFrmTcks, m_aTasks[i].nIntvlTcks))
+                        > m_aTasks[i].nDlTcks))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//***************************************************************************
+// Function Name:   _CYC_jobOrder
+// Returns:         Sort order of two jobs.
+// Param1:          *pA - First job.
+// Param2:          *pB - Second job.
+// Description:     Orders jobs by frame, then priority level (highest first), then
+// deadline and task file order.
+//***************************************************************************
+static int _CYC_jobOrder(const void *pA, const void *pB)
+{
+    const CYC_Job_t *pJobA = (const CYC_Job_t *) pA;
+    const CYC_Job_t *pJobB = (const CYC_Job_t *) pB;
+
+    if(pJobA->nFrame != pJobB->nFrame)
+    {
+        return (pJobA->nFrame < pJobB->nFrame) ? -1 : 1;
+    }
+
+    if(m_aTasks[pJobA->task].prty != m_aTasks[pJobB->task].prty)
+    {
+        return (m_aTasks[pJobA->task].prty > m_aTasks[pJobB->task].prty) ? -1 : 1;
+    }
+
+    if(pJobA->nDlTck != pJobB->nDlTck)
+    {
+        return (pJobA->nDlTck < pJobB->nDlTck) ? -1 : 1;
+    }
+
+    return (int) pJobA->task - (int) pJobB->task;
+}
+
+//***************************************************************************
+// Function Name:   _CYC_pack
+// Returns:         True if every job was packed.
+// Param1:          nFrmTcks - Frame size in ticks.
+// Param2:          nFrames - Frames in the major cycle.
+// Description:     Packs the jobs of the major cycle into frames, earliest deadline
+// first. Leaves the jobs sorted in frame table order.
+//***************************************************************************
+static bool _CYC_pack(uint32_t nFrmTcks, uint32_t nFrames)
+{
+    uint64_t nFrmStart;
+    uint32_t frame;
+    uint32_t job;
+    uint32_t best;
+
+    for(job = 0; job < m_nJobs; job++)
+    {
+        m_pJobs[job].nFrame = UINT32_MAX;
+    }
+
+    for(frame = 0; frame < nFrames; frame++)
+    {
+        nFrmStart = (uint64_t) frame * nFrmTcks;
+        m_pFrmLoad[frame] = 0.0;
+
+        // Fill the frame with the released job due first until none fits.
+        while(true)
+        {
+            best = UINT32_MAX;
+
+            for(job = 0; job < m_nJobs; job++)
+            {
+                if((m_pJobs[job].nFrame == UINT32_MAX) && (m_pJobs[job].nRlsTck <= nFrmStart)
+                        && (m_pJobs[job].nDlTck >= (nFrmStart + nFrmTcks))
+                        && ((m_pFrmLoad[frame] + m_aTasks[m_pJobs[job].task].wcet) <= nFrmTcks)
+                        && ((best == UINT32_MAX) || (m_pJobs[job].nDlTck < m_pJobs[best].nDlTck)))
+                {
+                    best = job;
+                }
+            }
+
+            if(best == UINT32_MAX)
+            {
+                break;
+            }
+
+            m_pJobs[best].nFrame = frame;
+            m_pFrmLoad[frame] += m_aTasks[m_pJobs[best].task].wcet;
+        }
+    }
+
+    for(job = 0; job < m_nJobs; job++)
+    {
+        if(m_pJobs[job].nFrame == UINT32_MAX)
+        {
+            return false;
+        }
+    }
+
+    qsort(m_pJobs, m_nJobs, sizeof(CYC_Job_t), _CYC_jobOrder);
+
+    return true;
+}
+
+//***************************************************************************
+// Function Name:   _CYC_write
+// Returns:         Success status of the output.
+// Param1:          *pPath - Header to write, NULL for stdout.
+// Param2:          *pTaskFile - Task file the table was generated from.
+// Param3:          nFrmTcks - Frame size in ticks.
+// Param4:          nFrames - Frames in the major cycle.
+// Description:     Writes the frame table header.
+//***************************************************************************
+static bool _CYC_write(const char *pPath, const char *pTaskFile, uint32_t nFrmTcks,
+        uint32_t nFrames)
+{
+    FILE *pFile = (pPath != NULL) ? fopen(pPath, "w") : stdout;
+    uint32_t frame;
+    uint32_t job = 0;
+
+    if(pFile == NULL)
+    {
+        fprintf(stderr, "fcs_cyc: cannot create %s\n", pPath);
+        return false;
+    }
+
+    fprintf(pFile, "//***********************************************************************************\n");
+    fprintf(pFile, "// Module Name:         task_schdlr_frames.h\n");
+    fprintf(pFile, "// Description:\n");
+    fprintf(pFile, "// Cyclic executive frame table for FCS_TASK_SCHDLR_CYCLIC_ENABLE. Generated by\n");
+    fprintf(pFile, "// Tools/fcs_cyc from %s, do not edit.\n", pTaskFile);
+    fprintf(pFile, "//***********************************************************************************\n\n");
+    fprintf(pFile, "#ifndef TASK_SCHDLR_FRAMES_H_\n#define TASK_SCHDLR_FRAMES_H_\n\n");
+    fprintf(pFile, "#define FCS_TASK_SCHDLR_FRAME_TCKS      %lu   // Minor frame in ticks\n",
+            (unsigned long) nFrmTcks);
+    fprintf(pFile, "#define FCS_TASK_SCHDLR_FRAMES          %lu   // Frames per major cycle of %llu ticks\n\n",
+            (unsigned long) nFrames, (unsigned long long) nFrmTcks * nFrames);
+
+    // One line of task IDs per frame.
+    fprintf(pFile, "// Tasks run by each frame, in order\n");
+    fprintf(pFile, "#define FCS_TASK_SCHDLR_FRAME_TASKS \\\n");
+
+    for(frame = 0; frame < nFrames; frame++)
+    {
+        fprintf(pFile, "    /* %lu */", (unsigned long) frame);
+
+        for(; (job < m_nJobs) && (m_pJobs[job].nFrame == frame); job++)
+        {
+            fprintf(pFile, " FCS_TASKID_%s,", m_aTasks[m_pJobs[job].task].name);
+        }
+
+        fprintf(pFile, "%s\n", ((frame + 1) < nFrames) ? " \\" : "");
+    }
+
+    // Start of each frame's tasks, then the end of the last frame.
+    fprintf(pFile, "\n// First entry of each frame in FCS_TASK_SCHDLR_FRAME_TASKS, then the entry count\n");
+    fprintf(pFile, "#define FCS_TASK_SCHDLR_FRAME_START \\\n   ");
+    job = 0;
+
+    for(frame = 0; frame <= nFrames; frame++)
+    {
+        for(; (job < m_nJobs) && (m_pJobs[job].nFrame < frame); job++)
+        {
+            (void) 0;
+        }
+
+        fprintf(pFile, " %lu%s", (unsigned long) job, (frame < nFrames) ? "," : "\n");
+
+        if(((frame % 16) == 15) && (frame < nFrames))
+        {
+            fprintf(pFile, " \\\n   ");
+        }
+    }
+
+    fprintf(pFile, "\n#endif /* TASK_SCHDLR_FRAMES_H_ */\n");
+
+    if(pPath != NULL)
+    {
+        fclose(pFile);
+    }
+
+    return true;
+}
+
+//**************
+// Global Functions
+//**************
+
+//***************************************************************************
+// Function Name:   main
+// Returns:         0 if the table was generated, 1 if the task set cannot be packed,
+//                  2 on invalid input.
+// Param1:          argc - Number of arguments.
+// Param2:          **argv - Arguments.
+// Description:     Generates the frame table and prints the frame utilization.
+//***************************************************************************
+int main(int argc, char **argv)
+{
+    const char *pTasks = NULL;
+    const char *pOut = NULL;
+    uint32_t nForceFrm = 0;
+    uint32_t nFrmTcks;
+    uint32_t nMaxFrm;
+    uint32_t nFrames = 0;
+    uint32_t nRls;
+    uint32_t frame;
+    uint64_t nHyper;
+    double maxLoad = 0.0;
+    double util = 0.0;
+    bool bPacked = false;
+    int i;
+
+    for(i = 1; i < argc; i++)
+    {
+        if((strcmp(argv[i], "-c") == 0) && ((i + 1) < argc))
+        {
+            m_nCycPerTick = strtod(argv[++i], NULL);
+        }
+        else if((strcmp(argv[i], "-f") == 0) && ((i + 1) < argc))
+        {
+            nForceFrm = (uint32_t) strtoul(argv[++i], NULL, 10);
+        }
+        else if((strcmp(argv[i], "-o") == 0) && ((i + 1) < argc))
+        {
+            pOut = argv[++i];
+        }
+        else if((argv[i][0] != '-') && (pTasks == NULL))
+        {
+            pTasks = argv[i];
+        }
+        else
+        {
+            _CYC_usage();
+            return 2;
+        }
+    }
+
+    if(pTasks == NULL)
+    {
+        _CYC_usage();
+        return 2;
+    }
+
+    if(!_CYC_readTasks(pTasks))
+    {
+        return 2;
+    }
+
+    nHyper = _CYC_hyperperiod();
+
+    if(nHyper == 0)
+    {
+        fprintf(stderr, "fcs_cyc: hyperperiod exceeds 32 bits\n");
+        return 1;
+    }
+
+    // List the jobs of the major cycle.
+    for(i = 0; i < m_nTasks; i++)
+    {
+        m_nJobs += (uint32_t) (nHyper / m_aTasks[i].nIntvlTcks);
+        util += m_aTasks[i].wcet / m_aTasks[i].nIntvlTcks;
+    }
+
+    if(m_nJobs > CYC_MAX_ENTRIES)
+    {
+        fprintf(stderr, "fcs_cyc: %lu jobs per major cycle exceed the frame table\n",
+                (unsigned long) m_nJobs);
+        return 1;
+    }
+
+    m_pJobs = (CYC_Job_t *) malloc(m_nJobs * sizeof(CYC_Job_t));
+    m_nJobs = 0;
+
+    for(i = 0; i < m_nTasks; i++)
+    {
+        for(nRls = 0; nRls < nHyper; nRls += m_aTasks[i].nIntvlTcks)
+        {
+            m_pJobs[m_nJobs].task = (uint8_t) i;
+            m_pJobs[m_nJobs].nRlsTck = nRls;
+            m_pJobs[m_nJobs].nDlTck = nRls + m_aTasks[i].nDlTcks;
+            m_nJobs++;
+        }
+    }
+
+    // Frames are no longer than the shortest deadline.
+    nMaxFrm = UINT32_MAX;
+
+    for(i = 0; i < m_nTasks; i++)
+    {
+        if(m_aTasks[i].nDlTcks < nMaxFrm)
+        {
+            nMaxFrm = m_aTasks[i].nDlTcks;
+        }
+    }
+
+    // Try the usable frame sizes, largest first.
+    for(nFrmTcks = (nForceFrm > 0) ? nForceFrm : nMaxFrm; (nFrmTcks > 0) && !bPacked; nFrmTcks--)
+    {
+        if(_CYC_frameUsable(nFrmTcks, nHyper) && ((nHyper / nFrmTcks) <= CYC_MAX_ENTRIES))
+        {
+            nFrames = (uint32_t) (nHyper / nFrmTcks);
+            m_pFrmLoad = (double *) realloc(m_pFrmLoad, nFrames * sizeof(double));
+            bPacked = _CYC_pack(nFrmTcks, nFrames);
+        }
+
+        if(bPacked || (nForceFrm > 0))
+        {
+            break;
+        }
+    }
+
+    printf("Tasks:        %d\n", m_nTasks);
+    printf("Utilization:  %.3f\n", util);
+    printf("Major cycle:  %llu ticks\n", (unsigned long long) nHyper);
+
+    if(!bPacked)
+    {
+        printf("Frame:        none usable\n");
+        fprintf(stderr, "fcs_cyc: task set cannot be packed into frames\n");
+        free(m_pJobs);
+        free(m_pFrmLoad);
+        return 1;
+    }
+
+    for(frame = 0; frame < nFrames; frame++)
+    {
+        if(m_pFrmLoad[frame] > maxLoad)
+        {
+            maxLoad = m_pFrmLoad[frame];
+        }
+    }
+
+    printf("Frame:        %lu ticks, %lu frames, %lu entries\n", (unsigned long) nFrmTcks,
+            (unsigned long) nFrames, (unsigned long) m_nJobs);
+    printf("Frame load:   %.3f mean, %.3f peak\n", util, maxLoad / nFrmTcks);
+
+    if(pOut == NULL)
+    {
+        printf("\n");
+    }
+
+    bPacked = _CYC_write(pOut, pTasks, nFrmTcks, nFrames);
+
+    free(m_pJobs);
+    free(m_pFrmLoad);
+
+    return bPacked ? 0 : 2;
+}
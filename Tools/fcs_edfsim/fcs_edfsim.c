@@ -0,0 +1,443 @@
+//***********************************************************************************
+// Module Name:         fcs_edfsim.c
+// Application:         Host tool
+// Platform:            Any host with a C99 compiler
+// Author(s):           Derrick Simeon
+// Notes:
+// Description:
+// Utilization simulation for the FCS task scheduler. Runs the real dispatcher over
+// random periodic task sets of rising utilization and counts the deadline misses, so
+// earliest deadline first dispatch can be compared with the fixed priority levels.
+//
+// The scheduler is linked in, so each dispatch engine is its own build:
+//     S=../../Sources/Franklin_Library/TASK_SCHEDULER
+//     gcc -std=c99 -O2 -I$S -o fcs_edfsim_fp fcs_edfsim.c $S/task_schdlr.c -lm
+//     gcc -std=c99 -O2 -I$S -DFCS_TASK_SCHDLR_EDF_ENABLE -o fcs_edfsim_edf fcs_edfsim.c $S/task_schdlr.c -lm
+// Usage:   fcs_edfsim [-n tasks] [-s sets] [-t ticks] [-c maxWcet] [-r seed] [-b baselineFile]
+//
+// Compare the engines by saving one's output as the baseline of the other:
+//     fcs_edfsim_fp > fp.txt
+//     fcs_edfsim_edf -b fp.txt
+// Both builds draw the same task sets for the same seed.
+//
+// Task sets:
+// For each utilization from 50% to 100% in 5% steps, the given number of sets is drawn
+// with the UUniFast method. Each task gets a random interval from 10 to 200 ticks and
+// a WCET in whole ticks of at most maxWcet (default 4). The deadline is the interval.
+// Priority levels are assigned deadline monotonic, the shortest intervals Critical,
+// and the tasks are added shortest interval first. A task runs for its WCET by adding
+// that many clock ticks, and an idle task adds a tick when nothing is due. Every task
+// uses FCS_TASKRELEASE_AbsCatchUp, so run n is for release n and finishes late if the
+// clock has passed its release plus the interval by then.
+//
+// Each line gives the utilization aimed for, the mean utilization of the sets drawn,
+// the sets with at least one late run and the share of all runs that were late.
+//
+// Both engines are cooperative, so a task waits for the running one to finish whatever
+// its deadline. The WCET limit keeps that blocking short against the intervals.
+//
+// Exit status: 0 on success, 2 on invalid input.
+// Copyright (c) 2016, Franklin Control Systems, all rights reserved
+//***********************************************************************************
+
+//**************
+// Includes
+//**************
+
+// Standard C libraries
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+#include <setjmp.h>
+
+// Project-specific modules
+#include "task_schdlr.h"
+
+//**************
+// Defines
+//**************
+
+#define SIM_MAX_TASKS       32          // Largest task set
+#define SIM_MIN_INTVL       10          // Shortest task interval in ticks
+#define SIM_MAX_INTVL       200         // Longest task interval in ticks
+#define SIM_UTIL_STEPS      11          // Utilizations simulated, 50% to 100%
+#define SIM_LINE_LEN        256         // Longest baseline line
+
+#if defined(FCS_TASK_SCHDLR_EDF_ENABLE)
+#define SIM_ENGINE          "edf"
+#else
+#define SIM_ENGINE          "fixed priority"
+#endif
+
+//**************
+// Local Typedefs
+//**************
+
+typedef struct
+{
+    uint32_t            nIntvl;         // Interval and relative deadline in ticks
+    uint32_t            nWcet;          // Run time in ticks
+    uint32_t            nRlsTck;        // Release of the next run
+    uint32_t            nRuns;          // Runs so far
+    uint32_t            nMisses;        // Runs finished after their deadline
+} SIM_Task_t;
+
+//**************
+// Local Variables
+//**************
+
+static FCS_Task_t m_aTaskLst[SIM_MAX_TASKS + 1];
+static SIM_Task_t m_aSimTasks[SIM_MAX_TASKS];
+static jmp_buf m_stopJmp;                       // Leaves the dispatcher
+static uint32_t m_nEndTck;                      // Tick the current set stops at
+static uint32_t m_nRand;                        // Random number state
+
+//**************
+// Local Functions
+//**************
+
+static double _SIM_rand(void);
+static uint32_t _SIM_draw(uint32_t nTasks, double util, uint32_t nMaxWcet);
+static void _SIM_task(void *pArg);
+static void _SIM_idle(void);
+static void _SIM_run(uint32_t nTasks, uint32_t nTicks);
+static int _SIM_cmpIntvl(const void *pA, const void *pB);
+static uint32_t _SIM_baseline(FILE *pFile, uint32_t nUtil);
+
+//***************************************************************************
+// Function Name:   _SIM_rand
+// Returns:         Random number from 0 up to but not including 1.
+// Param1:          void
+// Description:     Linear congruential generator, the same on every host.
+//***************************************************************************
+static double _SIM_rand(void)
+{
+    m_nRand = (m_nRand * 1103515245UL) + 12345UL;
+
+    return (double) ((m_nRand >> 8) & 0xFFFFFFUL) / 16777216.0;
+}
+
+//***************************************************************************
+// Function Name:   _SIM_draw
+// Returns:         Utilization of the task set drawn, in hundredths of a percent.
+// Param1:          nTasks - Tasks in the set.
+// Param2:          util - Utilization aimed for, 1 for 100%.
+// Param3:          nMaxWcet - Longest WCET in ticks.
+// Description:     Draws a task set into m_aSimTasks with the UUniFast method. The
+// WCETs are rounded to whole ticks, so the utilization is close to the one aimed for.
+//***************************************************************************
+static uint32_t _SIM_draw(uint32_t nTasks, double util, uint32_t nMaxWcet)
+{
+    double sumUtil = util;
+    double nextSum;
+    double taskUtil;
+    double setUtil = 0.0;
+    uint32_t nIntvl;
+    uint32_t idx;
+
+    for(idx = 0; idx < nTasks; idx++)
+    {
+        if(idx == (nTasks - 1))
+        {
+            taskUtil = sumUtil;
+        }
+        else
+        {
+            nextSum = sumUtil * pow(_SIM_rand(), 1.0 / (double) (nTasks - idx - 1));
+            taskUtil = sumUtil - nextSum;
+            sumUtil = nextSum;
+        }
+
+        // Shorten the interval if the WCET would be too long.
+        nIntvl = SIM_MIN_INTVL + (uint32_t) (_SIM_rand() * (SIM_MAX_INTVL - SIM_MIN_INTVL + 1));
+
+        if((taskUtil * nIntvl) > nMaxWcet)
+        {
+            nIntvl = (uint32_t) (nMaxWcet / taskUtil);
+        }
+
+        if(nIntvl < SIM_MIN_INTVL)
+        {
+            nIntvl = SIM_MIN_INTVL;
+        }
+
+        m_aSimTasks[idx].nIntvl = nIntvl;
+        m_aSimTasks[idx].nWcet = (uint32_t) lround(taskUtil * nIntvl);
+
+        if(m_aSimTasks[idx].nWcet == 0)
+        {
+            m_aSimTasks[idx].nWcet = 1;
+        }
+        else if(m_aSimTasks[idx].nWcet > nMaxWcet)
+        {
+            m_aSimTasks[idx].nWcet = nMaxWcet;
+        }
+
+        setUtil += (double) m_aSimTasks[idx].nWcet / m_aSimTasks[idx].nIntvl;
+    }
+
+    qsort(m_aSimTasks, nTasks, sizeof(m_aSimTasks[0]), &_SIM_cmpIntvl);
+
+    return (uint32_t) lround(setUtil * 10000.0);
+}
+
+//***************************************************************************
+// Function Name:   _SIM_cmpIntvl
+// Returns:         Negative, zero or positive as the first interval is shorter, equal
+//                  or longer.
+// Param1:          *pA - First task.
+// Param2:          *pB - Second task.
+// Description:     Orders tasks by interval for qsort.
+//***************************************************************************
+static int _SIM_cmpIntvl(const void *pA, const void *pB)
+{
+    const SIM_Task_t *pTaskA = (const SIM_Task_t *) pA;
+    const SIM_Task_t *pTaskB = (const SIM_Task_t *) pB;
+
+    return (pTaskA->nIntvl > pTaskB->nIntvl) - (pTaskA->nIntvl < pTaskB->nIntvl);
+}
+
+//***************************************************************************
+// Function Name:   _SIM_task
+// Returns:         void
+// Param1:          *pArg - Simulated task.
+// Description:     Priority task. Runs for its WCET and checks its deadline, or
+// leaves the dispatcher once the set has run for its ticks.
+//***************************************************************************
+static void _SIM_task(void *pArg)
+{
+    SIM_Task_t *pTask = (SIM_Task_t *) pArg;
+
+    FCS_TASK_SCHDLR_clockTicks(pTask->nWcet);
+
+    if((FCS_TASK_SCHDLR_now() - pTask->nRlsTck) > pTask->nIntvl)
+    {
+        pTask->nMisses++;
+    }
+
+    pTask->nRlsTck += pTask->nIntvl;
+    pTask->nRuns++;
+
+    if((int32_t) (FCS_TASK_SCHDLR_now() - m_nEndTck) >= 0)
+    {
+        // An overloaded set never leaves the dispatcher idle.
+        longjmp(m_stopJmp, 1);
+    }
+}
+
+//***************************************************************************
+// Function Name:   _SIM_idle
+// Returns:         void
+// Param1:          void
+// Description:     Idle task. Adds a clock tick, or leaves the dispatcher once the
+// set has run for its ticks.
+//***************************************************************************
+static void _SIM_idle(void)
+{
+    if((int32_t) (FCS_TASK_SCHDLR_now() - m_nEndTck) >= 0)
+    {
+        longjmp(m_stopJmp, 1);
+    }
+
+    FCS_TASK_SCHDLR_clockTick();
+}
+
+//***************************************************************************
+// Function Name:   _SIM_run
+// Returns:         void
+// Param1:          nTasks - Tasks in the set.
+// Param2:          nTicks - Ticks to run the set for.
+// Description:     Runs the dispatcher over the task set in m_aSimTasks.
+//***************************************************************************
+static void _SIM_run(uint32_t nTasks, uint32_t nTicks)
+{
+    FCS_TaskCode_t taskCode;
+    FCS_TaskHandle_t hTask;
+    uint32_t nStartTck;
+    uint32_t idx;
+
+    FCS_TASK_SCHDLR_init(m_aTaskLst, (uint8_t) (nTasks + 1));
+    nStartTck = FCS_TASK_SCHDLR_now();
+    m_nEndTck = nStartTck + nTicks;
+
+    for(idx = 0; idx < nTasks; idx++)
+    {
+        m_aSimTasks[idx].nRlsTck = nStartTck + m_aSimTasks[idx].nIntvl;
+        m_aSimTasks[idx].nRuns = 0;
+        m_aSimTasks[idx].nMisses = 0;
+
+        taskCode.pfnHasArg = &_SIM_task;
+        hTask = FCS_TASK_SCHDLR_addTask(taskCode, &m_aSimTasks[idx], m_aSimTasks[idx].nIntvl,
+                (FCS_TaskPriority_e) (FCS_TASKPRIORITY_Critical - ((idx * 4) / nTasks)));
+        (void) FCS_TASK_SCHDLR_setReleaseHndl(hTask, FCS_TASKRELEASE_AbsCatchUp);
+    }
+
+    taskCode.pfnNoArg = &_SIM_idle;
+    (void) FCS_TASK_SCHDLR_addTask(taskCode, NULL, 0, FCS_TASKPRIORITY_Idle);
+
+    if(setjmp(m_stopJmp) == 0)
+    {
+        FCS_TASK_SCHDLR_dispatcher();
+    }
+}
+
+//***************************************************************************
+// Function Name:   _SIM_baseline
+// Returns:         Sets with misses in the baseline, or UINT32_MAX if it has no figure.
+// Param1:          *pFile - Output of another build of this simulation.
+// Param2:          nUtil - Utilization aimed for, in percent.
+// Description:     Looks up the baseline figure for a utilization.
+//***************************************************************************
+static uint32_t _SIM_baseline(FILE *pFile, uint32_t nUtil)
+{
+    char line[SIM_LINE_LEN];
+    unsigned long nLineUtil;
+    unsigned long nMissSets;
+    double actUtil;
+
+    rewind(pFile);
+
+    while(fgets(line, sizeof(line), pFile) != NULL)
+    {
+        if((line[0] != '#') && (sscanf(line, "%lu %lf %lu", &nLineUtil, &actUtil, &nMissSets) == 3)
+                && (nLineUtil == nUtil))
+        {
+            return (uint32_t) nMissSets;
+        }
+    }
+
+    return UINT32_MAX;
+}
+
+//***************************************************************************
+// Function Name:   main
+// Returns:         0 on success, 2 on invalid input.
+// Param1:          argc - Number of arguments.
+// Param2:          **argv - Arguments.
+// Description:     Simulates the task sets of each utilization and prints the sets
+// that missed deadlines and the share of late runs.
+//***************************************************************************
+int main(int argc, char **argv)
+{
+    FILE *pBase = NULL;
+    uint32_t nTasks = 8;
+    uint32_t nSets = 100;
+    uint32_t nTicks = 10000;
+    uint32_t nMaxWcet = 4;
+    uint32_t nUtil;
+    uint32_t nSet;
+    uint32_t nMissSets;
+    uint32_t nBaseSets;
+    uint32_t idx;
+    uint64_t nUtilSum;
+    uint64_t nRuns;
+    uint64_t nMisses;
+    bool bMissed;
+    int arg;
+
+    m_nRand = 1;
+
+    for(arg = 1; arg < argc; arg++)
+    {
+        if((argv[arg][0] == '-') && (argv[arg][1] != '\0') && (argv[arg][2] == '\0') && ((arg + 1) < argc))
+        {
+            switch(argv[arg][1])
+            {
+                case 'n':
+                    nTasks = (uint32_t) strtoul(argv[++arg], NULL, 10);
+                    continue;
+                case 's':
+                    nSets = (uint32_t) strtoul(argv[++arg], NULL, 10);
+                    continue;
+                case 't':
+                    nTicks = (uint32_t) strtoul(argv[++arg], NULL, 10);
+                    continue;
+                case 'c':
+                    nMaxWcet = (uint32_t) strtoul(argv[++arg], NULL, 10);
+                    continue;
+                case 'r':
+                    m_nRand = (uint32_t) strtoul(argv[++arg], NULL, 10);
+                    continue;
+                case 'b':
+                    pBase = fopen(argv[++arg], "r");
+
+                    if(pBase == NULL)
+                    {
+                        fprintf(stderr, "fcs_edfsim: cannot open %s\n", argv[arg]);
+                        return 2;
+                    }
+                    continue;
+                default:
+                    break;
+            }
+        }
+
+        fprintf(stderr, "usage: fcs_edfsim [-n tasks] [-s sets] [-t ticks] [-c maxWcet] [-r seed]"
+                " [-b baselineFile]\n");
+        return 2;
+    }
+
+    if((nTasks < 2) || (nTasks > SIM_MAX_TASKS) || (nSets == 0)
+            || (nTicks < SIM_MAX_INTVL) || (nTicks > 0x7FFFFFFFUL) || (nMaxWcet == 0))
+    {
+        fprintf(stderr, "fcs_edfsim: 2 to %d tasks, at least 1 set, %d to 2^31 - 1 ticks"
+                " and a WCET of at least 1 tick\n", SIM_MAX_TASKS, SIM_MAX_INTVL);
+        return 2;
+    }
+
+    printf("# fcs_edfsim %s, %lu tasks, %lu sets per utilization, %lu ticks, WCET up to %lu ticks\n",
+            SIM_ENGINE, (unsigned long) nTasks, (unsigned long) nSets, (unsigned long) nTicks,
+            (unsigned long) nMaxWcet);
+    printf("# util  actual  missed   late%%%s\n", (pBase != NULL) ? "  baseline" : "");
+
+    for(nUtil = 50; nUtil < (50 + (SIM_UTIL_STEPS * 5)); nUtil += 5)
+    {
+        nUtilSum = 0;
+        nMissSets = 0;
+        nRuns = 0;
+        nMisses = 0;
+
+        for(nSet = 0; nSet < nSets; nSet++)
+        {
+            nUtilSum += _SIM_draw(nTasks, nUtil / 100.0, nMaxWcet);
+            _SIM_run(nTasks, nTicks);
+            bMissed = false;
+
+            for(idx = 0; idx < nTasks; idx++)
+            {
+                nRuns += m_aSimTasks[idx].nRuns;
+                nMisses += m_aSimTasks[idx].nMisses;
+                bMissed = bMissed || (m_aSimTasks[idx].nMisses != 0);
+            }
+
+            if(bMissed)
+            {
+                nMissSets++;
+            }
+        }
+
+        printf("%6lu %7.1f %7lu %7.2f", (unsigned long) nUtil,
+                (double) nUtilSum / (nSets * 100.0), (unsigned long) nMissSets,
+                (nRuns != 0) ? ((100.0 * nMisses) / nRuns) : 0.0);
+
+        if(pBase != NULL)
+        {
+            nBaseSets = _SIM_baseline(pBase, nUtil);
+
+            if(nBaseSets != UINT32_MAX)
+            {
+                printf(" %9lu", (unsigned long) nBaseSets);
+            }
+        }
+
+        printf("\n");
+    }
+
+    if(pBase != NULL)
+    {
+        fclose(pBase);
+    }
+
+    return 0;
+}
@@ -0,0 +1,336 @@
+//***********************************************************************************
+// Module Name:         fcs_poolbench.c
+// Application:         Host tool
+// Platform:            Any ELF host with a C99 compiler and clock_gettime
+// Author(s):           Derrick Simeon
+// Notes:
+// Description:
+// Allocation benchmark of the FCS memory pools against the C library's malloc and
+// free. Both run the same random sequence of allocations and frees, sized like the
+// application's block classes, and the benchmark reports the mean time per operation
+// and the slow tail that a deterministic allocator is meant to remove.
+//
+// Build:   S=../../Sources
+//          gcc -std=c99 -O2 -I$S -I$S/Franklin_Library/MEM_POOL -o fcs_poolbench
+//              fcs_poolbench.c $S/Franklin_Library/MEM_POOL/mem_pool.c
+// Usage:   fcs_poolbench [-n operations] [-l liveBlocks] [-r seed]
+//
+// The pool classes come from Sources/mem_pool_classes.h, so the benchmark measures
+// the pools the firmware is built with. The host linker places the .mem_pool section
+// like any other data section.
+//
+// Workload:
+// Up to liveBlocks blocks (default 16) are held at once. Each operation allocates if
+// none is held, frees a random held block if all are, and otherwise does either at
+// random. Request sizes are 1 to 32 bytes 70% of the time, 33 to 128 bytes 25% and
+// 129 to 512 bytes 5%. Each allocated block is written once. Allocations the pools
+// cannot satisfy are counted and skipped, after which the two sequences differ a
+// little. Keep liveBlocks low enough that the failures stay rare.
+//
+// Each allocator runs the sequence twice: once timed as a whole for the mean, and once
+// timing every operation for the 99.9th and 99.99th percentiles and the maximum. The
+// per-operation figures include the clock read, so compare them between allocators
+// rather than taking them as absolute. The maximum is usually the host preempting the
+// benchmark.
+//
+// Exit status: 0 on success, 2 on invalid input.
+// Copyright (c) 2016, Franklin Control Systems, all rights reserved
+//***********************************************************************************
+
+//**************
+// Includes
+//**************
+
+// Standard C libraries
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+
+// Project-specific modules
+#include "mem_pool.h"
+
+//**************
+// Defines
+//**************
+
+#define BENCH_MAX_LIVE      256         // Most blocks held at once
+#define BENCH_HIST_NS       10          // Width of a histogram bucket in ns
+#define BENCH_HIST_LEN      10000       // Histogram buckets, the last one open ended
+
+//**************
+// Local Typedefs
+//**************
+
+// Allocator under test
+typedef struct
+{
+    const char          *pName;         // Printed name
+    void                *(*pfnAlloc)(uint32_t nBytes);
+    void                (*pfnFree)(void *pBlock);
+} BENCH_Alloc_t;
+
+//**************
+// Local Variables
+//**************
+
+static void *m_apLive[BENCH_MAX_LIVE];                  // Blocks held
+static uint32_t m_aHist[BENCH_HIST_LEN];                // Operation times
+static uint32_t m_nRand;                                // Random number state
+static uint32_t m_nFailures;                            // Allocations that returned NULL
+static uint64_t m_nMaxNs;                               // Slowest operation
+
+//**************
+// Local Functions
+//**************
+
+static uint32_t _BENCH_rand(void);
+static void *_BENCH_malloc(uint32_t nBytes);
+static uint64_t _BENCH_nsNow(void);
+static double _BENCH_run(const BENCH_Alloc_t *pAlloc, uint32_t nOps, uint32_t nLive,
+        uint32_t nSeed, bool bPerOp);
+
+//***************************************************************************
+// Function Name:   _BENCH_rand
+// Returns:         Random number from 0 to 65535.
+// Param1:          void
+// Description:     Linear congruential generator, so both allocators see the same
+// sequence for a seed.
+//***************************************************************************
+static uint32_t _BENCH_rand(void)
+{
+    m_nRand = (m_nRand * 1103515245UL) + 12345UL;
+
+    return (m_nRand >> 16) & 0xFFFFUL;
+}
+
+//***************************************************************************
+// Function Name:   _BENCH_malloc
+// Returns:         Pointer to the block or NULL.
+// Param1:          nBytes - Bytes needed.
+// Description:     malloc with the pool allocator's signature.
+//***************************************************************************
+static void *_BENCH_malloc(uint32_t nBytes)
+{
+    return malloc(nBytes);
+}
+
+//***************************************************************************
+// Function Name:   _BENCH_nsNow
+// Returns:         Monotonic time in nanoseconds.
+// Param1:          void
+// Description:     Reads the host clock.
+//***************************************************************************
+static uint64_t _BENCH_nsNow(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t) now.tv_sec * 1000000000ULL) + (uint64_t) now.tv_nsec;
+}
+
+//***************************************************************************
+// Function Name:   _BENCH_run
+// Returns:         Nanoseconds per operation.
+// Param1:          *pAlloc - Allocator under test.
+// Param2:          nOps - Operations to run.
+// Param3:          nLive - Most blocks held at once.
+// Param4:          nSeed - Seed of the operation sequence.
+// Param5:          bPerOp - Time each operation into m_aHist.
+// Description:     Runs the operation sequence and frees the blocks still held.
+//***************************************************************************
+static double _BENCH_run(const BENCH_Alloc_t *pAlloc, uint32_t nOps, uint32_t nLive,
+        uint32_t nSeed, bool bPerOp)
+{
+    uint64_t nStartNs;
+    uint64_t nOpNs = 0;
+    uint32_t nHeld = 0;
+    uint32_t nBytes;
+    uint32_t nRand;
+    uint32_t nOp;
+    uint32_t idx;
+    void *pBlock;
+
+    m_nRand = nSeed;
+    m_nFailures = 0;
+    m_nMaxNs = 0;
+    nStartNs = _BENCH_nsNow();
+
+    for(nOp = 0; nOp < nOps; nOp++)
+    {
+        nRand = _BENCH_rand();
+
+        if((nHeld < nLive) && ((nHeld == 0) || ((nRand & 1) != 0)))
+        {
+            nRand = _BENCH_rand();
+
+            if((nRand % 100) < 70)
+            {
+                nBytes = 1 + (nRand % 32);
+            }
+            else if((nRand % 100) < 95)
+            {
+                nBytes = 33 + (_BENCH_rand() % 96);
+            }
+            else
+            {
+                nBytes = 129 + (_BENCH_rand() % 384);
+            }
+
+            if(bPerOp)
+            {
+                nOpNs = _BENCH_nsNow();
+            }
+
+            pBlock = pAlloc->pfnAlloc(nBytes);
+
+            if(pBlock != NULL)
+            {
+                *(volatile uint8_t *) pBlock = (uint8_t) nOp;
+                m_apLive[nHeld++] = pBlock;
+            }
+            else
+            {
+                m_nFailures++;
+            }
+        }
+        else
+        {
+            idx = _BENCH_rand() % nHeld;
+
+            if(bPerOp)
+            {
+                nOpNs = _BENCH_nsNow();
+            }
+
+            pAlloc->pfnFree(m_apLive[idx]);
+            m_apLive[idx] = m_apLive[--nHeld];
+        }
+
+        if(bPerOp)
+        {
+            nOpNs = _BENCH_nsNow() - nOpNs;
+
+            if(nOpNs > m_nMaxNs)
+            {
+                m_nMaxNs = nOpNs;
+            }
+
+            nOpNs /= BENCH_HIST_NS;
+            m_aHist[(nOpNs < BENCH_HIST_LEN) ? nOpNs : (BENCH_HIST_LEN - 1)]++;
+        }
+    }
+
+    nStartNs = _BENCH_nsNow() - nStartNs;
+
+    while(nHeld > 0)
+    {
+        pAlloc->pfnFree(m_apLive[--nHeld]);
+    }
+
+    return (double) nStartNs / nOps;
+}
+
+//***************************************************************************
+// Function Name:   main
+// Returns:         0 on success, 2 on invalid input.
+// Param1:          argc - Number of arguments.
+// Param2:          **argv - Arguments.
+// Description:     Runs the operation sequence on each allocator and prints its
+// times.
+//***************************************************************************
+int main(int argc, char **argv)
+{
+    static const BENCH_Alloc_t aAllocs[] = {
+        { "pool", &FCS_MEM_POOL_alloc, &FCS_MEM_POOL_free },
+        { "malloc", &_BENCH_malloc, &free }
+    };
+    uint32_t nOps = 10000000;
+    uint32_t nLive = 16;
+    uint32_t nSeed = 1;
+    uint32_t nAlloc;
+    uint32_t nCount;
+    uint32_t nP999;
+    uint32_t nP9999;
+    uint32_t idx;
+    double nsPerOp;
+    int arg;
+
+    for(arg = 1; arg < argc; arg++)
+    {
+        if((argv[arg][0] == '-') && (argv[arg][1] != '\0') && (argv[arg][2] == '\0') && ((arg + 1) < argc))
+        {
+            switch(argv[arg][1])
+            {
+                case 'n':
+                    nOps = (uint32_t) strtoul(argv[++arg], NULL, 10);
+                    continue;
+                case 'l':
+                    nLive = (uint32_t) strtoul(argv[++arg], NULL, 10);
+                    continue;
+                case 'r':
+                    nSeed = (uint32_t) strtoul(argv[++arg], NULL, 10);
+                    continue;
+                default:
+                    break;
+            }
+        }
+
+        fprintf(stderr, "usage: fcs_poolbench [-n operations] [-l liveBlocks] [-r seed]\n");
+        return 2;
+    }
+
+    if((nOps == 0) || (nLive == 0) || (nLive > BENCH_MAX_LIVE))
+    {
+        fprintf(stderr, "fcs_poolbench: at least 1 operation and 1 to %d live blocks\n",
+                BENCH_MAX_LIVE);
+        return 2;
+    }
+
+    FCS_MEM_POOL_init();
+
+    printf("# fcs_poolbench, %lu operations, up to %lu live blocks\n", (unsigned long) nOps,
+            (unsigned long) nLive);
+    printf("# alloc     ns/op  p99.9 ns p99.99 ns    max ns  failures\n");
+
+    for(nAlloc = 0; nAlloc < (sizeof(aAllocs) / sizeof(aAllocs[0])); nAlloc++)
+    {
+        nsPerOp = _BENCH_run(&aAllocs[nAlloc], nOps, nLive, nSeed, false);
+
+        for(idx = 0; idx < BENCH_HIST_LEN; idx++)
+        {
+            m_aHist[idx] = 0;
+        }
+
+        (void) _BENCH_run(&aAllocs[nAlloc], nOps, nLive, nSeed, true);
+
+        // Walk the histogram for the percentiles.
+        nCount = 0;
+        nP999 = 0;
+        nP9999 = 0;
+
+        for(idx = 0; idx < BENCH_HIST_LEN; idx++)
+        {
+            if((nCount < (nOps - (nOps / 1000))) && ((nCount + m_aHist[idx]) >= (nOps - (nOps / 1000))))
+            {
+                nP999 = idx;
+            }
+
+            if((nCount < (nOps - (nOps / 10000))) && ((nCount + m_aHist[idx]) >= (nOps - (nOps / 10000))))
+            {
+                nP9999 = idx;
+            }
+
+            nCount += m_aHist[idx];
+        }
+
+        printf("%-7s %9.1f %9lu %9lu %9lu %9lu\n", aAllocs[nAlloc].pName, nsPerOp,
+                (unsigned long) (nP999 * BENCH_HIST_NS), (unsigned long) (nP9999 * BENCH_HIST_NS),
+                (unsigned long) m_nMaxNs, (unsigned long) m_nFailures);
+    }
+
+    return 0;
+}
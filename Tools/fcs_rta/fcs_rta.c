@@ -0,0 +1,574 @@
+//***********************************************************************************
+// Module Name:         fcs_rta.c
+// Application:         Host tool
+// Platform:            Any host with a C99 compiler
+// Author(s):           Derrick Simeon
+// Notes:
+// Description:
+// Offline schedulability analyzer for FCS task scheduler task sets. Runs a response-time
+// analysis of the cooperative, non-preemptive dispatch implemented by
+// FCS_TASK_SCHDLR_dispatcher (linear, SoA and timing wheel builds) and reports the
+// worst-case response of each task, the total utilization and the hyperperiod.
+//
+// Build:   gcc -std=c99 -O2 -I../fcs_taskfile -o fcs_rta fcs_rta.c
+//              ../fcs_taskfile/fcs_taskfile.c -lm
+// Usage:   fcs_rta [-c cyclesPerTick] [-t traceFile] taskFile
+//
+// The task file lists one task per line, in the order the tasks are added, in the
+// format read by Tools/fcs_taskfile:
+//     name  interval  priority  wcet  [deadline]
+// - interval and deadline are in ticks. The deadline defaults to the interval.
+// - priority is Idle, Low, Normal, High, Critical or Immediate.
+// - wcet is in ticks, in core cycles with a "c" suffix (e.g. 5400c), or "-" to take
+//   the largest cycle count of the task from the trace file.
+// Text after a '#' is ignored.
+//
+// The trace file holds "name cycles" lines, e.g. the nMaxCyc of each task's profile
+// (FCS_TASK_SCHDLR_getProfileHndl) or one line per measured run. Cycle counts are
+// converted with the -c cycles per tick.
+//
+// Dispatch model:
+// Ticks queue the released tasks by priority level. The dispatcher runs the first task
+// of the highest level that has one, then checks for ticks again, so a task released
+// while another runs competes for the next turn. While no task is queued it runs one
+// idle task at a time. A task i is therefore delayed by:
+// - Blocking: the one task already running when it is released, at worst the longest
+//   lower priority or idle task.
+// - Interference: the higher and equal priority tasks released before it starts.
+// - Preemption: Immediate tasks, which run from the PendSV interrupt.
+// The analysis checks every job of task i in its level-i busy period, as required for
+// non-preemptive scheduling. Tick interrupt overhead and catch-up releases running
+// several times in one pass are not modelled.
+//
+// Exit status: 0 if every task meets its deadline, 1 if a task may miss it, 2 on
+// invalid input, so a host build step can stop on an unschedulable task set. The
+// firmware project does not run it: Tools/ is excluded from its build and needs a host
+// compiler.
+// Copyright (c) 2016, Franklin Control Systems, all rights reserved
+//***********************************************************************************
+
+//**************
+// Includes
+//**************
+
+// Standard C libraries
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+
+// Project-specific modules
+#include "fcs_taskfile.h"
+
+//**************
+// Defines
+//**************
+
+#define RTA_MAX_TASKS       FCS_TASKFILE_MAX_TASKS
+#define RTA_NAME_LEN        FCS_TASKFILE_NAME_LEN
+#define RTA_LINE_LEN        256         // Longest trace line
+#define RTA_HORIZON         1.0e9       // Busy periods longer than this are unbounded
+
+// Priority levels, as in FCS_TaskPriority_e
+#define RTA_PRTY_IDLE       FCS_TASKFILE_PRTY_IDLE
+#define RTA_PRTY_LOW        FCS_TASKFILE_PRTY_LOW
+#define RTA_PRTY_CRITICAL   FCS_TASKFILE_PRTY_CRITICAL
+#define RTA_PRTY_IMMEDIATE  FCS_TASKFILE_PRTY_IMMEDIATE
+
+//**************
+// Local Typedefs
+//**************
+
+// Task under analysis
+typedef struct _RTA_Task_t {
+    char        name[RTA_NAME_LEN];     // Task name
+    uint32_t    nIntvlTcks;             // Interval in ticks, at least 1
+    int         prty;                   // Priority level
+    double      wcet;                   // Worst-case execution time in ticks
+    bool        bWcetTrace;             // WCET comes from the trace file
+    bool        bWcetCyc;               // WCET was given in cycles
+    double      dline;                  // Relative deadline in ticks
+    double      resp;                   // Worst-case response time in ticks
+    bool        bBounded;               // Response time is bounded
+} RTA_Task_t;
+
+//**************
+// Local Variables
+//**************
+
+static RTA_Task_t m_aTasks[RTA_MAX_TASKS];  // Task set, in order of addition
+static int m_nTasks = 0;                    // Number of tasks
+static double m_nCycPerTick = 0.0;          // Core cycles per tick, 0 if not given
+
+//**************
+// Local Functions
+//**************
+
+static void _RTA_usage(void);
+static bool _RTA_readTasks(const char *pPath);
+static bool _RTA_readTrace(const char *pPath);
+static bool _RTA_finishTasks(void);
+static double _RTA_blocking(int i);
+static bool _RTA_interferes(int j, int i);
+static double _RTA_busyPeriod(int i, double blocking);
+static void _RTA_analyzeTask(int i);
+static uint64_t _RTA_hyperperiod(void);
+
+//***************************************************************************
+// Function Name:   _RTA_usage
+// Returns:         void
+// Param1:          void
+// Description:     Prints the command line usage.
+//***************************************************************************
+static void _RTA_usage(void)
+{
+    fprintf(stderr, "usage: fcs_rta [-c cyclesPerTick] [-t traceFile] taskFile\n");
+}
+
+//***************************************************************************
+// Function Name:   _RTA_readTasks
+// Returns:         Success status of the parsing.
+// Param1:          *pPath - Task file to read.
+// Description:     Reads the task set.
+//***************************************************************************
+static bool _RTA_readTasks(const char *pPath)
+{
+    static FCS_TaskFileEntry_t aEntries[RTA_MAX_TASKS];
+    RTA_Task_t *pTask;
+    int nEntries = FCS_TASKFILE_read(pPath, aEntries, RTA_MAX_TASKS);
+
+    for(m_nTasks = 0; m_nTasks < nEntries; m_nTasks++)
+    {
+        pTask = &m_aTasks[m_nTasks];
+        memset(pTask, 0, sizeof(*pTask));
+        strcpy(pTask->name, aEntries[m_nTasks].name);
+        pTask->nIntvlTcks = aEntries[m_nTasks].nIntvlTcks;
+        pTask->prty = aEntries[m_nTasks].prty;
+        pTask->wcet = aEntries[m_nTasks].wcet;
+        pTask->bWcetTrace = aEntries[m_nTasks].bWcetTrace;
+        pTask->bWcetCyc = aEntries[m_nTasks].bWcetCyc;
+        pTask->dline = aEntries[m_nTasks].dline;
+    }
+
+    return (nEntries >= 0);
+}
+
+//***************************************************************************
+// Function Name:   _RTA_readTrace
+// Returns:         Success status of the parsing.
+// Param1:          *pPath - Cycle count trace to read.
+// Description:     Sets the WCET of the tasks marked "-" to their largest traced
+// cycle count.
+//***************************************************************************
+static bool _RTA_readTrace(const char *pPath)
+{
+    FILE *pFile = fopen(pPath, "r");
+    char aLine[RTA_LINE_LEN];
+    char aName[RTA_NAME_LEN];
+    double cycles;
+    int i;
+
+    if(pFile == NULL)
+    {
+        fprintf(stderr, "fcs_rta: cannot open %s\n", pPath);
+        return false;
+    }
+
+    while(fgets(aLine, sizeof(aLine), pFile) != NULL)
+    {
+        if(sscanf(aLine, "%31s %lf", aName, &cycles) != 2)
+        {
+            // Not a sample.
+            continue;
+        }
+
+        for(i = 0; i < m_nTasks; i++)
+        {
+            if(m_aTasks[i].bWcetTrace && (strcmp(m_aTasks[i].name, aName) == 0)
+                    && (cycles > m_aTasks[i].wcet))
+            {
+                m_aTasks[i].wcet = cycles;
+                m_aTasks[i].bWcetCyc = true;
+            }
+        }
+    }
+
+    fclose(pFile);
+
+    return true;
+}
+
+//***************************************************************************
+// Function Name:   _RTA_finishTasks
+// Returns:         Success status of the conversion.
+// Param1:          void
+// Description:     Converts cycle counts to ticks.
+//***************************************************************************
+static bool _RTA_finishTasks(void)
+{
+    int i;
+
+    for(i = 0; i < m_nTasks; i++)
+    {
+        if(m_aTasks[i].bWcetTrace && !m_aTasks[i].bWcetCyc)
+        {
+            fprintf(stderr, "fcs_rta: no trace samples for %s\n", m_aTasks[i].name);
+            return false;
+        }
+
+        if(m_aTasks[i].bWcetCyc)
+        {
+            if(m_nCycPerTick <= 0.0)
+            {
+                fprintf(stderr, "fcs_rta: %s needs -c to convert cycles to ticks\n",
+                        m_aTasks[i].name);
+                return false;
+            }
+
+            m_aTasks[i].wcet /= m_nCycPerTick;
+        }
+    }
+
+    return true;
+}
+
+//***************************************************************************
+// Function Name:   _RTA_blocking
+// Returns:         Blocking time of the task in ticks.
+// Param1:          i - Task to analyze.
+// Description:     Bounds the delay caused by work the dispatcher is already busy
+// with when the task is released: one lower priority or idle task, which cannot be
+// preempted.
+//***************************************************************************
+static double _RTA_blocking(int i)
+{
+    double blocking = 0.0;
+    int j;
+
+    for(j = 0; j < m_nTasks; j++)
+    {
+        if(m_aTasks[j].prty < m_aTasks[i].prty)
+        {
+            blocking = fmax(blocking, m_aTasks[j].wcet);
+        }
+    }
+
+    return blocking;
+}
+
+//***************************************************************************
+// Function Name:   _RTA_interferes
+// Returns:         True if task j may run before a pending job of task i.
+// Param1:          j - Other task.
+// Param2:          i - Task to analyze.
+// Description:     Higher priority tasks and the other tasks of the same level can
+// run ahead of task i. Immediate tasks preempt and are accounted separately.
+//***************************************************************************
+static bool _RTA_interferes(int j, int i)
+{
+    return (j != i) && (m_aTasks[j].prty >= m_aTasks[i].prty)
+            && (m_aTasks[j].prty != RTA_PRTY_IMMEDIATE);
+}
+
+//***************************************************************************
+// Function Name:   _RTA_busyPeriod
+// Returns:         Length of the level-i busy period in ticks, or a value above
+//                  RTA_HORIZON if it is unbounded.
+// Param1:          i - Task to analyze.
+// Param2:          blocking - Blocking time of the task.
+// Description:     Computes how long the dispatcher can stay busy with task i and the
+// tasks that run ahead of it.
+//***************************************************************************
+static double _RTA_busyPeriod(int i, double blocking)
+{
+    double len = blocking + m_aTasks[i].wcet;
+    double next;
+    int j;
+
+    while(len <= RTA_HORIZON)
+    {
+        next = blocking;
+
+        for(j = 0; j < m_nTasks; j++)
+        {
+            if((j == i) || _RTA_interferes(j, i) || (m_aTasks[j].prty == RTA_PRTY_IMMEDIATE))
+            {
+                next += ceil(len / m_aTasks[j].nIntvlTcks) * m_aTasks[j].wcet;
+            }
+        }
+
+        if(next <= len)
+        {
+            break;
+        }
+
+        len = next;
+    }
+
+    return len;
+}
+
+//***************************************************************************
+// Function Name:   _RTA_analyzeTask
+// Returns:         void
+// Param1:          i - Task to analyze.
+// Description:     Computes the worst-case response time of a task.
+//***************************************************************************
+static void _RTA_analyzeTask(int i)
+{
+    RTA_Task_t *pTask = &m_aTasks[i];
+    double blocking;
+    double len;
+    double start;
+    double next;
+    double finish;
+    double nPrior;
+    uint32_t q;
+    uint32_t nJobs;
+    int j;
+
+    pTask->resp = 0.0;
+    pTask->bBounded = true;
+
+    if(pTask->prty == RTA_PRTY_IMMEDIATE)
+    {
+        // Immediate tasks share one preemption level and may all be released on the
+        // same tick.
+        for(j = 0; j < m_nTasks; j++)
+        {
+            if(m_aTasks[j].prty == RTA_PRTY_IMMEDIATE)
+            {
+                pTask->resp += m_aTasks[j].wcet;
+            }
+        }
+
+        return;
+    }
+
+    blocking = _RTA_blocking(i);
+    len = _RTA_busyPeriod(i, blocking);
+
+    if(len > RTA_HORIZON)
+    {
+        pTask->bBounded = false;
+        return;
+    }
+
+    nJobs = (uint32_t) ceil(len / pTask->nIntvlTcks);
+
+    for(q = 0; q < nJobs; q++)
+    {
+        // Start time of job q: blocking, the earlier jobs of the task and every job
+        // released ahead of it up to its start.
+        start = blocking + (q * pTask->wcet);
+
+        while(true)
+        {
+            next = blocking + (q * pTask->wcet);
+
+            for(j = 0; j < m_nTasks; j++)
+            {
+                if(_RTA_interferes(j, i) || (m_aTasks[j].prty == RTA_PRTY_IMMEDIATE))
+                {
+                    next += (floor(start / m_aTasks[j].nIntvlTcks) + 1.0) * m_aTasks[j].wcet;
+                }
+            }
+
+            if((next <= start) || (next > RTA_HORIZON))
+            {
+                break;
+            }
+
+            start = next;
+        }
+
+        // Once started the job only yields to Immediate tasks.
+        finish = start + pTask->wcet;
+
+        while(true)
+        {
+            next = start + pTask->wcet;
+
+            for(j = 0; j < m_nTasks; j++)
+            {
+                if(m_aTasks[j].prty == RTA_PRTY_IMMEDIATE)
+                {
+                    nPrior = floor(start / m_aTasks[j].nIntvlTcks) + 1.0;
+                    next += fmax(ceil(finish / m_aTasks[j].nIntvlTcks) - nPrior, 0.0)
+                            * m_aTasks[j].wcet;
+                }
+            }
+
+            if((next <= finish) || (next > RTA_HORIZON))
+            {
+                break;
+            }
+
+            finish = next;
+        }
+
+        if(finish > RTA_HORIZON)
+        {
+            pTask->bBounded = false;
+            return;
+        }
+
+        pTask->resp = fmax(pTask->resp, finish - ((double) q * pTask->nIntvlTcks));
+    }
+}
+
+//***************************************************************************
+// Function Name:   _RTA_hyperperiod
+// Returns:         Least common multiple of the task intervals in ticks, 0 if it
+//                  does not fit in 64 bits.
+// Param1:          void
+// Description:     Computes the hyperperiod of the periodic tasks.
+//***************************************************************************
+static uint64_t _RTA_hyperperiod(void)
+{
+    uint64_t nLcm = 1;
+    uint64_t a;
+    uint64_t b;
+    uint64_t t;
+    int i;
+
+    for(i = 0; i < m_nTasks; i++)
+    {
+        if(m_aTasks[i].prty == RTA_PRTY_IDLE)
+        {
+            continue;
+        }
+
+        // Greatest common divisor of the running LCM and the interval.
+        a = nLcm;
+        b = m_aTasks[i].nIntvlTcks;
+
+        while(b != 0)
+        {
+            t = a % b;
+            a = b;
+            b = t;
+        }
+
+        t = m_aTasks[i].nIntvlTcks / a;
+
+        if(nLcm > (UINT64_MAX / t))
+        {
+            return 0;
+        }
+
+        nLcm *= t;
+    }
+
+    return nLcm;
+}
+
+//**************
+// Global Functions
+//**************
+
+//***************************************************************************
+// Function Name:   main
+// Returns:         0 if the task set is schedulable, 1 if not, 2 on invalid input.
+// Param1:          argc - Number of arguments.
+// Param2:          **argv - Arguments.
+// Description:     Analyzes a task set and prints the report.
+//***************************************************************************
+int main(int argc, char **argv)
+{
+    const char *pTrace = NULL;
+    const char *pTasks = NULL;
+    double util = 0.0;
+    uint64_t nHyper;
+    bool bOk = true;
+    int i;
+
+    for(i = 1; i < argc; i++)
+    {
+        if((strcmp(argv[i], "-c") == 0) && ((i + 1) < argc))
+        {
+            m_nCycPerTick = strtod(argv[++i], NULL);
+        }
+        else if((strcmp(argv[i], "-t") == 0) && ((i + 1) < argc))
+        {
+            pTrace = argv[++i];
+        }
+        else if((argv[i][0] != '-') && (pTasks == NULL))
+        {
+            pTasks = argv[i];
+        }
+        else
+        {
+            _RTA_usage();
+            return 2;
+        }
+    }
+
+    if(pTasks == NULL)
+    {
+        _RTA_usage();
+        return 2;
+    }
+
+    if(!_RTA_readTasks(pTasks) || ((pTrace != NULL) && !_RTA_readTrace(pTrace))
+            || !_RTA_finishTasks())
+    {
+        return 2;
+    }
+
+    printf("%-20s %-9s %10s %10s %10s %10s %s\n",
+            "Task", "Priority", "Interval", "WCET", "Deadline", "Response", "Result");
+
+    for(i = 0; i < m_nTasks; i++)
+    {
+        if(m_aTasks[i].prty == RTA_PRTY_IDLE)
+        {
+            printf("%-20s %-9s %10s %10.3f %10s %10s %s\n", m_aTasks[i].name,
+                    FCS_TASKFILE_prtyName(m_aTasks[i].prty), "-", m_aTasks[i].wcet, "-", "-",
+                    "idle");
+            continue;
+        }
+
+        util += m_aTasks[i].wcet / m_aTasks[i].nIntvlTcks;
+        _RTA_analyzeTask(i);
+
+        if(!m_aTasks[i].bBounded)
+        {
+            bOk = false;
+            printf("%-20s %-9s %10lu %10.3f %10.3f %10s %s\n", m_aTasks[i].name,
+                    FCS_TASKFILE_prtyName(m_aTasks[i].prty), (unsigned long) m_aTasks[i].nIntvlTcks,
+                    m_aTasks[i].wcet, m_aTasks[i].dline, "unbounded", "MISS");
+        }
+        else
+        {
+            if(m_aTasks[i].resp > m_aTasks[i].dline)
+            {
+                bOk = false;
+            }
+
+            printf("%-20s %-9s %10lu %10.3f %10.3f %10.3f %s\n", m_aTasks[i].name,
+                    FCS_TASKFILE_prtyName(m_aTasks[i].prty), (unsigned long) m_aTasks[i].nIntvlTcks,
+                    m_aTasks[i].wcet, m_aTasks[i].dline, m_aTasks[i].resp,
+                    (m_aTasks[i].resp > m_aTasks[i].dline) ? "MISS" : "ok");
+        }
+    }
+
+    nHyper = _RTA_hyperperiod();
+
+    printf("\nUtilization: %.3f\n", util);
+
+    if(nHyper == 0)
+    {
+        printf("Hyperperiod: exceeds 64 bits\n");
+    }
+    else
+    {
+        printf("Hyperperiod: %llu ticks\n", (unsigned long long) nHyper);
+    }
+
+    printf("Schedulable: %s\n", bOk ? "yes" : "no");
+
+    return bOk ? 0 : 1;
+}
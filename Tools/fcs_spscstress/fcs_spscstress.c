@@ -0,0 +1,378 @@
+//***********************************************************************************
+// Module Name:         fcs_spscstress.c
+// Application:         Host tool
+// Platform:            Any host with a C99 compiler and POSIX threads
+// Author(s):           Derrick Simeon
+// Notes:
+// Description:
+// Host stress test of the SPSC queues. A producer thread and a consumer thread hammer
+// one queue, each picking one of its three ways in at random for every operation: the
+// producer push, pushBatch or reserve/commit, the consumer pop, popBatch or
+// peek/release. The indices start just below their 32-bit wrap so the test runs
+// across it.
+//
+// Build:   S=../../Sources/Franklin_Library
+//          gcc -std=c99 -O2 -pthread -I$S/SPSC_QUEUE -I$S/TASK_SCHEDULER -o fcs_spscstress
+//              fcs_spscstress.c $S/SPSC_QUEUE/spsc_queue.c $S/TASK_SCHEDULER/task_schdlr.c
+// Usage:   fcs_spscstress [-n elements] [-r seed]
+//
+// Each element carries its sequence number and a check word derived from it, and is
+// larger than a word so a torn copy shows. The consumer checks that the elements
+// arrive in order, none missing, none twice and none corrupted. The producer retries
+// the elements a full queue rejected and counts them, and the queue's drop count has
+// to match. Either side yields the CPU when the queue is full or empty, so the test
+// also completes on a single core host.
+//
+// The host's aligned 32-bit loads and stores are single-copy atomic like those of the
+// Cortex-M4, and __sync_synchronize is a full barrier on both, which is all the queue
+// relies on.
+//
+// Exit status: 0 if every element arrived intact and in order, 1 otherwise, 2 on
+// invalid input.
+// Copyright (c) 2016, Franklin Control Systems, all rights reserved
+//***********************************************************************************
+
+//**************
+// Includes
+//**************
+
+// Standard C libraries
+#define _POSIX_C_SOURCE 200112L
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <sched.h>
+
+// Project-specific modules
+#include "spsc_queue.h"
+
+//**************
+// Defines
+//**************
+
+#define STRESS_CAPACITY     64                          // Queue slots
+#define STRESS_MAX_BATCH    24                          // Most elements per batch call
+#define STRESS_INDEX_BASE   ((uint32_t) 0xFFFFFF00UL)   // Queue indices at the start
+#define STRESS_CHECK(seq)   (((seq) * 2654435761UL) ^ 0xA5A5A5A5UL)
+
+//**************
+// Local Typedefs
+//**************
+
+typedef struct
+{
+    uint32_t            nSeq;           // Sequence number
+    uint32_t            nCheck;         // STRESS_CHECK of the sequence number
+    uint32_t            nNot;           // Complement of the sequence number
+} STRESS_Elem_t;
+
+//**************
+// Local Variables
+//**************
+
+static STRESS_Elem_t m_aBuf[STRESS_CAPACITY];
+static FCS_SpscQueue_t m_queue;
+static uint32_t m_nElems;                       // Elements to pass
+static uint32_t m_nSeed;                        // Seed of both threads' random numbers
+
+static uint32_t m_nRejected = 0;                // Elements the producer had to retry
+static uint32_t m_nRecvd = 0;                   // Elements received in order
+static uint32_t m_nBad = 0;                     // Elements out of order or corrupted
+static uint32_t m_nOverCap = 0;                 // Counts above the capacity
+static uint32_t m_nFulls = 0;                   // Times the producer found the queue full
+static uint32_t m_nEmpties = 0;                 // Times the consumer found the queue empty
+
+//**************
+// Local Functions
+//**************
+
+static uint32_t _STRESS_rand(uint32_t *pnState);
+static void _STRESS_fill(STRESS_Elem_t *pElem, uint32_t nSeq);
+static bool _STRESS_check(const STRESS_Elem_t *pElem);
+static void *_STRESS_producer(void *pArg);
+static void *_STRESS_consumer(void *pArg);
+
+//***************************************************************************
+// Function Name:   _STRESS_rand
+// Returns:         Random number from 0 to 65535.
+// Param1:          *pnState - Random number state of the calling thread.
+// Description:     Linear congruential generator.
+//***************************************************************************
+static uint32_t _STRESS_rand(uint32_t *pnState)
+{
+    *pnState = (*pnState * 1103515245UL) + 12345UL;
+
+    return (*pnState >> 16) & 0xFFFFUL;
+}
+
+//***************************************************************************
+// Function Name:   _STRESS_fill
+// Returns:         void
+// Param1:          *pElem - Element to fill in.
+// Param2:          nSeq - Sequence number.
+// Description:     Fills in an element for a sequence number.
+//***************************************************************************
+static void _STRESS_fill(STRESS_Elem_t *pElem, uint32_t nSeq)
+{
+    pElem->nSeq = nSeq;
+    pElem->nCheck = (uint32_t) STRESS_CHECK(nSeq);
+    pElem->nNot = ~nSeq;
+}
+
+//***************************************************************************
+// Function Name:   _STRESS_check
+// Returns:         True if the element is the next one expected and intact.
+// Param1:          *pElem - Element received.
+// Description:     Checks an element on the consumer side and counts it.
+//***************************************************************************
+static bool _STRESS_check(const STRESS_Elem_t *pElem)
+{
+    bool bOk = (pElem->nSeq == m_nRecvd) && (pElem->nCheck == (uint32_t) STRESS_CHECK(pElem->nSeq))
+            && (pElem->nNot == ~pElem->nSeq);
+
+    if(bOk)
+    {
+        m_nRecvd++;
+    }
+    else
+    {
+        m_nBad++;
+    }
+
+    return bOk;
+}
+
+//***************************************************************************
+// Function Name:   _STRESS_producer
+// Returns:         NULL
+// Param1:          *pArg - Unused.
+// Description:     Producer thread. Passes m_nElems elements in sequence.
+//***************************************************************************
+static void *_STRESS_producer(void *pArg)
+{
+    STRESS_Elem_t aBatch[STRESS_MAX_BATCH];
+    STRESS_Elem_t *pSlots;
+    uint32_t nRand = m_nSeed;
+    uint32_t nSeq = 0;
+    uint32_t nElems;
+    uint32_t nDone;
+    uint32_t idx;
+
+    (void) pArg;
+
+    while(nSeq < m_nElems)
+    {
+        nElems = 1 + (_STRESS_rand(&nRand) % STRESS_MAX_BATCH);
+
+        if(nElems > (m_nElems - nSeq))
+        {
+            nElems = m_nElems - nSeq;
+        }
+
+        switch(_STRESS_rand(&nRand) % 3)
+        {
+            case 0:
+                _STRESS_fill(&aBatch[0], nSeq);
+                nDone = FCS_SPSC_QUEUE_push(&m_queue, &aBatch[0]) ? 1 : 0;
+                nElems = 1;
+                break;
+
+            case 1:
+                for(idx = 0; idx < nElems; idx++)
+                {
+                    _STRESS_fill(&aBatch[idx], nSeq + idx);
+                }
+
+                nDone = FCS_SPSC_QUEUE_pushBatch(&m_queue, aBatch, nElems);
+                break;
+
+            default:
+                pSlots = (STRESS_Elem_t *) FCS_SPSC_QUEUE_reserve(&m_queue, &nDone);
+
+                if(nDone > nElems)
+                {
+                    nDone = nElems;
+                }
+
+                for(idx = 0; idx < nDone; idx++)
+                {
+                    _STRESS_fill(&pSlots[idx], nSeq + idx);
+                }
+
+                FCS_SPSC_QUEUE_commit(&m_queue, nDone);
+
+                // Reserve does not count a full queue as dropped.
+                nElems = nDone;
+                break;
+        }
+
+        m_nRejected += nElems - nDone;
+        nSeq += nDone;
+
+        if(nDone == 0)
+        {
+            m_nFulls++;
+            (void) sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+//***************************************************************************
+// Function Name:   _STRESS_consumer
+// Returns:         NULL
+// Param1:          *pArg - Unused.
+// Description:     Consumer thread. Receives and checks the elements until all have
+// arrived or one was wrong.
+//***************************************************************************
+static void *_STRESS_consumer(void *pArg)
+{
+    STRESS_Elem_t aBatch[STRESS_MAX_BATCH];
+    const STRESS_Elem_t *pSlots;
+    uint32_t nRand = m_nSeed ^ 0x5A5A5A5AUL;
+    uint32_t nElems;
+    uint32_t nDone;
+    uint32_t idx;
+    bool bEmpty;
+
+    (void) pArg;
+
+    while((m_nRecvd < m_nElems) && (m_nBad == 0))
+    {
+        if(FCS_SPSC_QUEUE_count(&m_queue) > STRESS_CAPACITY)
+        {
+            m_nOverCap++;
+        }
+
+        nElems = 1 + (_STRESS_rand(&nRand) % STRESS_MAX_BATCH);
+
+        switch(_STRESS_rand(&nRand) % 3)
+        {
+            case 0:
+                nDone = FCS_SPSC_QUEUE_pop(&m_queue, &aBatch[0]) ? 1 : 0;
+                bEmpty = (nDone == 0);
+                break;
+
+            case 1:
+                nDone = FCS_SPSC_QUEUE_popBatch(&m_queue, aBatch, nElems);
+                bEmpty = (nDone == 0);
+                break;
+
+            default:
+                pSlots = (const STRESS_Elem_t *) FCS_SPSC_QUEUE_peek(&m_queue, &nDone);
+
+                if(nDone > nElems)
+                {
+                    nDone = nElems;
+                }
+
+                for(idx = 0; idx < nDone; idx++)
+                {
+                    (void) _STRESS_check(&pSlots[idx]);
+                }
+
+                FCS_SPSC_QUEUE_release(&m_queue, nDone);
+                bEmpty = (nDone == 0);
+
+                // Checked in place.
+                nDone = 0;
+                break;
+        }
+
+        for(idx = 0; idx < nDone; idx++)
+        {
+            (void) _STRESS_check(&aBatch[idx]);
+        }
+
+        if(bEmpty)
+        {
+            m_nEmpties++;
+            (void) sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+//***************************************************************************
+// Function Name:   main
+// Returns:         0 if every element arrived intact and in order, 1 otherwise, 2 on
+//                  invalid input.
+// Param1:          argc - Number of arguments.
+// Param2:          **argv - Arguments.
+// Description:     Runs the stress test and prints its counts.
+//***************************************************************************
+int main(int argc, char **argv)
+{
+    pthread_t prodThread;
+    pthread_t consThread;
+    bool bPass;
+    int arg;
+
+    m_nElems = 10000000;
+    m_nSeed = 1;
+
+    for(arg = 1; arg < argc; arg++)
+    {
+        if((argv[arg][0] == '-') && (argv[arg][1] != '\0') && (argv[arg][2] == '\0') && ((arg + 1) < argc))
+        {
+            switch(argv[arg][1])
+            {
+                case 'n':
+                    m_nElems = (uint32_t) strtoul(argv[++arg], NULL, 10);
+                    continue;
+                case 'r':
+                    m_nSeed = (uint32_t) strtoul(argv[++arg], NULL, 10);
+                    continue;
+                default:
+                    break;
+            }
+        }
+
+        fprintf(stderr, "usage: fcs_spscstress [-n elements] [-r seed]\n");
+        return 2;
+    }
+
+    if((m_nElems == 0) || (m_nElems > 0x7FFFFFFFUL))
+    {
+        fprintf(stderr, "fcs_spscstress: 1 to 2^31 - 1 elements\n");
+        return 2;
+    }
+
+    (void) FCS_SPSC_QUEUE_init(&m_queue, m_aBuf, sizeof(m_aBuf[0]), STRESS_CAPACITY);
+
+    // Place the indices just below the wrap.
+    m_queue.nHead = STRESS_INDEX_BASE;
+    m_queue.nTail = STRESS_INDEX_BASE;
+
+    if((pthread_create(&consThread, NULL, &_STRESS_consumer, NULL) != 0)
+            || (pthread_create(&prodThread, NULL, &_STRESS_producer, NULL) != 0))
+    {
+        fprintf(stderr, "fcs_spscstress: cannot start the threads\n");
+        return 2;
+    }
+
+    (void) pthread_join(consThread, NULL);
+
+    if(m_nBad == 0)
+    {
+        (void) pthread_join(prodThread, NULL);
+    }
+
+    bPass = (m_nRecvd == m_nElems) && (m_nBad == 0) && (m_nOverCap == 0)
+            && (FCS_SPSC_QUEUE_count(&m_queue) == 0);
+
+    printf("elements passed %lu, received in order %lu, bad %lu\n", (unsigned long) m_nElems,
+            (unsigned long) m_nRecvd, (unsigned long) m_nBad);
+    printf("rejected by a full queue %lu, drop count %lu, counts above capacity %lu\n",
+            (unsigned long) m_nRejected, (unsigned long) FCS_SPSC_QUEUE_getDropped(&m_queue),
+            (unsigned long) m_nOverCap);
+    printf("queue found full %lu times, empty %lu times\n", (unsigned long) m_nFulls,
+            (unsigned long) m_nEmpties);
+    printf("%s\n", bPass ? "PASS" : "FAIL");
+
+    return bPass ? 0 : 1;
+}
@@ -0,0 +1,204 @@
+//***********************************************************************************
+// Module Name:         fcs_taskfile.c
+// Application:         Host tool
+// Platform:            Any host with a C99 compiler
+// Author(s):           Derrick Simeon
+// Notes:
+// Description:
+// Task file reader shared by the host tools. See fcs_taskfile.h for the format.
+// Copyright (c) 2016, Franklin Control Systems, all rights reserved
+//***********************************************************************************
+
+//**************
+// Includes
+//**************
+
+// Standard C libraries
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+// Project-specific modules
+#include "fcs_taskfile.h"
+
+//**************
+// Defines
+//**************
+
+#define TASKFILE_LINE_LEN   256         // Longest input line
+
+//**************
+// Local Variables
+//**************
+
+static const char *m_apPrtyNames[] = {"Idle", "Low", "Normal", "High", "Critical", "Immediate"};
+
+//**************
+// Local Functions
+//**************
+
+static bool _FCS_TASKFILE_parsePrty(const char *pTok, int *pPrty);
+
+//***************************************************************************
+// Function Name:   _FCS_TASKFILE_parsePrty
+// Returns:         Success status of the conversion.
+// Param1:          *pTok - Priority level name or number.
+// Param2:          *pPrty - Receives the priority level.
+// Description:     Converts a priority level token.
+//***************************************************************************
+static bool _FCS_TASKFILE_parsePrty(const char *pTok, int *pPrty)
+{
+    int prty;
+    size_t nChar;
+
+    if(isdigit((unsigned char) pTok[0]) && (pTok[1] == '\0'))
+    {
+        *pPrty = pTok[0] - '0';
+        return (*pPrty <= FCS_TASKFILE_PRTY_IMMEDIATE);
+    }
+
+    for(prty = FCS_TASKFILE_PRTY_IDLE; prty <= FCS_TASKFILE_PRTY_IMMEDIATE; prty++)
+    {
+        for(nChar = 0; (pTok[nChar] != '\0') && (m_apPrtyNames[prty][nChar] != '\0'); nChar++)
+        {
+            if(tolower((unsigned char) pTok[nChar]) != tolower((unsigned char) m_apPrtyNames[prty][nChar]))
+            {
+                break;
+            }
+        }
+
+        if((pTok[nChar] == '\0') && (m_apPrtyNames[prty][nChar] == '\0'))
+        {
+            *pPrty = prty;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//**************
+// Global Functions
+//**************
+
+//***************************************************************************
+// Function Name:   FCS_TASKFILE_read
+// Returns:         Number of tasks read, or -1 if the file cannot be read or holds an
+//                  invalid line.
+// Param1:          *pPath - Task file to read.
+// Param2:          *pTasks - Receives the tasks, in file order.
+// Param3:          nMaxTasks - Size of pTasks.
+// Description:     Reads a task file. Errors are printed to stderr with the file name
+// and line.
+//***************************************************************************
+int FCS_TASKFILE_read(const char *pPath, FCS_TaskFileEntry_t *pTasks, int nMaxTasks)
+{
+    FILE *pFile = fopen(pPath, "r");
+    char aLine[TASKFILE_LINE_LEN];
+    char aName[FCS_TASKFILE_NAME_LEN];
+    char aPrty[FCS_TASKFILE_NAME_LEN];
+    char aWcet[FCS_TASKFILE_NAME_LEN];
+    char *pEnd;
+    FCS_TaskFileEntry_t *pTask;
+    unsigned long nIntvl;
+    double dline;
+    int nTasks = 0;
+    int nLine = 0;
+    int nFields;
+
+    if(pFile == NULL)
+    {
+        fprintf(stderr, "cannot open %s\n", pPath);
+        return -1;
+    }
+
+    while(fgets(aLine, sizeof(aLine), pFile) != NULL)
+    {
+        nLine++;
+
+        // Strip comments.
+        pEnd = strchr(aLine, '#');
+
+        if(pEnd != NULL)
+        {
+            *pEnd = '\0';
+        }
+
+        nFields = sscanf(aLine, "%31s %lu %31s %31s %lf", aName, &nIntvl, aPrty, aWcet, &dline);
+
+        if(nFields <= 0)
+        {
+            // Blank line.
+            continue;
+        }
+
+        if(nTasks == nMaxTasks)
+        {
+            fprintf(stderr, "%s:%d: more than %d tasks\n", pPath, nLine, nMaxTasks);
+            fclose(pFile);
+            return -1;
+        }
+
+        pTask = &pTasks[nTasks];
+        memset(pTask, 0, sizeof(*pTask));
+
+        if((nFields < 4) || !_FCS_TASKFILE_parsePrty(aPrty, &pTask->prty) || (nIntvl > UINT32_MAX))
+        {
+            fprintf(stderr, "%s:%d: expected \"name interval priority wcet [deadline]\"\n",
+                    pPath, nLine);
+            fclose(pFile);
+            return -1;
+        }
+
+        strcpy(pTask->name, aName);
+        pTask->nLine = nLine;
+
+        // Intervals of 0 and 1 both release the task on every tick.
+        pTask->nIntvlTcks = (nIntvl > 0) ? (uint32_t) nIntvl : 1;
+        pTask->bDline = (nFields == 5);
+        pTask->dline = pTask->bDline ? dline : (double) pTask->nIntvlTcks;
+
+        if(pTask->dline <= 0.0)
+        {
+            fprintf(stderr, "%s:%d: deadline must be positive\n", pPath, nLine);
+            fclose(pFile);
+            return -1;
+        }
+
+        if(strcmp(aWcet, "-") == 0)
+        {
+            pTask->bWcetTrace = true;
+        }
+        else
+        {
+            pTask->wcet = strtod(aWcet, &pEnd);
+            pTask->bWcetCyc = ((pEnd[0] == 'c') && (pEnd[1] == '\0'));
+
+            if((pEnd == aWcet) || ((pEnd[0] != '\0') && !pTask->bWcetCyc) || (pTask->wcet < 0.0))
+            {
+                fprintf(stderr, "%s:%d: bad wcet \"%s\"\n", pPath, nLine, aWcet);
+                fclose(pFile);
+                return -1;
+            }
+        }
+
+        nTasks++;
+    }
+
+    fclose(pFile);
+
+    return nTasks;
+}
+
+//***************************************************************************
+// Function Name:   FCS_TASKFILE_prtyName
+// Returns:         Name of the priority level.
+// Param1:          prty - Priority level, FCS_TASKFILE_PRTY_IDLE to
+//                  FCS_TASKFILE_PRTY_IMMEDIATE.
+// Description:     Names a priority level for reports.
+//***************************************************************************
+const char *FCS_TASKFILE_prtyName(int prty)
+{
+    return m_apPrtyNames[prty];
+}
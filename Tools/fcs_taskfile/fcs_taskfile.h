@@ -0,0 +1,92 @@
+//***********************************************************************************
+// Module Name:         fcs_taskfile.h
+// Application:         Host tool
+// Platform:            Any host with a C99 compiler
+// Author(s):           Derrick Simeon
+// Notes:
+// Description:
+// Task file reader shared by the host tools that take a task set, fcs_rta and fcs_cyc,
+// so both accept exactly the same files.
+//
+// The task file lists one task per line, in the order the tasks are added:
+//     name  interval  priority  wcet  [deadline]
+// - interval is in ticks. Intervals of 0 and 1 both release the task on every tick.
+// - priority is Idle, Low, Normal, High, Critical or Immediate, in any case, or its
+//   number in FCS_TaskPriority_e.
+// - wcet is in ticks, in core cycles with a "c" suffix (e.g. 5400c), or "-" to take it
+//   from a trace. Cycle counts are left for the tool to convert.
+// - deadline is in ticks and may be fractional. It defaults to the interval.
+// Text after a '#' is ignored.
+//
+// Usage instructions:
+// Build fcs_taskfile.c with the tool and add -I../fcs_taskfile.
+// Copyright (c) 2016, Franklin Control Systems, all rights reserved
+//***********************************************************************************
+
+#ifndef FCS_TASKFILE_H_
+#define FCS_TASKFILE_H_
+
+//**************
+// Includes
+//**************
+
+// Standard C libraries
+#include <stdint.h>
+#include <stdbool.h>
+
+//**************
+// Defines
+//**************
+
+#define FCS_TASKFILE_MAX_TASKS      255         // Largest task list supported by the scheduler
+#define FCS_TASKFILE_NAME_LEN       32          // Longest task name, including terminator
+
+// Priority levels, as in FCS_TaskPriority_e
+#define FCS_TASKFILE_PRTY_IDLE      0
+#define FCS_TASKFILE_PRTY_LOW       1
+#define FCS_TASKFILE_PRTY_CRITICAL  4
+#define FCS_TASKFILE_PRTY_IMMEDIATE 5
+
+//**************
+// Global Typedefs
+//**************
+
+// Task as listed in the task file
+typedef struct _FCS_TaskFileEntry_t {
+    char        name[FCS_TASKFILE_NAME_LEN]; // Task name
+    uint32_t    nIntvlTcks;             // Interval in ticks, at least 1
+    int         prty;                   // Priority level
+    double      wcet;                   // Worst-case execution time in ticks or cycles
+    bool        bWcetTrace;             // WCET is to come from a trace
+    bool        bWcetCyc;               // WCET is in cycles
+    bool        bDline;                 // Deadline was given
+    double      dline;                  // Relative deadline in ticks
+    int         nLine;                  // Line of the task file, for messages
+} FCS_TaskFileEntry_t;
+
+//**************
+// Global Functions
+//**************
+
+//***************************************************************************
+// Function Name:   FCS_TASKFILE_read
+// Returns:         Number of tasks read, or -1 if the file cannot be read or holds an
+//                  invalid line.
+// Param1:          *pPath - Task file to read.
+// Param2:          *pTasks - Receives the tasks, in file order.
+// Param3:          nMaxTasks - Size of pTasks.
+// Description:     Reads a task file. Errors are printed to stderr with the file name
+// and line.
+//***************************************************************************
+extern int FCS_TASKFILE_read(const char *pPath, FCS_TaskFileEntry_t *pTasks, int nMaxTasks);
+
+//***************************************************************************
+// Function Name:   FCS_TASKFILE_prtyName
+// Returns:         Name of the priority level.
+// Param1:          prty - Priority level, FCS_TASKFILE_PRTY_IDLE to
+//                  FCS_TASKFILE_PRTY_IMMEDIATE.
+// Description:     Names a priority level for reports.
+//***************************************************************************
+extern const char *FCS_TASKFILE_prtyName(int prty);
+
+#endif /* FCS_TASKFILE_H_ */
@@ -0,0 +1,242 @@
+//***********************************************************************************
+// Module Name:         fcs_tickstress.c
+// Application:         Host tool
+// Platform:            Any host with a C99 compiler and POSIX threads
+// Author(s):           Derrick Simeon
+// Notes:
+// Description:
+// Host stress test of the task scheduler's tick counter. A thread standing in for the
+// TU1 interrupt hammers FCS_TASK_SCHDLR_clockTick in bursts and pauses of random
+// length while the real dispatcher takes the ticks on the main thread. The counter
+// starts just below its 32-bit wrap so the test runs across it.
+//
+// Build:   S=../../Sources/Franklin_Library/TASK_SCHEDULER
+//          gcc -std=c99 -O2 -pthread -I$S -o fcs_tickstress fcs_tickstress.c $S/task_schdlr.c
+// Usage:   fcs_tickstress [-t ticks] [-r seed]
+//
+// A Critical task with a 1 tick interval and catch-up release runs once for every tick
+// taken, so its runs have to match the ticks added exactly: a lost tick would show as
+// a missing run and a tick counted twice as an extra one. Each run also checks that
+// FCS_TASK_SCHDLR_now never goes backwards. The overrun count is printed; it only has
+// to stay below the number of ticks, since it depends on the thread timing.
+//
+// The host's aligned 32-bit loads and stores are single-copy atomic like those of the
+// Cortex-M4, which is all the scheduler's single-writer scheme relies on.
+//
+// Exit status: 0 if every tick was taken exactly once, 1 otherwise, 2 on invalid
+// input.
+// Copyright (c) 2016, Franklin Control Systems, all rights reserved
+//***********************************************************************************
+
+//**************
+// Includes
+//**************
+
+// Standard C libraries
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <setjmp.h>
+#include <pthread.h>
+
+// Project-specific modules
+#include "task_schdlr.h"
+
+//**************
+// Defines
+//**************
+
+#define STRESS_TICK_BASE    ((uint32_t) 0xFFFF0000UL)   // Counter value when the dispatcher starts
+#define STRESS_MAX_PAUSE    2000            // Longest pause between ticks in loop turns
+
+//**************
+// Local Variables
+//**************
+
+static FCS_Task_t m_aTaskLst[2];
+static jmp_buf m_stopJmp;                       // Leaves the dispatcher
+static pthread_t m_isrThread;
+static volatile bool m_bIsrDone = false;        // All ticks added
+static uint32_t m_nTickLim;                     // Ticks to add
+static uint32_t m_nRand;                        // Random number state of the ISR thread
+
+static uint32_t m_nRuns = 0;                    // Critical task runs
+static uint32_t m_nLastNow;                     // FCS_TASK_SCHDLR_now at the previous run
+static uint32_t m_nBackwards = 0;               // Runs that saw the tick count go back
+static uint32_t m_nAhead = 0;                   // Runs ahead of the ticks counted
+
+//**************
+// Local Functions
+//**************
+
+static void *_STRESS_isr(void *pArg);
+static void _STRESS_task(void);
+static void _STRESS_idle(void);
+
+//***************************************************************************
+// Function Name:   _STRESS_isr
+// Returns:         NULL
+// Param1:          *pArg - Unused.
+// Description:     Tick interrupt thread. Adds the ticks one at a time, in bursts
+// without pauses or after random busy waits.
+//***************************************************************************
+static void *_STRESS_isr(void *pArg)
+{
+    volatile uint32_t nWait;
+    uint32_t nTick;
+
+    (void) pArg;
+
+    for(nTick = 0; nTick < m_nTickLim; nTick++)
+    {
+        FCS_TASK_SCHDLR_clockTick();
+
+        m_nRand = (m_nRand * 1103515245UL) + 12345UL;
+
+        if(((m_nRand >> 16) & 3) != 0)
+        {
+            for(nWait = (m_nRand >> 8) % STRESS_MAX_PAUSE; nWait > 0; nWait--)
+            {
+                // Time between interrupts.
+            }
+        }
+    }
+
+    m_bIsrDone = true;
+
+    return NULL;
+}
+
+//***************************************************************************
+// Function Name:   _STRESS_task
+// Returns:         void
+// Param1:          void
+// Description:     Critical task, run once per tick taken.
+//***************************************************************************
+static void _STRESS_task(void)
+{
+    uint32_t nNow = FCS_TASK_SCHDLR_now();
+
+    if((nNow - m_nLastNow) > 0x80000000UL)
+    {
+        m_nBackwards++;
+    }
+
+    m_nLastNow = nNow;
+    m_nRuns++;
+
+    // Run n is for tick n, so it cannot come before the timer counted that tick.
+    if((nNow - STRESS_TICK_BASE) < m_nRuns)
+    {
+        m_nAhead++;
+    }
+}
+
+//***************************************************************************
+// Function Name:   _STRESS_idle
+// Returns:         void
+// Param1:          void
+// Description:     Idle task. Starts the interrupt thread on its first run and
+// leaves the dispatcher once every tick has been added and taken.
+//***************************************************************************
+static void _STRESS_idle(void)
+{
+    static bool bStarted = false;
+
+    if(!bStarted)
+    {
+        bStarted = true;
+
+        if(pthread_create(&m_isrThread, NULL, &_STRESS_isr, NULL) != 0)
+        {
+            fprintf(stderr, "fcs_tickstress: cannot start the interrupt thread\n");
+            exit(2);
+        }
+    }
+
+    if(m_bIsrDone && (FCS_TASK_SCHDLR_getIdleTicks() != 0))
+    {
+        longjmp(m_stopJmp, 1);
+    }
+}
+
+//***************************************************************************
+// Function Name:   main
+// Returns:         0 if every tick was taken exactly once, 1 otherwise, 2 on invalid
+//                  input.
+// Param1:          argc - Number of arguments.
+// Param2:          **argv - Arguments.
+// Description:     Runs the stress test and prints its counts.
+//***************************************************************************
+int main(int argc, char **argv)
+{
+    FCS_TaskCode_t taskCode;
+    FCS_TaskHandle_t hTask;
+    uint32_t nNow;
+    bool bPass;
+    int arg;
+
+    m_nTickLim = 10000000;
+    m_nRand = 1;
+
+    for(arg = 1; arg < argc; arg++)
+    {
+        if((argv[arg][0] == '-') && (argv[arg][1] != '\0') && (argv[arg][2] == '\0') && ((arg + 1) < argc))
+        {
+            switch(argv[arg][1])
+            {
+                case 't':
+                    m_nTickLim = (uint32_t) strtoul(argv[++arg], NULL, 10);
+                    continue;
+                case 'r':
+                    m_nRand = (uint32_t) strtoul(argv[++arg], NULL, 10);
+                    continue;
+                default:
+                    break;
+            }
+        }
+
+        fprintf(stderr, "usage: fcs_tickstress [-t ticks] [-r seed]\n");
+        return 2;
+    }
+
+    if((m_nTickLim == 0) || (m_nTickLim > 0x7FFFFFFFUL))
+    {
+        fprintf(stderr, "fcs_tickstress: 1 to 2^31 - 1 ticks\n");
+        return 2;
+    }
+
+    // Place the counter just below the wrap. The dispatcher discards these ticks.
+    FCS_TASK_SCHDLR_clockTicks(STRESS_TICK_BASE);
+    m_nLastNow = STRESS_TICK_BASE;
+
+    FCS_TASK_SCHDLR_init(m_aTaskLst, 2);
+
+    taskCode.pfnNoArg = &_STRESS_task;
+    hTask = FCS_TASK_SCHDLR_addTask(taskCode, NULL, 1, FCS_TASKPRIORITY_Critical);
+    (void) FCS_TASK_SCHDLR_setReleaseHndl(hTask, FCS_TASKRELEASE_AbsCatchUp);
+
+    taskCode.pfnNoArg = &_STRESS_idle;
+    (void) FCS_TASK_SCHDLR_addTask(taskCode, NULL, 0, FCS_TASKPRIORITY_Idle);
+
+    if(setjmp(m_stopJmp) == 0)
+    {
+        FCS_TASK_SCHDLR_dispatcher();
+    }
+
+    (void) pthread_join(m_isrThread, NULL);
+
+    nNow = FCS_TASK_SCHDLR_now();
+    bPass = (m_nRuns == m_nTickLim) && ((nNow - STRESS_TICK_BASE) == m_nTickLim)
+            && (m_nBackwards == 0) && (m_nAhead == 0);
+
+    printf("ticks added %lu, counted %lu, runs %lu\n", (unsigned long) m_nTickLim,
+            (unsigned long) (nNow - STRESS_TICK_BASE), (unsigned long) m_nRuns);
+    printf("now() went back %lu times, runs ahead of the counter %lu, overruns %lu\n",
+            (unsigned long) m_nBackwards, (unsigned long) m_nAhead,
+            (unsigned long) FCS_TASK_SCHDLR_getTickOverruns());
+    printf("%s\n", bPass ? "PASS" : "FAIL");
+
+    return bPass ? 0 : 1;
+}
@@ -0,0 +1,453 @@
+//***********************************************************************************
+// Module Name:         fcs_tlsim.c
+// Application:         Host tool
+// Platform:            Any host with a C99 compiler
+// Author(s):           Derrick Simeon
+// Notes:
+// Description:
+// Host simulation of the task scheduler's tickless mode (FCS_TASK_SCHDLR_TICKLESS_ENABLE)
+// on the FTM0 time base of Events.c. Runs the real dispatcher over a random task set
+// and checks that every task runs on exactly the tick it is due, however long the
+// timer was left to sleep, and that the credited ticks stay within one count of real
+// time.
+//
+// Build:   S=../../Sources/Franklin_Library/TASK_SCHEDULER
+//          gcc -std=c99 -O2 -I$S -DFCS_TASK_SCHDLR_TICKLESS_ENABLE -o fcs_tlsim fcs_tlsim.c $S/task_schdlr.c
+// Usage:   fcs_tlsim [-n tasks] [-s seconds] [-r seed]
+//
+// Timer model:
+// Time runs in 1/100 counts of FTM0, the bus clock divided by 128, so a 1 ms tick is
+// 8192 units. TU1_SetTickSpan, TU1_CreditCounts, TU1_ArmCompare, TU1_OnChannel0 and
+// TU1_OnCounterRestart are copied from Events.c onto a simulated 16-bit counter that
+// runs freely from time 0. A compare value takes effect with the next count. The
+// dispatcher takes 5 to 20 us after each timer interrupt before it reprograms the span.
+// Credited ticks plus the carry always equal the whole counts elapsed, so the clock
+// error is below one count unless counts are lost.
+//
+// Task set:
+// n tasks (default 16) with random intervals of 1 to 5000 ticks and random Low to
+// Critical priorities. Each run takes a random part of a tick of CPU time, together
+// less than a tick so no pass is late. Task 0 picks a new random interval each time it
+// runs, so the span is also recomputed partway through counted spans. The first run of
+// a task is due one interval after it was added, each later run one interval after the
+// previous.
+//
+// Exit status: 0 if every run was on its due tick and the clock error stayed within one
+// count, 1 if a run was missed, early or late or the clock error exceeded a count, 2 on
+// invalid input.
+// Copyright (c) 2016, Franklin Control Systems, all rights reserved
+//***********************************************************************************
+
+//**************
+// Includes
+//**************
+
+// Standard C libraries
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <setjmp.h>
+
+// Project-specific modules
+#include "task_schdlr.h"
+
+//**************
+// Defines
+//**************
+
+#ifndef FCS_TASK_SCHDLR_TICKLESS_ENABLE
+#error "fcs_tlsim simulates FCS_TASK_SCHDLR_TICKLESS_ENABLE; build with it defined"
+#endif
+
+#define SIM_MAX_TASKS       32          // Tasks in the set
+#define SIM_MAX_INTVL       5000        // Longest random interval in ticks
+
+// FTM0 as set up by TU1_TicklessInit, in 1/100 count units
+#define SIM_TICK_UNITS      8192U       // Units per tick
+#define SIM_CNT_UNITS       100U        // Units per count
+#define SIM_CNT_MASK        0xFFFFU     // Counter range
+#define SIM_MAX_TICKS       799U        // Longest span within one counter wrap
+#define SIM_LEAD_COUNTS     2U          // Compare lead over the counter
+#define SIM_WRAP_UNITS      ((uint64_t) (SIM_CNT_MASK + 1U) * SIM_CNT_UNITS)
+
+// Largest tick clock error that passes, one count
+#define SIM_MAX_CLK_ERR     ((int64_t) SIM_CNT_UNITS)
+
+// Time from a timer interrupt until the dispatcher reprograms the span: interrupt entry,
+// the tick pass and the way to the idle branch. 5 to 20 us, i.e. 0.4 to 1.6 counts.
+#define SIM_WAKE_MIN_UNITS  41U
+#define SIM_WAKE_RNG_UNITS  123U
+
+#define SIM_UNITS_TO_US(u)  ((double) (u) * 1000.0 / SIM_TICK_UNITS)
+
+//**************
+// Local Typedefs
+//**************
+
+// Simulated task
+typedef struct _SIM_Task_t {
+    FCS_TaskHandle_t    hTask;          // Scheduler handle
+    uint32_t            nIntvlTcks;     // Interval in ticks
+    uint32_t            nDueTck;        // Tick the next run is due
+    uint32_t            nExecUnits;     // CPU time per run
+    uint32_t            nRuns;          // Runs so far
+} SIM_Task_t;
+
+//**************
+// Local Variables
+//**************
+
+static FCS_Task_t m_aTaskLst[SIM_MAX_TASKS + 1];
+static SIM_Task_t m_aSimTasks[SIM_MAX_TASKS];
+static uint32_t m_nSimTasks;
+static jmp_buf m_stopJmp;                               // Leaves the dispatcher
+
+static uint64_t m_nNow = 0;                             // Real time in units
+static uint64_t m_nEnd;                                 // Real time the simulation ends
+static uint64_t m_nMatchAt = 0;                         // Real time the compare next matches
+static uint32_t m_nCarry = 0;                           // Units counted past the last credited tick
+static uint32_t m_nCnt = 0;                             // Counter value at the last credit
+static uint32_t m_nSpan = 1;                            // Ticks the compare is armed for
+static uint32_t m_nCredited = 0;                        // Ticks credited to the scheduler
+
+static uint32_t m_nWakes = 0;                           // Timer interrupts
+static uint32_t m_nSpans = 0;                           // Spans programmed
+static uint32_t m_nFaults = 0;                          // Runs not on their due tick
+static int64_t m_nClkErrMin = 0;                        // Credited tick time less real time
+static int64_t m_nClkErrMax = 0;
+static uint64_t m_nCreditAt = 0;                        // Real time ticks were last credited
+static uint64_t m_nRunLagMax = 0;                       // Run start after its tick was credited
+
+static uint32_t m_nRand;                                // Random number state
+
+//**************
+// Local Functions
+//**************
+
+static uint32_t _SIM_rand(uint32_t nRange);
+static uint32_t _SIM_counter(void);
+static uint32_t _SIM_creditCounts(void);
+static void _SIM_armCompare(void);
+static void _SIM_setTickSpan(uint32_t nTicks);
+static uint64_t _SIM_nextIrq(void);
+static void _SIM_advance(uint64_t nUnits);
+static void _SIM_task(void *pArg);
+static void _SIM_idle(void);
+
+//***************************************************************************
+// Function Name:   _SIM_rand
+// Returns:         Random number below nRange.
+// Param1:          nRange - Number of values, at least 1.
+// Description:     Linear congruential generator, so runs repeat for a seed.
+//***************************************************************************
+static uint32_t _SIM_rand(uint32_t nRange)
+{
+    m_nRand = (m_nRand * 1103515245UL) + 12345UL;
+
+    return (m_nRand >> 8) % nRange;
+}
+
+//***************************************************************************
+// Function Name:   _SIM_counter
+// Returns:         Counter register.
+// Param1:          void
+// Description:     FTM_PDD_ReadCounterReg on the simulated counter.
+//***************************************************************************
+static uint32_t _SIM_counter(void)
+{
+    return (uint32_t) (m_nNow / SIM_CNT_UNITS) & SIM_CNT_MASK;
+}
+
+//***************************************************************************
+// Function Name:   _SIM_creditCounts
+// Returns:         Number of ticks credited.
+// Param1:          void
+// Description:     TU1_CreditCounts of Events.c. Also records the error of the
+// credited ticks against real time.
+//***************************************************************************
+static uint32_t _SIM_creditCounts(void)
+{
+    uint32_t nCnt = _SIM_counter();
+    uint32_t nUnits = m_nCarry + (((nCnt - m_nCnt) & SIM_CNT_MASK) * SIM_CNT_UNITS);
+    uint32_t nTicks = nUnits / SIM_TICK_UNITS;
+    int64_t nErr;
+
+    m_nCnt = nCnt;
+    m_nCarry = nUnits % SIM_TICK_UNITS;
+
+    if(nTicks > 0)
+    {
+        m_nCredited += nTicks;
+        m_nCreditAt = m_nNow;
+        FCS_TASK_SCHDLR_clockTicks(nTicks);
+    }
+
+    // Positive when real time is ahead of the credited ticks and carry.
+    nErr = (int64_t) (m_nNow - m_nCarry) - ((int64_t) m_nCredited * SIM_TICK_UNITS);
+    m_nClkErrMin = (nErr < m_nClkErrMin) ? nErr : m_nClkErrMin;
+    m_nClkErrMax = (nErr > m_nClkErrMax) ? nErr : m_nClkErrMax;
+
+    return nTicks;
+}
+
+//***************************************************************************
+// Function Name:   _SIM_armCompare
+// Returns:         void
+// Param1:          void
+// Description:     TU1_ArmCompare of Events.c. Also works out when the compare will
+// match: on the first count after now that takes the counter to the compare value.
+//***************************************************************************
+static void _SIM_armCompare(void)
+{
+    uint32_t nCounts = ((m_nSpan * SIM_TICK_UNITS) - m_nCarry + SIM_CNT_UNITS - 1U) / SIM_CNT_UNITS;
+    uint32_t nLead = ((_SIM_counter() - m_nCnt) & SIM_CNT_MASK) + SIM_LEAD_COUNTS;
+    uint32_t nCnv;
+    uint64_t nAbsCnt = (m_nNow / SIM_CNT_UNITS) + 1U;
+
+    if(nCounts < nLead)
+    {
+        nCounts = nLead;
+    }
+
+    nCnv = (m_nCnt + nCounts) & SIM_CNT_MASK;
+    m_nMatchAt = (nAbsCnt + ((nCnv - (uint32_t) nAbsCnt) & SIM_CNT_MASK)) * SIM_CNT_UNITS;
+}
+
+//***************************************************************************
+// Function Name:   _SIM_setTickSpan
+// Returns:         void
+// Param1:          nTicks - Ticks until the next deadline, counted from the last
+//                  tick credited.
+// Description:     TU1_SetTickSpan of Events.c, registered as the tickless callback.
+//***************************************************************************
+static void _SIM_setTickSpan(uint32_t nTicks)
+{
+    uint32_t nCredited = _SIM_creditCounts();
+
+    nTicks = (nTicks > nCredited) ? (nTicks - nCredited) : 1U;
+
+    if(nTicks > SIM_MAX_TICKS)
+    {
+        nTicks = SIM_MAX_TICKS;
+    }
+
+    m_nSpan = nTicks;
+    _SIM_armCompare();
+    m_nSpans++;
+}
+
+//***************************************************************************
+// Function Name:   _SIM_nextIrq
+// Returns:         Real time of the next timer interrupt.
+// Param1:          void
+// Description:     Earlier of the compare match and the next counter wrap.
+//***************************************************************************
+static uint64_t _SIM_nextIrq(void)
+{
+    uint64_t nWrap = ((m_nNow / SIM_WRAP_UNITS) + 1U) * SIM_WRAP_UNITS;
+
+    return (m_nMatchAt < nWrap) ? m_nMatchAt : nWrap;
+}
+
+//***************************************************************************
+// Function Name:   _SIM_advance
+// Returns:         void
+// Param1:          nUnits - Real time to let pass.
+// Description:     Runs the counter, taking the timer interrupts that fall in the
+// time, and leaves the dispatcher at the end of the simulation.
+//***************************************************************************
+static void _SIM_advance(uint64_t nUnits)
+{
+    uint64_t nStop = ((m_nEnd - m_nNow) > nUnits) ? (m_nNow + nUnits) : m_nEnd;
+    uint64_t nIrq;
+
+    while(true)
+    {
+        nIrq = _SIM_nextIrq();
+
+        if(nIrq > nStop)
+        {
+            break;
+        }
+
+        m_nNow = nIrq;
+        m_nWakes++;
+        (void) _SIM_creditCounts();
+
+        if(nIrq == m_nMatchAt)
+        {
+            // TU1_OnChannel0 re-arms the same span, TU1_OnCounterRestart only credits.
+            _SIM_armCompare();
+        }
+    }
+
+    m_nNow = nStop;
+
+    if(m_nNow >= m_nEnd)
+    {
+        longjmp(m_stopJmp, 1);
+    }
+}
+
+//***************************************************************************
+// Function Name:   _SIM_task
+// Returns:         void
+// Param1:          *pArg - Simulated task.
+// Description:     Checks that the run is on its due tick, then uses its CPU time.
+//***************************************************************************
+static void _SIM_task(void *pArg)
+{
+    SIM_Task_t *pTask = (SIM_Task_t *) pArg;
+    uint32_t nTick = FCS_TASK_SCHDLR_now();
+
+    if(nTick != pTask->nDueTck)
+    {
+        if(m_nFaults < 10)
+        {
+            printf("task %u run %u at tick %lu, due at %lu\n", (unsigned) (pTask - m_aSimTasks),
+                    (unsigned) pTask->nRuns, (unsigned long) nTick, (unsigned long) pTask->nDueTck);
+        }
+
+        m_nFaults++;
+    }
+    else if((m_nNow - m_nCreditAt) > m_nRunLagMax)
+    {
+        m_nRunLagMax = m_nNow - m_nCreditAt;
+    }
+
+    pTask->nRuns++;
+
+    if(pTask == &m_aSimTasks[0])
+    {
+        // New interval, counted from this run.
+        pTask->nIntvlTcks = 1 + _SIM_rand(SIM_MAX_INTVL);
+        (void) FCS_TASK_SCHDLR_updateTaskHndl(pTask->hTask, pTask->nIntvlTcks,
+                (FCS_TaskPriority_e) (FCS_TASKPRIORITY_Low + _SIM_rand(4)));
+    }
+
+    pTask->nDueTck = nTick + pTask->nIntvlTcks;
+
+    _SIM_advance(pTask->nExecUnits);
+}
+
+//***************************************************************************
+// Function Name:   _SIM_idle
+// Returns:         void
+// Param1:          void
+// Description:     Idle task. Sleeps until the next timer interrupt and returns to the
+// dispatcher as late as the interrupt and the dispatcher loop would take.
+//***************************************************************************
+static void _SIM_idle(void)
+{
+    _SIM_advance(_SIM_nextIrq() - m_nNow);
+    _SIM_advance(SIM_WAKE_MIN_UNITS + _SIM_rand(SIM_WAKE_RNG_UNITS));
+}
+
+//***************************************************************************
+// Function Name:   main
+// Returns:         0 if every run was on its due tick and the clock error within a
+//                  count, 1 otherwise, 2 on invalid input.
+// Param1:          argc - Number of arguments.
+// Param2:          **argv - Arguments.
+// Description:     Runs the simulation and prints its statistics.
+//***************************************************************************
+int main(int argc, char **argv)
+{
+    FCS_TaskCode_t taskCode;
+    volatile uint32_t nSecs = 3600;
+    bool bClkOk;
+    uint32_t nRuns;
+    uint32_t idx;
+    int arg;
+
+    m_nSimTasks = 16;
+    m_nRand = 1;
+
+    for(arg = 1; arg < argc; arg++)
+    {
+        if((argv[arg][0] == '-') && (argv[arg][1] != '\0') && (argv[arg][2] == '\0') && ((arg + 1) < argc))
+        {
+            switch(argv[arg][1])
+            {
+                case 'n':
+                    m_nSimTasks = (uint32_t) strtoul(argv[++arg], NULL, 10);
+                    continue;
+                case 's':
+                    nSecs = (uint32_t) strtoul(argv[++arg], NULL, 10);
+                    continue;
+                case 'r':
+                    m_nRand = (uint32_t) strtoul(argv[++arg], NULL, 10);
+                    continue;
+                default:
+                    break;
+            }
+        }
+
+        fprintf(stderr, "usage: fcs_tlsim [-n tasks] [-s seconds] [-r seed]\n");
+        return 2;
+    }
+
+    if((m_nSimTasks == 0) || (m_nSimTasks > SIM_MAX_TASKS) || (nSecs == 0) || (nSecs > 86400))
+    {
+        fprintf(stderr, "fcs_tlsim: 1 to %d tasks and 1 to 86400 seconds\n", SIM_MAX_TASKS);
+        return 2;
+    }
+
+    m_nEnd = (uint64_t) nSecs * 1000U * SIM_TICK_UNITS;
+
+    FCS_TASK_SCHDLR_init(m_aTaskLst, (uint8_t) (m_nSimTasks + 1));
+
+    for(idx = 0; idx < m_nSimTasks; idx++)
+    {
+        m_aSimTasks[idx].nIntvlTcks = 1 + _SIM_rand(SIM_MAX_INTVL);
+        m_aSimTasks[idx].nDueTck = m_aSimTasks[idx].nIntvlTcks;
+        m_aSimTasks[idx].nExecUnits = _SIM_rand((SIM_TICK_UNITS * 9U) / (10U * m_nSimTasks));
+        m_aSimTasks[idx].nRuns = 0;
+
+        taskCode.pfnHasArg = &_SIM_task;
+        m_aSimTasks[idx].hTask = FCS_TASK_SCHDLR_addTask(taskCode, &m_aSimTasks[idx],
+                m_aSimTasks[idx].nIntvlTcks, (FCS_TaskPriority_e) (FCS_TASKPRIORITY_Low + _SIM_rand(4)));
+    }
+
+    taskCode.pfnNoArg = &_SIM_idle;
+    (void) FCS_TASK_SCHDLR_addTask(taskCode, NULL, 0, FCS_TASKPRIORITY_Idle);
+
+    // TU1_TicklessInit.
+    _SIM_setTickSpan(1U);
+    FCS_TASK_SCHDLR_registerTicklessCb(&_SIM_setTickSpan);
+
+    if(setjmp(m_stopJmp) == 0)
+    {
+        FCS_TASK_SCHDLR_dispatcher();
+    }
+
+    nRuns = 0;
+
+    for(idx = 0; idx < m_nSimTasks; idx++)
+    {
+        nRuns += m_aSimTasks[idx].nRuns;
+
+        if((m_aSimTasks[idx].nDueTck + 1U) < m_nCredited)
+        {
+            // Never ran again after its last due tick.
+            printf("task %u missed its run due at tick %lu\n", (unsigned) idx,
+                    (unsigned long) m_aSimTasks[idx].nDueTck);
+            m_nFaults++;
+        }
+    }
+
+    printf("%lu s, %u tasks, %lu ticks, %lu runs\n", (unsigned long) nSecs, (unsigned) m_nSimTasks,
+            (unsigned long) m_nCredited, (unsigned long) nRuns);
+    printf("timer interrupts %lu (%.2f%% of ticks), spans programmed %lu\n", (unsigned long) m_nWakes,
+            (100.0 * m_nWakes) / m_nCredited, (unsigned long) m_nSpans);
+    printf("tick clock error %+.1f to %+.1f us, latest run %.1f us after its tick was credited\n",
+            SIM_UNITS_TO_US(m_nClkErrMin), SIM_UNITS_TO_US(m_nClkErrMax), SIM_UNITS_TO_US(m_nRunLagMax));
+
+    bClkOk = (m_nClkErrMin >= -SIM_MAX_CLK_ERR) && (m_nClkErrMax <= SIM_MAX_CLK_ERR);
+    printf("%s: %lu runs off their due tick, tick clock error %s %.1f us\n",
+            ((m_nFaults == 0) && bClkOk) ? "PASS" : "FAIL", (unsigned long) m_nFaults,
+            bClkOk ? "within" : "beyond", SIM_UNITS_TO_US(SIM_MAX_CLK_ERR));
+
+    return ((m_nFaults == 0) && bClkOk) ? 0 : 1;
+}